@@ -18,18 +18,37 @@
  **/
 
 #include "ndn-app.hpp"
+#include "ndn-consumer-multiplexer.hpp"
 #include "ns3/log.h"
 #include "ns3/assert.h"
 #include "ns3/packet.h"
+#include "ns3/node.h"
 
 #include "model/ndn-l3-protocol.hpp"
 #include "model/ndn-app-face.hpp"
 
+#include <list>
+#include <map>
+
 NS_LOG_COMPONENT_DEFINE("ndn.App");
 
 namespace ns3 {
 namespace ndn {
 
+namespace {
+
+struct AppHookEntry {
+  uint64_t handle;
+  uint32_t firstAppId; ///< @brief applications with lower id have been visited already
+  App::AppHook hook;
+};
+
+std::map<uint32_t /* node id */, std::list<AppHookEntry>> g_appHooks;
+std::map<uint64_t /* handle */, uint32_t /* node id */> g_appHookNodes;
+uint64_t g_lastAppHook = 0;
+
+} // namespace
+
 NS_OBJECT_ENSURE_REGISTERED(App);
 
 TypeId
@@ -81,6 +100,15 @@ App::DoInitialize()
     }
   }
 
+  // applications installed after the hook was added
+  auto hooks = g_appHooks.find(GetNode()->GetId());
+  if (hooks != g_appHooks.end()) {
+    for (const auto& entry : hooks->second) {
+      if (m_appId >= entry.firstAppId)
+        entry.hook(this);
+    }
+  }
+
   Application::DoInitialize();
 }
 
@@ -92,15 +120,65 @@ App::DoDispose(void)
   // Unfortunately, this causes SEGFAULT
   // The best reason I see is that apps are freed after ndn stack is removed
   // StopApplication ();
+  m_multiplexer = 0;
   Application::DoDispose();
 }
 
+uint64_t
+App::AddAppHook(Ptr<Node> node, const AppHook& hook)
+{
+  uint32_t nApps = node->GetNApplications();
+  for (uint32_t id = 0; id < nApps; ++id) {
+    Ptr<App> app = DynamicCast<App>(node->GetApplication(id));
+    if (app != 0)
+      hook(app);
+  }
+
+  uint64_t handle = ++g_lastAppHook;
+  g_appHooks[node->GetId()].push_back(AppHookEntry{handle, nApps, hook});
+  g_appHookNodes[handle] = node->GetId();
+  return handle;
+}
+
+void
+App::RemoveAppHook(uint64_t handle)
+{
+  auto node = g_appHookNodes.find(handle);
+  if (node == g_appHookNodes.end())
+    return;
+
+  auto hooks = g_appHooks.find(node->second);
+  if (hooks != g_appHooks.end()) {
+    hooks->second.remove_if([handle](const AppHookEntry& entry) { return entry.handle == handle; });
+    if (hooks->second.empty())
+      g_appHooks.erase(hooks);
+  }
+
+  g_appHookNodes.erase(node);
+}
+
 uint32_t
 App::GetId() const
 {
   return m_appId;
 }
 
+void
+App::SetMultiplexer(Ptr<ConsumerMultiplexer> multiplexer)
+{
+  NS_ASSERT_MSG(m_active != true, "Multiplexer has to be set before the application starts");
+  m_multiplexer = multiplexer;
+}
+
+void
+App::ExpressInterest(const Interest& interest)
+{
+  if (m_multiplexer != 0)
+    m_multiplexer->ExpressInterest(this, interest);
+  else
+    m_face->onReceiveInterest(interest);
+}
+
 void
 App::OnInterest(shared_ptr<const Interest> interest)
 {
@@ -127,6 +205,13 @@ App::StartApplication() // Called at time specified by Start
   NS_ASSERT_MSG(GetNode()->GetObject<L3Protocol>() != 0,
                 "Ndn stack should be installed on the node " << GetNode());
 
+  // the multiplexer carries the packets of the application over its own face
+  if (m_multiplexer != 0) {
+    m_face = m_multiplexer->GetFace();
+    NS_ASSERT_MSG(m_face != nullptr, "Multiplexer has to be started before the application");
+    return;
+  }
+
   // step 1. Create a face
   m_face = std::make_shared<AppFace>(this);
 
@@ -144,6 +229,12 @@ App::StopApplication() // Called at time specified by Stop
 
   m_active = false;
 
+  if (m_multiplexer != 0) {
+    // the face is shared with other applications
+    m_multiplexer->RemoveClient(this);
+    return;
+  }
+
   m_face->close();
 }
 
@@ -28,12 +28,16 @@
 #include "ns3/callback.h"
 #include "ns3/traced-callback.h"
 
+#include <functional>
+
 namespace ns3 {
 
 class Packet;
 
 namespace ndn {
 
+class ConsumerMultiplexer;
+
 /**
  * \ingroup ndn
  * \defgroup ndn-apps NDN applications
@@ -80,6 +84,39 @@ public:
   virtual void
   OnData(shared_ptr<const Data> data);
 
+  /**
+   * @brief Let the multiplexer carry Interests and Data of this application instead of adding
+   * an own face to the Ndn stack (has to be set before the application starts)
+   */
+  void
+  SetMultiplexer(Ptr<ConsumerMultiplexer> multiplexer);
+
+  /**
+   * @brief Send Interest towards the Ndn stack, through the multiplexer if one is set
+   */
+  void
+  ExpressInterest(const Interest& interest);
+
+  typedef std::function<void(Ptr<App>)> AppHook;
+
+  /**
+   * @brief Call @p hook for every NDN application on @p node
+   *
+   * Applications that are already installed on the node are visited immediately, applications
+   * added later are visited when they are initialized.  Can be used to connect to trace sources
+   * of applications without resolving Config paths.
+   *
+   * @returns handle to be used with RemoveAppHook
+   */
+  static uint64_t
+  AddAppHook(Ptr<Node> node, const AppHook& hook);
+
+  /**
+   * @brief Stop visiting applications added to the node (it is safe to call it with 0 handle)
+   */
+  static void
+  RemoveAppHook(uint64_t handle);
+
 public:
   typedef void (*InterestTraceCallback)(shared_ptr<const Interest>, Ptr<App>, shared_ptr<Face>);
   typedef void (*DataTraceCallback)(shared_ptr<const Data>, Ptr<App>, shared_ptr<Face>);
@@ -102,6 +139,7 @@ protected:
   bool m_active; ///< @brief Flag to indicate that application is active (set by StartApplication and StopApplication)
   shared_ptr<AppFace> m_face; ///< @brief automatically created application face through which application communicates
   uint32_t m_appId;
+  Ptr<ConsumerMultiplexer> m_multiplexer; ///< @brief shared face, if set
 
   TracedCallback<shared_ptr<const Interest>, Ptr<App>, shared_ptr<Face>>
     m_receivedInterests; ///< @brief App-level trace of received Interests
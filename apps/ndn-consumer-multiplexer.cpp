@@ -0,0 +1,256 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "ndn-consumer-multiplexer.hpp"
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/simulator.h"
+
+#include "model/ndn-app-face.hpp"
+
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE("ndn.ConsumerMultiplexer");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(ConsumerMultiplexer);
+
+TypeId
+ConsumerMultiplexer::GetTypeId(void)
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::ConsumerMultiplexer")
+      .SetGroupName("Ndn")
+      .SetParent<App>()
+      .AddConstructor<ConsumerMultiplexer>()
+
+      .AddTraceSource("AggregatedInterests",
+                      "Interests of attached consumers that were not sent, because the same name "
+                      "was already pending",
+                      MakeTraceSourceAccessor(&ConsumerMultiplexer::m_aggregatedInterests));
+
+  return tid;
+}
+
+ConsumerMultiplexer::ConsumerMultiplexer()
+{
+  NS_LOG_FUNCTION_NOARGS();
+}
+
+void
+ConsumerMultiplexer::Multiplex(const ApplicationContainer& apps)
+{
+  for (ApplicationContainer::Iterator i = apps.Begin(); i != apps.End(); ++i) {
+    Ptr<App> app = DynamicCast<App>(*i);
+    NS_ASSERT_MSG(app != 0, "Only ndn::App applications can be multiplexed");
+
+    Multiplex(app);
+  }
+}
+
+void
+ConsumerMultiplexer::Multiplex(Ptr<App> app)
+{
+  NS_LOG_FUNCTION(this << app);
+  NS_ASSERT_MSG(app->GetNode() == GetNode(), "Multiplexed applications have to be on the same node");
+
+  app->SetMultiplexer(this);
+}
+
+shared_ptr<AppFace>
+ConsumerMultiplexer::GetFace() const
+{
+  return m_active ? m_face : nullptr;
+}
+
+void
+ConsumerMultiplexer::StartApplication()
+{
+  NS_LOG_FUNCTION_NOARGS();
+  App::StartApplication();
+
+  m_nextExpiryCheck = Simulator::Now();
+}
+
+void
+ConsumerMultiplexer::StopApplication()
+{
+  NS_LOG_FUNCTION_NOARGS();
+
+  Simulator::Cancel(m_flushEvent);
+  m_outgoing.clear();
+  m_pending.clear();
+
+  App::StopApplication();
+}
+
+void
+ConsumerMultiplexer::ExpressInterest(Ptr<App> app, const Interest& interest)
+{
+  if (!m_active)
+    return;
+
+  NS_LOG_FUNCTION(this << app << interest.getName());
+
+  if (Simulator::Now() >= m_nextExpiryCheck)
+    RemoveExpired();
+
+  time::milliseconds lifetime = interest.getInterestLifetime();
+  if (lifetime < time::milliseconds::zero())
+    lifetime = ::ndn::DEFAULT_INTEREST_LIFETIME;
+
+  // Interests with different selectors (e.g., MustBeFresh) may be satisfied by different Data
+  std::vector<PendingEntry>& entries = m_pending[interest.getName()];
+  auto entry = std::find_if(entries.begin(), entries.end(), [&interest](const PendingEntry& e) {
+    return e.interest->getSelectors() == interest.getSelectors();
+  });
+  if (entry == entries.end()) {
+    entries.push_back(PendingEntry());
+    entry = entries.end() - 1;
+  }
+  else if (entry->expiry < Simulator::Now()) {
+    entry->clients.clear();
+  }
+
+  bool isPending = !entry->clients.empty();
+  bool isRetransmission =
+    std::find(entry->clients.begin(), entry->clients.end(), app) != entry->clients.end();
+
+  entry->expiry = std::max(entry->expiry, Simulator::Now() + MilliSeconds(lifetime.count()));
+
+  if (isPending && !isRetransmission) {
+    // the Data will be dispatched to this client as well
+    NS_LOG_DEBUG("Aggregating " << interest.getName());
+    entry->clients.push_back(app);
+    m_aggregatedInterests(interest.shared_from_this(), app);
+    return;
+  }
+
+  if (!isRetransmission)
+    entry->clients.push_back(app);
+
+  entry->interest = interest.shared_from_this();
+  m_outgoing.push_back(entry->interest);
+  if (!m_flushEvent.IsRunning())
+    m_flushEvent = Simulator::ScheduleNow(&ConsumerMultiplexer::FlushInterests, this);
+}
+
+void
+ConsumerMultiplexer::FlushInterests()
+{
+  NS_LOG_FUNCTION(this << m_outgoing.size());
+
+  std::vector<shared_ptr<const Interest>> outgoing;
+  outgoing.swap(m_outgoing);
+
+  for (const auto& interest : outgoing) {
+    m_face->onReceiveInterest(*interest);
+  }
+}
+
+void
+ConsumerMultiplexer::OnData(shared_ptr<const Data> data)
+{
+  if (!m_active)
+    return;
+
+  NS_LOG_FUNCTION(this << data->getName());
+
+  // collect clients of all pending Interests that the Data satisfies
+  std::vector<Ptr<App>> clients;
+  const Name& dataName = data->getName();
+  for (int prefixLength = dataName.size(); prefixLength >= 0; prefixLength--) {
+    auto entries = m_pending.find(dataName.getPrefix(prefixLength));
+    if (entries == m_pending.end())
+      continue;
+
+    auto& pending = entries->second;
+    for (auto entry = pending.begin(); entry != pending.end();) {
+      if (!entry->interest->matchesData(*data)) {
+        ++entry;
+        continue;
+      }
+
+      for (const auto& app : entry->clients) {
+        if (std::find(clients.begin(), clients.end(), app) == clients.end())
+          clients.push_back(app);
+      }
+      entry = pending.erase(entry);
+    }
+
+    if (pending.empty())
+      m_pending.erase(entries);
+  }
+
+  // no extra event per client, we are already decoupled from the face
+  for (const auto& app : clients) {
+    app->OnData(data);
+  }
+}
+
+void
+ConsumerMultiplexer::RemoveClient(Ptr<App> app)
+{
+  NS_LOG_FUNCTION(this << app);
+
+  for (auto entries = m_pending.begin(); entries != m_pending.end();) {
+    auto& pending = entries->second;
+    for (auto entry = pending.begin(); entry != pending.end();) {
+      auto& clients = entry->clients;
+      clients.erase(std::remove(clients.begin(), clients.end(), app), clients.end());
+
+      if (clients.empty())
+        entry = pending.erase(entry);
+      else
+        ++entry;
+    }
+
+    if (pending.empty())
+      entries = m_pending.erase(entries);
+    else
+      ++entries;
+  }
+}
+
+void
+ConsumerMultiplexer::RemoveExpired()
+{
+  for (auto entries = m_pending.begin(); entries != m_pending.end();) {
+    auto& pending = entries->second;
+    pending.erase(std::remove_if(pending.begin(), pending.end(),
+                                 [](const PendingEntry& entry) {
+                                   return entry.expiry < Simulator::Now();
+                                 }),
+                  pending.end());
+
+    if (pending.empty())
+      entries = m_pending.erase(entries);
+    else
+      ++entries;
+  }
+
+  m_nextExpiryCheck = Simulator::Now() + Seconds(1);
+}
+
+} // namespace ndn
+} // namespace ns3
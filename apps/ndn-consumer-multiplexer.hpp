@@ -0,0 +1,124 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef NDN_CONSUMER_MULTIPLEXER_H
+#define NDN_CONSUMER_MULTIPLEXER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ndn-app.hpp"
+
+#include "ns3/application-container.h"
+
+#include <map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Node-local multiplexer that carries Interests and Data of many colocated consumers
+ *        over a single application face
+ *
+ * Consumers attached with Multiplex() do not create a face, they use the face of the
+ * multiplexer. Their Interests are collected and handed to the stack in one batch per
+ * simulation event. Interests that are already pending on the shared face (same name and
+ * selectors, including MustBeFresh) are not sent again, and each returning Data is dispatched
+ * directly to all consumers waiting for a pending Interest it satisfies, as the PIT would do.
+ * App-level traces of the consumers are unchanged.
+ *
+ * The multiplexer has to be installed (and started) before the consumers it carries.
+ */
+class ConsumerMultiplexer : public App {
+public:
+  static TypeId
+  GetTypeId();
+
+  ConsumerMultiplexer();
+
+  /**
+   * @brief Attach consumers (have to be on the same node and not started yet)
+   */
+  void
+  Multiplex(const ApplicationContainer& apps);
+
+  void
+  Multiplex(Ptr<App> app);
+
+  /**
+   * @brief Face shared by the attached consumers (nullptr, unless the multiplexer is running)
+   */
+  shared_ptr<AppFace>
+  GetFace() const;
+
+  /**
+   * @brief Called by App::ExpressInterest of an attached consumer
+   */
+  void
+  ExpressInterest(Ptr<App> app, const Interest& interest);
+
+  /**
+   * @brief Called by App::StopApplication of an attached consumer
+   */
+  void
+  RemoveClient(Ptr<App> app);
+
+public: // from App
+  virtual void
+  OnData(shared_ptr<const Data> data);
+
+protected:
+  virtual void
+  StartApplication();
+
+  virtual void
+  StopApplication();
+
+private:
+  void
+  FlushInterests();
+
+  void
+  RemoveExpired();
+
+private:
+  struct PendingEntry {
+    shared_ptr<const Interest> interest; ///< @brief the Interest sent on the shared face
+    std::vector<Ptr<App>> clients;
+    Time expiry;
+  };
+
+  /**
+   * @brief Interests pending on the shared face, one entry per distinct set of selectors
+   */
+  std::map<Name, std::vector<PendingEntry>> m_pending;
+  std::vector<shared_ptr<const Interest>> m_outgoing; ///< @brief Interests of the current event
+  EventId m_flushEvent;
+  Time m_nextExpiryCheck;
+
+  TracedCallback<shared_ptr<const Interest>, Ptr<App>> m_aggregatedInterests;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CONSUMER_MULTIPLEXER_H
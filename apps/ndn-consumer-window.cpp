@@ -26,6 +26,9 @@
 #include "ns3/string.h"
 #include "ns3/uinteger.h"
 #include "ns3/double.h"
+#include "ns3/object-factory.h"
+
+#include <algorithm>
 
 NS_LOG_COMPONENT_DEFINE("ndn.ConsumerWindow");
 
@@ -71,13 +74,25 @@ ConsumerWindow::GetTypeId(void)
                     MakeBooleanAccessor(&ConsumerWindow::m_setInitialWindowOnTimeout),
                     MakeBooleanChecker())
 
+      .AddAttribute("CongestionControl",
+                    "TypeId of the congestion controller (e.g., ns3::ndn::CongestionControlAimd, "
+                    "ns3::ndn::CongestionControlCubic, ns3::ndn::CongestionControlRttGradient), "
+                    "empty to increase the window on Data and reset it on timeout",
+                    StringValue(""),
+                    MakeStringAccessor(&ConsumerWindow::SetCongestionControlType,
+                                       &ConsumerWindow::GetCongestionControlType),
+                    MakeStringChecker())
+
       .AddTraceSource("WindowTrace",
                       "Window that controls how many outstanding interests are allowed",
                       MakeTraceSourceAccessor(&ConsumerWindow::m_window),
                       "ns3::ndn::ConsumerWindow::WindowTraceCallback")
       .AddTraceSource("InFlight", "Current number of outstanding interests",
                       MakeTraceSourceAccessor(&ConsumerWindow::m_inFlight),
-                      "ns3::ndn::ConsumerWindow::WindowTraceCallback");
+                      "ns3::ndn::ConsumerWindow::WindowTraceCallback")
+      .AddTraceSource("RttSample", "RTT sample of every Data packet that yields one",
+                      MakeTraceSourceAccessor(&ConsumerWindow::m_rttTrace),
+                      "ns3::ndn::ConsumerWindow::RttTraceCallback");
 
   return tid;
 }
@@ -151,6 +166,25 @@ ConsumerWindow::SetSeqMax(uint32_t seqMax)
   // ignore otherwise
 }
 
+void
+ConsumerWindow::SetCongestionControlType(std::string congestionControlType)
+{
+  m_congestionControlType = congestionControlType;
+  m_congestionControl = 0;
+  if (congestionControlType.empty())
+    return;
+
+  ObjectFactory factory(congestionControlType);
+  m_congestionControl = factory.Create<CongestionControl>();
+  m_congestionControl->Reset();
+}
+
+std::string
+ConsumerWindow::GetCongestionControlType() const
+{
+  return m_congestionControlType;
+}
+
 void
 ConsumerWindow::ScheduleNextPacket()
 {
@@ -186,7 +220,16 @@ ConsumerWindow::OnData(shared_ptr<const Data> contentObject)
 {
   Consumer::OnData(contentObject);
 
-  m_window = m_window + 1;
+  if (!m_lastRtt.IsZero())
+    m_rttTrace(m_lastRtt);
+
+  if (m_congestionControl != 0) {
+    m_congestionControl->OnData(m_lastRtt);
+    m_window = std::max<uint32_t>(1, m_congestionControl->GetWindow());
+  }
+  else {
+    m_window = m_window + 1;
+  }
 
   if (m_inFlight > static_cast<uint32_t>(0))
     m_inFlight--;
@@ -201,7 +244,11 @@ ConsumerWindow::OnTimeout(uint32_t sequenceNumber)
   if (m_inFlight > static_cast<uint32_t>(0))
     m_inFlight--;
 
-  if (m_setInitialWindowOnTimeout) {
+  if (m_congestionControl != 0) {
+    m_congestionControl->OnTimeout();
+    m_window = std::max<uint32_t>(1, m_congestionControl->GetWindow());
+  }
+  else if (m_setInitialWindowOnTimeout) {
     // m_window = std::max<uint32_t> (0, m_window - 1);
     m_window = m_initialWindow;
   }
@@ -24,6 +24,7 @@
 
 #include "ndn-consumer.hpp"
 #include "ns3/traced-value.h"
+#include "ns3/ndnSIM/utils/ndn-congestion-control.hpp"
 
 namespace ns3 {
 namespace ndn {
@@ -58,6 +59,7 @@ public:
 
 public:
   typedef void (*WindowTraceCallback)(uint32_t);
+  typedef void (*RttTraceCallback)(Time);
 
 protected:
   /**
@@ -92,6 +94,12 @@ private:
   void
   SetSeqMax(uint32_t seqMax);
 
+  void
+  SetCongestionControlType(std::string congestionControlType);
+
+  std::string
+  GetCongestionControlType() const;
+
 private:
   uint32_t m_payloadSize; // expected payload size
   double m_maxSize;       // max size to request
@@ -101,6 +109,10 @@ private:
 
   TracedValue<uint32_t> m_window;
   TracedValue<uint32_t> m_inFlight;
+
+  Ptr<CongestionControl> m_congestionControl; // congestion controller (0 = built-in scheme)
+  std::string m_congestionControlType;
+  TracedCallback<Time> m_rttTrace;
 };
 
 } // namespace ndn
@@ -168,14 +168,7 @@ ConsumerZipfMandelbrot::SendPacket()
 
   // std::cout << Simulator::Now ().ToDouble (Time::S) << "s -> " << seq << "\n";
 
-  //
-  shared_ptr<Name> nameWithSequence = make_shared<Name>(m_interestName);
-  nameWithSequence->appendSequenceNumber(seq);
-  //
-
-  shared_ptr<Interest> interest = make_shared<Interest>();
-  interest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
-  interest->setName(*nameWithSequence);
+  shared_ptr<Interest> interest = m_interestBuilder.Build(m_interestName, seq, m_interestLifeTime);
 
   // NS_LOG_INFO ("Requesting Interest: \n" << *interest);
   NS_LOG_INFO("> Interest for " << seq << ", Total: " << m_seq << ", face: " << m_face->getId());
@@ -193,7 +186,7 @@ ConsumerZipfMandelbrot::SendPacket()
   m_rtt->SentSeq(SequenceNumber32(seq), 1);
 
   m_transmittedInterests(interest, this, m_face);
-  m_face->onReceiveInterest(*interest);
+  ExpressInterest(*interest);
 
   ConsumerZipfMandelbrot::ScheduleNextPacket();
 }
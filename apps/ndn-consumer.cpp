@@ -28,6 +28,7 @@
 #include "ns3/uinteger.h"
 #include "ns3/integer.h"
 #include "ns3/double.h"
+#include "ns3/object-factory.h"
 
 #include "utils/ndn-ns3-packet-tag.hpp"
 #include "model/ndn-app-face.hpp"
@@ -36,6 +37,8 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/ref.hpp>
 
+#include <algorithm>
+
 NS_LOG_COMPONENT_DEFINE("ndn.Consumer");
 
 namespace ns3 {
@@ -64,6 +67,14 @@ Consumer::GetTypeId(void)
                     MakeTimeAccessor(&Consumer::GetRetxTimer, &Consumer::SetRetxTimer),
                     MakeTimeChecker())
 
+      .AddAttribute("RttEstimator",
+                    "TypeId of the RTT estimator (e.g., ns3::ndn::RttMeanDeviation, "
+                    "ns3::ndn::RttMinFilter, ns3::ndn::RttWindowedPercentile)",
+                    StringValue("ns3::ndn::RttMeanDeviation"),
+                    MakeStringAccessor(&Consumer::SetRttEstimatorType,
+                                       &Consumer::GetRttEstimatorType),
+                    MakeStringChecker())
+
       .AddTraceSource("LastRetransmittedInterestDataDelay",
                       "Delay between last retransmitted Interest and received Data",
                       MakeTraceSourceAccessor(&Consumer::m_lastRetransmittedInterestDataDelay),
@@ -78,13 +89,24 @@ Consumer::GetTypeId(void)
 }
 
 Consumer::Consumer()
-  : m_rand(CreateObject<UniformRandomVariable>())
-  , m_seq(0)
+  : m_seq(0)
   , m_seqMax(0) // don't request anything
 {
   NS_LOG_FUNCTION_NOARGS();
+}
 
-  m_rtt = CreateObject<RttMeanDeviation>();
+void
+Consumer::SetRttEstimatorType(std::string rttEstimatorType)
+{
+  ObjectFactory factory(rttEstimatorType);
+  m_rtt = factory.Create<RttEstimator>();
+  m_rttEstimatorType = rttEstimatorType;
+}
+
+std::string
+Consumer::GetRttEstimatorType() const
+{
+  return m_rttEstimatorType;
 }
 
 void
@@ -180,17 +202,7 @@ Consumer::SendPacket()
     seq = m_seq++;
   }
 
-  //
-  shared_ptr<Name> nameWithSequence = make_shared<Name>(m_interestName);
-  nameWithSequence->appendSequenceNumber(seq);
-  //
-
-  // shared_ptr<Interest> interest = make_shared<Interest> ();
-  shared_ptr<Interest> interest = make_shared<Interest>();
-  interest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
-  interest->setName(*nameWithSequence);
-  time::milliseconds interestLifeTime(m_interestLifeTime.GetMilliSeconds());
-  interest->setInterestLifetime(interestLifeTime);
+  shared_ptr<Interest> interest = m_interestBuilder.Build(m_interestName, seq, m_interestLifeTime);
 
   // NS_LOG_INFO ("Requesting Interest: \n" << *interest);
   NS_LOG_INFO("> Interest for " << seq);
@@ -198,7 +210,7 @@ Consumer::SendPacket()
   WillSendOutInterest(seq);
 
   m_transmittedInterests(interest, this, m_face);
-  m_face->onReceiveInterest(*interest);
+  ExpressInterest(*interest);
 
   ScheduleNextPacket();
 }
@@ -223,15 +235,9 @@ Consumer::OnData(shared_ptr<const Data> data)
   uint32_t seq = data->getName().at(-1).toSequenceNumber();
   NS_LOG_INFO("< DATA for " << seq);
 
-  int hopCount = 0;
-  auto ns3PacketTag = data->getTag<Ns3PacketTag>();
-  if (ns3PacketTag != nullptr) { // e.g., packet came from local node's cache
-    FwHopCountTag hopCountTag;
-    if (ns3PacketTag->getPacket()->PeekPacketTag(hopCountTag)) {
-      hopCount = hopCountTag.Get();
-      NS_LOG_DEBUG("Hop count: " << hopCount);
-    }
-  }
+  // no hop count, e.g., packet came from local node's cache
+  int hopCount = std::max(Ns3PacketTag::hopCountOf(*data), 0);
+  NS_LOG_DEBUG("Hop count: " << hopCount);
 
   SeqTimeoutsContainer::iterator entry = m_seqLastDelay.find(seq);
   if (entry != m_seqLastDelay.end()) {
@@ -250,7 +256,7 @@ Consumer::OnData(shared_ptr<const Data> data)
   m_seqTimeouts.erase(seq);
   m_retxSeqs.erase(seq);
 
-  m_rtt->AckSeq(SequenceNumber32(seq));
+  m_lastRtt = m_rtt->AckSeq(SequenceNumber32(seq));
 }
 
 void
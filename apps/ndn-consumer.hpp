@@ -31,6 +31,7 @@
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 #include "ns3/ndnSIM/utils/ndn-rtt-estimator.hpp"
 #include "ns3/ndnSIM/utils/ndn-fw-hop-count-tag.hpp"
+#include "ns3/ndnSIM/utils/ndn-interest-builder.hpp"
 
 #include <set>
 #include <map>
@@ -128,8 +129,21 @@ protected:
   Time
   GetRetxTimer() const;
 
+  /**
+   * \brief Replaces the RTT estimator with a new instance of the given type
+   * \param rttEstimatorType TypeId name of a class derived from RttEstimator
+   */
+  void
+  SetRttEstimatorType(std::string rttEstimatorType);
+
+  /**
+   * \brief Returns TypeId name of the current RTT estimator
+   */
+  std::string
+  GetRttEstimatorType() const;
+
 protected:
-  Ptr<UniformRandomVariable> m_rand; ///< @brief nonce generator
+  InterestBuilder m_interestBuilder; ///< @brief builder of outgoing Interests (and their nonces)
 
   uint32_t m_seq;      ///< @brief currently requested sequence number
   uint32_t m_seqMax;   ///< @brief maximum number of sequence number
@@ -137,7 +151,9 @@ protected:
   Time m_retxTimer;    ///< @brief Currently estimated retransmission timer
   EventId m_retxEvent; ///< @brief Event to check whether or not retransmission should be performed
 
-  Ptr<RttEstimator> m_rtt; ///< @brief RTT estimator
+  Ptr<RttEstimator> m_rtt;        ///< @brief RTT estimator
+  std::string m_rttEstimatorType; ///< @brief TypeId name of the RTT estimator
+  Time m_lastRtt;                 ///< @brief RTT sample of the last Data (zero, if none)
 
   Time m_offTime;          ///< \brief Time interval between packets
   Name m_interestName;     ///< \brief NDN Name of the Interest (use Name)
@@ -22,6 +22,7 @@
 #include "ns3/log.h"
 #include "ns3/string.h"
 #include "ns3/uinteger.h"
+#include "ns3/boolean.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 
@@ -36,12 +37,14 @@
 #include "model/ndn-ns3.hpp"
 #include "model/ndn-l3-protocol.hpp"
 #include "helper/ndn-fib-helper.hpp"
+#include "utils/ndn-file-manifest.hpp"
 
 #include <memory>
 #include <sys/types.h>
 #include <sys/stat.h>
 
 #include <math.h>
+#include <limits>
 #include <fstream>
 
 
@@ -87,7 +90,17 @@ FakeFileServer::GetTypeId(void)
          MakeUintegerChecker<uint32_t>())
       .AddAttribute("KeyLocator",
                     "Name to be used for key locator.  If root, then key locator is not used",
-                    NameValue(), MakeNameAccessor(&FakeFileServer::m_keyLocator), MakeNameChecker());
+                    NameValue(), MakeNameAccessor(&FakeFileServer::m_keyLocator), MakeNameChecker())
+      .AddAttribute("InBandManifest",
+                    "Carry FinalBlockId and the manifest in the MetaInfo of every chunk, so that "
+                    "consumers can start downloading without requesting the manifest first",
+                    BooleanValue(false), MakeBooleanAccessor(&FakeFileServer::m_inBandManifest),
+                    MakeBooleanChecker())
+      .AddAttribute("MaxDataSize",
+                    "Maximum size of Data packets, 0 to use the MTU of the first NetDevice.  "
+                    "Data larger than the MTU requires ns3::ndn::L3Protocol::Fragmentation",
+                    UintegerValue(0), MakeUintegerAccessor(&FakeFileServer::m_maxDataSize),
+                    MakeUintegerChecker<uint16_t>());
   return tid;
 }
 
@@ -138,7 +151,7 @@ FakeFileServer::StartApplication()
 
   infile.close();
 
-  m_MTU = GetFaceMTU(0);
+  m_MTU = m_maxDataSize != 0 ? m_maxDataSize : GetFaceMTU(0);
 
   m_freshnessTime = ::ndn::time::milliseconds(m_freshness.GetMilliSeconds());
 }
@@ -246,13 +259,8 @@ FakeFileServer::ReturnManifestData(shared_ptr<const Interest> interest, std::str
   data->setName(interest->getName());
   data->setFreshnessPeriod(m_freshnessTime);
 
-  // create a local buffer variable, which contains a long and an unsigned
-  uint8_t buffer[sizeof(long) + sizeof(unsigned)];
-  memcpy(buffer, &fileSize, sizeof(long));
-  memcpy(buffer+sizeof(long), &m_maxPayloadSize, sizeof(unsigned));
-
-  // create content with the file size in it
-  data->setContent(reinterpret_cast<const uint8_t*>(buffer), sizeof(long) + sizeof(unsigned));
+  // create content with the file size and the payload size per chunk in it
+  data->setContent(FileManifest::Encode(fileSize, m_maxPayloadSize));
 
   Signature signature;
   SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
@@ -287,6 +295,12 @@ FakeFileServer::ReturnVirtualPayloadData(shared_ptr<const Interest> interest, st
   auto buffer = make_shared< ::ndn::Buffer>(m_maxPayloadSize);
   data->setContent(buffer);
 
+  if (m_inBandManifest)
+  {
+    // lets the consumer start without requesting the manifest
+    FileManifest::SetInBand(*data, GetFileSize(fname), m_maxPayloadSize);
+  }
+
   Signature signature;
   SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
 
@@ -331,6 +345,12 @@ FakeFileServer::EstimateOverhead(std::string& fname)
   auto buffer = make_shared< ::ndn::Buffer>(estimatedMaxPayloadSize);
   data->setContent(buffer);
 
+  if (m_inBandManifest)
+  {
+    // largest possible encoding of the in-band manifest
+    FileManifest::SetInBand(*data, std::numeric_limits<long>::max(), estimatedMaxPayloadSize);
+  }
+
   Signature signature;
   SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
 
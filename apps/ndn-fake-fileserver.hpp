@@ -76,6 +76,7 @@ protected:
   EstimateOverhead(std::string& fname);
 
   uint16_t m_MTU;
+  uint16_t m_maxDataSize; ///< @brief overrides the NetDevice MTU, if not 0
 
 
   ndn::time::milliseconds m_freshnessTime;
@@ -94,6 +95,8 @@ private:
 
   uint32_t m_signature;
   Name m_keyLocator;
+
+  bool m_inBandManifest;
 };
 
 } // namespace ndn
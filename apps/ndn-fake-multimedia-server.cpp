@@ -22,6 +22,7 @@
 #include "ns3/log.h"
 #include "ns3/string.h"
 #include "ns3/uinteger.h"
+#include "ns3/boolean.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 
@@ -36,12 +37,14 @@
 #include "model/ndn-ns3.hpp"
 #include "model/ndn-l3-protocol.hpp"
 #include "helper/ndn-fib-helper.hpp"
+#include "utils/ndn-file-manifest.hpp"
 
 #include <memory>
 #include <sys/types.h>
 #include <sys/stat.h>
 
 #include <math.h>
+#include <limits>
 #include <fstream>
 
 
@@ -99,7 +102,17 @@ FakeMultimediaServer::GetTypeId(void)
          MakeUintegerChecker<uint32_t>())
       .AddAttribute("KeyLocator",
                     "Name to be used for key locator.  If root, then key locator is not used",
-                    NameValue(), MakeNameAccessor(&FakeMultimediaServer::m_keyLocator), MakeNameChecker());
+                    NameValue(), MakeNameAccessor(&FakeMultimediaServer::m_keyLocator), MakeNameChecker())
+      .AddAttribute("InBandManifest",
+                    "Carry FinalBlockId and the manifest in the MetaInfo of every chunk, so that "
+                    "consumers can start downloading without requesting the manifest first",
+                    BooleanValue(false), MakeBooleanAccessor(&FakeMultimediaServer::m_inBandManifest),
+                    MakeBooleanChecker())
+      .AddAttribute("MaxDataSize",
+                    "Maximum size of Data packets, 0 to use the MTU of the first NetDevice.  "
+                    "Data larger than the MTU requires ns3::ndn::L3Protocol::Fragmentation",
+                    UintegerValue(0), MakeUintegerAccessor(&FakeMultimediaServer::m_maxDataSize),
+                    MakeUintegerChecker<uint16_t>());
   return tid;
 }
 
@@ -233,7 +246,7 @@ FakeMultimediaServer::StartApplication()
   // store file size for mpd file name
   m_fileSizes[mpdFileName.str()] = m_mpdFileContent.size();
 
-  m_MTU = GetFaceMTU(0);
+  m_MTU = m_maxDataSize != 0 ? m_maxDataSize : GetFaceMTU(0);
 
   m_freshnessTime = ::ndn::time::milliseconds(m_freshness.GetMilliSeconds());
 }
@@ -364,13 +377,8 @@ FakeMultimediaServer::ReturnManifestData(shared_ptr<const Interest> interest, st
   data->setName(interest->getName());
   data->setFreshnessPeriod(m_freshnessTime);
 
-  // create a local buffer variable, which contains a long and an unsigned
-  uint8_t buffer[sizeof(long) + sizeof(unsigned)];
-  memcpy(buffer, &fileSize, sizeof(long));
-  memcpy(buffer+sizeof(long), &m_maxPayloadSize, sizeof(unsigned));
-
-  // create content with the file size in it
-  data->setContent(reinterpret_cast<const uint8_t*>(buffer), sizeof(long) + sizeof(unsigned));
+  // create content with the file size and the payload size per chunk in it
+  data->setContent(FileManifest::Encode(fileSize, m_maxPayloadSize));
 
   Signature signature;
   SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
@@ -427,6 +435,12 @@ FakeMultimediaServer::ReturnPayloadData(shared_ptr<const Interest> interest, std
 
   data->setContent(buffer);
 
+  if (m_inBandManifest)
+  {
+    // lets the consumer start without requesting the manifest
+    FileManifest::SetInBand(*data, payload_size, m_maxPayloadSize);
+  }
+
   Signature signature;
   SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
 
@@ -460,6 +474,12 @@ FakeMultimediaServer::ReturnVirtualPayloadData(shared_ptr<const Interest> intere
   auto buffer = make_shared< ::ndn::Buffer>(m_maxPayloadSize);
   data->setContent(buffer);
 
+  if (m_inBandManifest)
+  {
+    // lets the consumer start without requesting the manifest
+    FileManifest::SetInBand(*data, GetFileSize(fname), m_maxPayloadSize);
+  }
+
   Signature signature;
   SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
 
@@ -504,6 +524,12 @@ FakeMultimediaServer::EstimateOverhead(std::string& fname)
   auto buffer = make_shared< ::ndn::Buffer>(estimatedMaxPayloadSize);
   data->setContent(buffer);
 
+  if (m_inBandManifest)
+  {
+    // largest possible encoding of the in-band manifest
+    FileManifest::SetInBand(*data, std::numeric_limits<long>::max(), estimatedMaxPayloadSize);
+  }
+
   Signature signature;
   SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
 
@@ -542,6 +568,21 @@ long FakeMultimediaServer::GetFileSize(std::string filename)
 }
 
 
+long
+FakeMultimediaServer::GetObjectSize(const Name& name) const
+{
+  std::string fname = name.toUri();
+  if (fname.compare(0, m_prefix.length(), m_prefix) != 0)
+    return -1;
+
+  std::map<std::string,long>::const_iterator size = m_fileSizes.find(fname.substr(m_prefix.length()));
+  if (size == m_fileSizes.end())
+    return -1;
+
+  return size->second;
+}
+
+
 
 
 
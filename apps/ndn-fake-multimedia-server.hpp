@@ -49,6 +49,14 @@ public:
   virtual void
   OnInterest(shared_ptr<const Interest> interest);
 
+  /**
+   * @brief Get the size of a (virtual) file in bytes
+   * @param name full name of the file, including the prefix
+   * @return -1, if the file is not served by this application
+   */
+  long
+  GetObjectSize(const Name& name) const;
+
 protected:
   // inherited from Application base class.
   virtual void
@@ -81,6 +89,7 @@ protected:
   EstimateOverhead(std::string& fname);
 
   uint16_t m_MTU;
+  uint16_t m_maxDataSize; ///< @brief overrides the NetDevice MTU, if not 0
 
 
   ndn::time::milliseconds m_freshnessTime;
@@ -102,6 +111,8 @@ private:
 
   uint32_t m_signature;
   Name m_keyLocator;
+
+  bool m_inBandManifest;
 };
 
 } // namespace ndn
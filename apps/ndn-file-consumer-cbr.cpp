@@ -27,6 +27,7 @@
 
 
 #include <math.h>
+#include <algorithm>
 
 
 NS_LOG_COMPONENT_DEFINE("ndn.FileConsumerCbr");
@@ -50,6 +51,12 @@ FileConsumerCbr::GetTypeId(void)
       .AddAttribute("StartWindowSize", "The amount of interests that are allowed to be issued at the beginning of the download without knowing the actual file size (0 = none)", UintegerValue(0),
                     MakeUintegerAccessor(&FileConsumerCbr::m_fileStartWindow),
                     MakeUintegerChecker<uint32_t>())
+      .AddAttribute("PacingGranularity", "Minimum time between two send events; if more than one Interest is due within this time, they are sent as a burst (0 = one Interest per event)",
+                    TimeValue(Seconds(0)),
+                    MakeTimeAccessor(&FileConsumerCbr::m_pacingGranularity), MakeTimeChecker())
+      .AddAttribute("BurstJitter", "Randomize the size of Interest bursts (the average rate stays the same)",
+                    BooleanValue(false),
+                    MakeBooleanAccessor(&FileConsumerCbr::m_burstJitter), MakeBooleanChecker())
     ;
 
   return tid;
@@ -80,9 +87,17 @@ FileConsumerCbr::StartApplication()
     NS_LOG_DEBUG("Bitrate: " << bitrate << ", max_packets: " << max_packets_possible);
     m_windowSize = floor(max_packets_possible);
   }
+}
+
 
-  m_maxSeqNo = m_fileStartWindow;
-  m_sequenceStatus.resize(m_fileStartWindow+1); // set initial size, +1 for the manifest
+void
+FileConsumerCbr::InitFileState()
+{
+  FileConsumer::InitFileState();
+
+  // without manifest, chunk 1 is always requested first (it carries the file size)
+  m_maxSeqNo = m_useManifest ? m_fileStartWindow : std::max<uint32_t>(m_fileStartWindow, 1);
+  m_sequenceStatus.resize(m_maxSeqNo+1); // set initial size, +1 for the manifest
   m_fileSize = 1; // temporarily setting this
 
   m_inFlight = 0;
@@ -108,23 +123,70 @@ FileConsumerCbr::AfterData(bool manifest, bool timeout, uint32_t seq_nr)
 
 
 
+uint32_t
+FileConsumerCbr::GetBurstSize()
+{
+  // number of Interests that are due within one pacing interval
+  double burst = m_pacingGranularity.GetSeconds() * m_windowSize;
+  if (burst <= 1.0)
+    return 1;
+
+  if (m_burstJitter)
+  {
+    // uniformly distributed around the average burst size, rounded at random
+    burst = m_rand->GetValue(burst / 2.0, burst * 3.0 / 2.0);
+    return std::max<uint32_t>(1, floor(burst + m_rand->GetValue()));
+  }
+
+  return floor(burst);
+}
+
+
+double
+FileConsumerCbr::GetPacingInterval() const
+{
+  return std::max(1000.0 / m_windowSize, m_pacingGranularity.GetSeconds() * 1000.0);
+}
+
+
+bool
+FileConsumerCbr::CanSendMore() const
+{
+  return (m_packetsSent < m_fileStartWindow && m_fileSize == 1) ||
+         (m_hasReceivedManifest && this->m_fileSize > 0);
+}
+
+
 bool
 FileConsumerCbr::SendPacket()
 {
   NS_LOG_FUNCTION_NOARGS();
-  bool okay = FileConsumer::SendPacket();
 
-  if (okay)
+  // send all Interests that are due until the next send event at once
+  uint32_t burst = GetBurstSize();
+  uint32_t sent = 0;
+  while (sent < burst)
   {
+    if (!FileConsumer::SendPacket())
+      break;
+
+    sent++;
     m_inFlight++;
+
+    if (!CanSendMore())
+      break;
   }
 
+  // the next event is due once the Interests actually sent have used up their share of the
+  // rate; if nothing could be sent, check again after a full pacing interval
+  uint32_t intervals = sent > 0 ? sent : burst;
+
   if (m_packetsSent < m_fileStartWindow && m_fileSize == 1)
   {
     // fprintf(stderr, "Pre-requesting packet no %d\n", m_packetsSent);
     // schedule next event
     double rrr = m_rand->GetValue()*5.0 - 2.5; // randomize the send-time a little bit
-    ScheduleNextSendEvent((rrr + 1000.0) / (double)m_windowSize);
+    ScheduleNextSendEvent(intervals * (rrr + 1000.0) / (double)m_windowSize);
   } else {
     if (m_hasReceivedManifest && this->m_fileSize > 0)
     {
@@ -135,16 +197,15 @@ FileConsumerCbr::SendPacket()
       } else {
         // schedule next event
         double rrr = m_rand->GetValue()*5.0 - 2.5; // randomize the send-time a little bit
-        ScheduleNextSendEvent((rrr + 1000.0) / (double)m_windowSize);
+        ScheduleNextSendEvent(intervals * (rrr + 1000.0) / (double)m_windowSize);
       }
     }
   }
 
-  return okay;
+  return sent > 0;
 }
 
 
 
-
 } // namespace ndn
 } // namespace ns3
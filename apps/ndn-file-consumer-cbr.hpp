@@ -51,18 +51,45 @@ public:
 
 protected:
 
+  virtual void
+  InitFileState();
+
   virtual bool
   SendPacket();
 
   virtual void
   AfterData(bool manifest, bool timeout, uint32_t seq_nr);
 
+  /**
+   * \brief Number of Interests to send in the current send event
+   *
+   * All Interests that are due within PacingGranularity (at a rate of m_windowSize per second)
+   * are sent at once, which keeps the average rate but reduces the number of scheduled events
+   */
+  uint32_t
+  GetBurstSize();
+
+  /**
+   * \brief Nominal time (in milliseconds) between two send events
+   */
+  double
+  GetPacingInterval() const;
+
+  /**
+   * \brief Whether more Interests can be sent in the current burst
+   */
+  bool
+  CanSendMore() const;
+
 
   double m_windowSize;
   unsigned int m_inFlight;
 
   unsigned int m_fileStartWindow;
 
+  Time m_pacingGranularity; ///< @brief minimum time between two send events
+  bool m_burstJitter;       ///< @brief randomize burst sizes
+
 
 };
 
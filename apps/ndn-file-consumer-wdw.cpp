@@ -27,6 +27,7 @@
 
 
 #include <math.h>
+#include <algorithm>
 
 
 NS_LOG_COMPONENT_DEFINE("ndn.FileConsumerWdw");
@@ -76,6 +77,24 @@ FileConsumerWdw::StartApplication()
   ignoreGoodCounter = 0;
 
   m_cwndPhase = SlowStart;
+
+  if (m_congestionControl != 0)
+  {
+    m_windowSize = GetCongestionControlRate();
+  }
+}
+
+
+double
+FileConsumerWdw::GetCongestionControlRate()
+{
+  // one congestion window per RTT, but not faster than the link allows
+  Time rtt = m_congestionControl->GetSmoothedRtt();
+  if (rtt.IsZero())
+    rtt = m_rtt->GetCurrentEstimate();
+
+  double rate = m_congestionControl->GetWindow() / std::max(rtt.ToDouble(Time::S), 0.001);
+  return std::max(1.0, std::min(rate, (double)m_maxWindowSize));
 }
 
 
@@ -111,6 +130,17 @@ FileConsumerWdw::AfterData(bool manifest, bool timeout, uint32_t seq_nr)
   if (manifest)
   {
     SendPacket();
+  } else if (m_congestionControl != 0)
+  {
+    // the window has been updated by the congestion controller already
+    double previousRate = m_windowSize;
+    m_windowSize = GetCongestionControlRate();
+
+    if (m_windowSize > previousRate &&
+        m_nextEventScheduleTime > Simulator::Now().GetMilliSeconds() + GetPacingInterval())
+    {
+      ScheduleNextSendEvent(1000.0 / m_windowSize);
+    }
   } else
   {
     if (timeout && ignoreTimeoutsCounter == 0)
@@ -136,7 +166,8 @@ FileConsumerWdw::AfterData(bool manifest, bool timeout, uint32_t seq_nr)
       }
 
       // Schedule Next Event earlier, if necessary (most likely yes, because we increased the window)
-      if (m_nextEventScheduleTime > Simulator::Now().GetMilliSeconds() + (1000.0 / m_windowSize))
+      // (Interests are paced in bursts, so only if the next burst is further away than one pacing interval)
+      if (m_nextEventScheduleTime > Simulator::Now().GetMilliSeconds() + GetPacingInterval())
       {
         ScheduleNextSendEvent(1000.0 / m_windowSize);
       }
@@ -72,6 +72,12 @@ protected:
   virtual void
   DecrementWindow();
 
+  /**
+   * \brief Interest rate (per second) given by the congestion window of CongestionControl
+   */
+  double
+  GetCongestionControlRate();
+
 
   unsigned int m_maxWindowSize;
   unsigned int m_cwndSSThresh;
@@ -28,10 +28,12 @@
 #include "utils/ndn-ns3-packet-tag.hpp"
 #include "model/ndn-app-face.hpp"
 #include "utils/ndn-rtt-mean-deviation.hpp"
+#include "utils/ndn-file-manifest.hpp"
 
 #include "model/ndn-app-face.hpp"
 
 #include "ns3/wifi-net-device.h"
+#include "ns3/object-factory.h"
 
 #include <math.h>
 
@@ -46,9 +48,6 @@
 
 
 
-#define ALPHA 0.125
-#define BETA 0.25
-#define MINIMUM_DEVIATION 5.0
 #define MINIMUM_TIMEOUT 10.0
 
 
@@ -73,14 +72,38 @@ FileConsumer::GetTypeId(void)
                     MakeTimeAccessor(&FileConsumer::m_interestLifeTime), MakeTimeChecker())
       .AddAttribute("ManifestPostfix", "The manifest string added after a file", StringValue("/manifest"),
                     MakeStringAccessor(&FileConsumer::m_manifestPostfix), MakeStringChecker())
+      .AddAttribute("UseManifest", "Request the manifest before the file (false: take the file size from the "
+                    "MetaInfo of the first chunk, requires InBandManifest on the server)", BooleanValue(true),
+                    MakeBooleanAccessor(&FileConsumer::m_useManifest), MakeBooleanChecker())
       .AddAttribute("WriteOutfile", "Write the downloaded file to outfile (empty means disabled)", StringValue(""),
                     MakeStringAccessor(&FileConsumer::m_outFile), MakeStringChecker())
-      .AddAttribute("MaxEstimatedRTT", "The maximum RTT the RTTEstimator should have (in ms)", UintegerValue(500),
+      .AddAttribute("ReorderWindow", "Maximum number of out-of-order chunks held in memory while "
+                    "writing the outfile (chunks further ahead are written directly at their offset)",
+                    UintegerValue(64),
+                    MakeUintegerAccessor(&FileConsumer::m_reorderWindow),
+                    MakeUintegerChecker<uint32_t>())
+      .AddAttribute("WriteOutfileMmap", "Map the outfile into memory (sparse file of the final size) "
+                    "instead of writing chunks to it", BooleanValue(false),
+                    MakeBooleanAccessor(&FileConsumer::m_writeOutfileMmap), MakeBooleanChecker())
+      .AddAttribute("MaxEstimatedRTT", "The maximum retransmission timeout the RTTEstimator should have (in ms)", UintegerValue(500),
                     MakeUintegerAccessor(&FileConsumer::m_maxRTT),
                     MakeUintegerChecker<uint32_t>())
       .AddAttribute("InitialRTT", "The initial RTT the RTTEstimator should have (in ms)", UintegerValue(500),
                     MakeUintegerAccessor(&FileConsumer::m_initialRTT),
                     MakeUintegerChecker<uint32_t>())
+      .AddAttribute("RttEstimator", "TypeId of the RTT estimator (e.g., ns3::ndn::RttMeanDeviation, "
+                    "ns3::ndn::RttMinFilter, ns3::ndn::RttWindowedPercentile)",
+                    StringValue("ns3::ndn::RttMeanDeviation"),
+                    MakeStringAccessor(&FileConsumer::SetRttEstimatorType,
+                                       &FileConsumer::GetRttEstimatorType),
+                    MakeStringChecker())
+      .AddAttribute("CongestionControl", "TypeId of the congestion controller (e.g., "
+                    "ns3::ndn::CongestionControlAimd, ns3::ndn::CongestionControlCubic, "
+                    "ns3::ndn::CongestionControlRttGradient), empty for the built-in scheme",
+                    StringValue(""),
+                    MakeStringAccessor(&FileConsumer::SetCongestionControlType,
+                                       &FileConsumer::GetCongestionControlType),
+                    MakeStringChecker())
       .AddTraceSource("FileDownloadFinished", "Trace called every time a download finishes",
                       MakeTraceSourceAccessor(&FileConsumer::m_downloadFinishedTrace))
       .AddTraceSource("ManifestReceived", "Trace called every time a manifest is received",
@@ -88,7 +111,11 @@ FileConsumer::GetTypeId(void)
       .AddTraceSource("FileDownloadStarted", "Trace called every time a download starts",
                       MakeTraceSourceAccessor(&FileConsumer::m_downloadStartedTrace))
       .AddTraceSource("CurrentPacketStats", "Trace current packets statistics (once per second)",
-                      MakeTraceSourceAccessor(&FileConsumer::m_currentStatsTrace));
+                      MakeTraceSourceAccessor(&FileConsumer::m_currentStatsTrace))
+      .AddTraceSource("CongestionWindow", "Congestion window of the flow (with CongestionControl set)",
+                      MakeTraceSourceAccessor(&FileConsumer::m_congestionWindow))
+      .AddTraceSource("RttSample", "RTT sample of every Data packet that yields one",
+                      MakeTraceSourceAccessor(&FileConsumer::m_rttTrace));
     ;
 
   return tid;
@@ -97,18 +124,68 @@ FileConsumer::GetTypeId(void)
 FileConsumer::FileConsumer()
 {
   NS_LOG_FUNCTION_NOARGS();
-  m_localDataCache = NULL;
 }
 
 FileConsumer::~FileConsumer()
 {
 }
 
+void
+FileConsumer::SetRttEstimatorType(std::string rttEstimatorType)
+{
+  ObjectFactory factory(rttEstimatorType);
+  m_rtt = factory.Create<RttEstimator>();
+  m_rttEstimatorType = rttEstimatorType;
+}
+
+std::string
+FileConsumer::GetRttEstimatorType() const
+{
+  return m_rttEstimatorType;
+}
+
+void
+FileConsumer::SetCongestionControlType(std::string congestionControlType)
+{
+  m_congestionControlType = congestionControlType;
+  m_congestionControl = 0;
+  if (congestionControlType.empty())
+    return;
+
+  ObjectFactory factory(congestionControlType);
+  m_congestionControl = factory.Create<CongestionControl>();
+}
+
+std::string
+FileConsumer::GetCongestionControlType() const
+{
+  return m_congestionControlType;
+}
+
+void
+FileConsumer::UpdateCongestionControl(bool timeout, Time rtt)
+{
+  if (!rtt.IsZero())
+    m_rttTrace(rtt);
+
+  if (m_congestionControl == 0)
+    return;
+
+  if (timeout)
+    m_congestionControl->OnTimeout();
+  else
+    m_congestionControl->OnData(rtt);
+
+  m_congestionWindow = m_congestionControl->GetWindow();
+}
+
 
 void
 FileConsumer::PacketStatsUpdateEvent()
 {
-  m_currentStatsTrace(this, _shared_interestName, m_packetsSent, m_packetsReceived, m_packetsTimeout, m_packetsRetransmitted, EstimatedRTT, DeviationRTT);
+  m_currentStatsTrace(this, _shared_interestName, m_packetsSent, m_packetsReceived, m_packetsTimeout, m_packetsRetransmitted,
+                     m_rtt->GetCurrentEstimate().ToDouble(Time::MS),
+                     m_rtt->GetVariation().ToDouble(Time::MS));
 
   if (!m_active || m_finishedDownloadingFile == true)
     return;
@@ -129,47 +206,259 @@ FileConsumer::StartApplication() // Called at time specified by Start
   // do base stuff
   App::StartApplication();
 
+  m_rtt->Reset();
+  m_rtt->SetCurrentEstimate(MilliSeconds(m_initialRTT));
+  m_rtt->SetMinRto(MilliSeconds(MINIMUM_TIMEOUT));
+  m_rtt->SetMaxRto(MilliSeconds(m_maxRTT));
+
+  if (m_congestionControl != 0)
+  {
+    m_congestionControl->Reset();
+    m_congestionWindow = m_congestionControl->GetWindow();
+  }
+
+  m_rttSeqBase = 0;
+
+  // initialize random variable generator
+  m_rand = CreateObject<UniformRandomVariable>();
+
+  InitFileState();
+
+  // Start requester - schedule "SendPacket" method immediately (this will request the file manifest)
+  ScheduleNextSendEvent();
+  PacketStatsUpdateEvent();
+}
+
+
+void
+FileConsumer::InitFileState()
+{
+  NS_LOG_FUNCTION_NOARGS();
+
   // initialize variables
   m_hasReceivedManifest = false;
   m_hasRequestedManifest = false;
   m_finishedDownloadingFile = false;
+  m_allChunksRequested = false;
 
   m_fileSize = 0;
   m_curSeqNo = -1;
   m_maxSeqNo = -1;
   m_lastSeqNoReceived = -1;
 
-  DeviationRTT = 0.0;
-  EstimatedRTT = m_initialRTT;
-
   m_sequenceStatus.clear();
   m_sequenceStatus.resize(1); // set initial size to 1 to cover the manifest
 
+  if (!m_useManifest)
+  {
+    // the first chunk tells us the file size, so we can start requesting chunks right away
+    m_hasRequestedManifest = true;
+    m_sequenceStatus[0] = Received;
+    m_sequenceStatus.resize(2);
+    m_maxSeqNo = 1;
+    m_fileSize = 1; // temporarily setting this
+  }
 
   m_packetsReceived = m_packetsSent = m_packetsTimeout = m_packetsRetransmitted = 0;
 
-  // initialize random variable generator
-  m_rand = CreateObject<UniformRandomVariable>();
-
   if (!m_outFile.empty())
   {
     // create outfile
     FILE* fp = fopen(m_outFile.c_str(), "w");
     fclose(fp);
   }
-  // create buffer (set to NULL for now)
-  m_localDataCache = NULL;
-
   // set start time
   _start_time = Simulator::Now().GetMilliSeconds ();
 
   _shared_interestName = make_shared<Name>(m_interestName);
 
   m_downloadStartedTrace(this, _shared_interestName);
+}
+
+
+void
+FileConsumer::StartNextFile(const Name& fileName)
+{
+  NS_LOG_FUNCTION(this << fileName);
+  NS_ASSERT_MSG(m_outFile.empty(), "StartNextFile does not support WriteOutfile");
+
+  Simulator::Cancel(m_sendEvent);
+
+  uint32_t nSeqNos = m_sequenceStatus.size();
+
+  if (m_hasReceivedManifest && !m_finishedDownloadingFile && m_fileSize > 0 &&
+      m_pipelinedFiles.find(m_interestName) == m_pipelinedFiles.end())
+  {
+    // complete the chunks of the current file in the background
+    PipelinedFile& file = m_pipelinedFiles[m_interestName];
+    file.name = _shared_interestName;
+    file.fileSize = m_fileSize;
+    file.maxSeqNo = m_maxSeqNo;
+    file.rttSeqBase = m_rttSeqBase;
+    file.startTime = _start_time;
+    file.sequenceStatus.swap(m_sequenceStatus);
+    file.nMissing = 0;
+
+    for (uint32_t seqNo = 1; seqNo <= file.maxSeqNo; seqNo++)
+    {
+      if (file.sequenceStatus[seqNo] == Received)
+        continue;
+
+      file.nMissing++;
+
+      auto event = m_chunkTimeoutEvents.find(seqNo);
+      if (file.sequenceStatus[seqNo] == Requested && event != m_chunkTimeoutEvents.end() &&
+          event->second.IsRunning())
+      {
+        // the pending timeout must not fire for the next file
+        Time remaining = TimeStep(event->second.GetTs()) - Simulator::Now();
+        file.chunkTimeoutEvents[seqNo] =
+          Simulator::Schedule(remaining, &FileConsumer::CheckPipelinedSeqForTimeout, this,
+                              m_interestName, seqNo);
+      }
+      else
+      {
+        SendPipelinedFilePacket(file, seqNo);
+      }
+    }
+
+    NS_LOG_DEBUG("Completing " << file.nMissing << " chunks of " << m_interestName
+                 << " in the background");
+  }
+
+  for (auto& event : m_chunkTimeoutEvents)
+  {
+    Simulator::Cancel(event.second);
+  }
+  m_chunkTimeoutEvents.clear();
+
+  // chunk numbers of the next file must not be confused with those still in flight
+  m_rttSeqBase += nSeqNos;
+
+  m_interestName = fileName;
+  InitFileState();
 
-  // Start requester - schedule "SendPacket" method immediately (this will request the file manifest)
   ScheduleNextSendEvent();
-  PacketStatsUpdateEvent();
+  if (!m_packetStatsUpdateEvent.IsRunning())
+    PacketStatsUpdateEvent();
+}
+
+
+void
+FileConsumer::NotifyAllChunksRequested()
+{
+  if (!m_active || !m_allChunksRequested || m_finishedDownloadingFile)
+    return;
+
+  OnAllChunksRequested();
+}
+
+
+void
+FileConsumer::OnAllChunksRequested()
+{
+}
+
+
+void
+FileConsumer::OnPipelinedFileReceived(shared_ptr<const Name> fileName, double downloadSpeed)
+{
+}
+
+
+bool
+FileConsumer::IsPipelinedFile(const Name& fileName) const
+{
+  return m_pipelinedFiles.find(fileName) != m_pipelinedFiles.end();
+}
+
+
+void
+FileConsumer::OnPipelinedFileData(std::map<Name, PipelinedFile>::iterator it, uint32_t seqNo)
+{
+  PipelinedFile& file = it->second;
+
+  if (seqNo == 0 || seqNo > file.maxSeqNo || file.sequenceStatus[seqNo] == Received)
+    return; // duplicate
+
+  file.sequenceStatus[seqNo] = Received;
+  UpdateCongestionControl(false, m_rtt->AckSeq(SequenceNumber32(file.rttSeqBase + seqNo)));
+
+  auto event = file.chunkTimeoutEvents.find(seqNo);
+  if (event != file.chunkTimeoutEvents.end())
+  {
+    Simulator::Cancel(event->second);
+    file.chunkTimeoutEvents.erase(event);
+  }
+
+  if (--file.nMissing == 0)
+  {
+    // same as CalculateDownloadSpeed, but for the pipelined file
+    int64_t downloadTime = std::max<int64_t>(Simulator::Now().GetMilliSeconds() - file.startTime, 1);
+    double downloadSpeed = ((double)(file.fileSize * 8)) / (((double)downloadTime) / 1000.0);
+    shared_ptr<const Name> fileName = file.name;
+
+    NS_LOG_DEBUG("Pipelined file " << *fileName << " finished after " << downloadTime << "ms");
+    m_downloadFinishedTrace(this, fileName, downloadSpeed, downloadTime);
+
+    m_pipelinedFiles.erase(it);
+    OnPipelinedFileReceived(fileName, downloadSpeed);
+  }
+
+  AfterData(false, false, seqNo);
+}
+
+
+void
+FileConsumer::SendPipelinedFilePacket(PipelinedFile& file, uint32_t seqNo)
+{
+  if (file.sequenceStatus[seqNo] == TimedOut)
+    m_packetsRetransmitted++;
+
+  file.sequenceStatus[seqNo] = Requested;
+  m_rtt->SentSeq(SequenceNumber32(file.rttSeqBase + seqNo), 1);
+
+  Time lifetime = m_rtt->RetransmitTimeout();
+  shared_ptr<Interest> interest = m_interestBuilder.Build(*file.name, seqNo, lifetime);
+
+  // same as CreateTimeoutEvent, 1 milisecond after the interest lifetime is over
+  file.chunkTimeoutEvents[seqNo] = Simulator::Schedule(lifetime + MilliSeconds(1),
+                                                       &FileConsumer::CheckPipelinedSeqForTimeout,
+                                                       this, *file.name, seqNo);
+
+  NS_LOG_INFO("> Pipelined file INTEREST (Seq: " << seqNo << "): " << interest->getName());
+
+  m_transmittedInterests(interest, this, m_face);
+  ExpressInterest(*interest);
+
+  m_packetsSent++;
+}
+
+
+void
+FileConsumer::CheckPipelinedSeqForTimeout(Name fileName, uint32_t seqNo)
+{
+  auto it = m_pipelinedFiles.find(fileName);
+  if (it == m_pipelinedFiles.end())
+    return;
+
+  PipelinedFile& file = it->second;
+  file.chunkTimeoutEvents.erase(seqNo);
+
+  if (file.sequenceStatus[seqNo] == Received)
+    return;
+
+  NS_LOG_DEBUG("Timeout occured for seq " << seqNo << " of pipelined file " << fileName);
+  file.sequenceStatus[seqNo] = TimedOut;
+  m_packetsTimeout++;
+
+  // the chunks share the path (and the estimator) with the current file
+  m_rtt->IncreaseMultiplier();
+  UpdateCongestionControl(true, Seconds(0));
+
+  SendPipelinedFilePacket(file, seqNo);
+
+  OnTimeout(seqNo);
 }
 
 
@@ -190,13 +479,19 @@ FileConsumer::StopApplication() // Called at time specified by Stop
     Simulator::Cancel(it->second);
   }
 
-  m_sequenceStatus.clear();
-
-  if (m_localDataCache != NULL)
+  // files left in flight by StartNextFile are abandoned
+  for (auto& file : m_pipelinedFiles)
   {
-    free(m_localDataCache);
-    m_localDataCache = NULL;
+    for (auto& event : file.second.chunkTimeoutEvents)
+    {
+      Simulator::Cancel(event.second);
+    }
   }
+  m_pipelinedFiles.clear();
+
+  m_sequenceStatus.clear();
+
+  m_reassembler.Close();
 
   m_outFile = "";
 
@@ -251,29 +546,22 @@ FileConsumer::SendManifestPacket()
 
   NS_LOG_FUNCTION_NOARGS();
 
-  shared_ptr<Name> interestNameWithManifest = make_shared<Name>(m_interestName);
+  Name interestNameWithManifest(m_interestName);
 
   // create the interest name: m_interestName + manifest string (postfix)
-  interestNameWithManifest->append(m_manifestPostfix);
+  interestNameWithManifest.append(m_manifestPostfix);
 
-  //fprintf(stderr, "interestNameWithManifest=%s\n", interestNameWithManifest->toUri().c_str());
-
-  // create an interest, set nonce
-  shared_ptr<Interest> interest = make_shared<Interest>();
-  interest->setNonce(m_rand->GetValue()*1000);
-  interest->setName(*interestNameWithManifest);
-
-  m_manifestRequestTime = Simulator::Now().GetMilliSeconds();
+  // the manifest is sampled as sequence 0
+  m_rtt->SentSeq(SequenceNumber32(m_rttSeqBase), 1);
 
   // set the interest lifetime
-  long timeout = 1.0 * EstimatedRTT + 4.0 * DeviationRTT; // , where u = 1 and q = 4
-
-  m_interestLifeTime = ns3::Time::FromDouble(timeout, ns3::Time::MS);
+  m_interestLifeTime = m_rtt->RetransmitTimeout();
 
   m_sequenceStatus[0] = Requested;
 
-  time::milliseconds interestLifeTime(m_interestLifeTime.GetMilliSeconds());
-  interest->setInterestLifetime(interestLifeTime);
+  // create the interest (with nonce and lifetime)
+  shared_ptr<Interest> interest = m_interestBuilder.Build(interestNameWithManifest,
+                                                          m_interestLifeTime);
   CreateTimeoutEvent(0, m_interestLifeTime.GetMilliSeconds());
 
   // log that we created the interest
@@ -281,7 +569,7 @@ FileConsumer::SendManifestPacket()
   m_hasRequestedManifest = true;
 
   m_transmittedInterests(interest, this, m_face);
-  m_face->onReceiveInterest(*interest);
+  ExpressInterest(*interest);
 
   return true;
 
@@ -307,32 +595,15 @@ FileConsumer::SendFilePacket()
     m_packetsRetransmitted++;
 
   m_sequenceStatus[seq] = Requested;
-  m_sequenceSendTime[seq] = Simulator::Now().GetMilliSeconds();
+  m_rtt->SentSeq(SequenceNumber32(m_rttSeqBase + seq), 1); // marked as retransmission, if still outstanding
 
   NS_LOG_FUNCTION_NOARGS();
 
 
   // set the interest lifetime
-  double timeout = 1.0 * EstimatedRTT + 4.0 * DeviationRTT; // , where u = 1 and q = 4
-
-  if (timeout < MINIMUM_TIMEOUT)
-    timeout = MINIMUM_TIMEOUT;
-
-
-  m_interestLifeTime = ns3::Time::FromDouble(timeout, ns3::Time::MS);
-
-  shared_ptr<Name> nameWithSequence = make_shared<Name>(m_interestName);
-
-  nameWithSequence->appendSequenceNumber(seq);
+  m_interestLifeTime = m_rtt->RetransmitTimeout();
 
-  shared_ptr<Interest> interest = make_shared<Interest>();
-
-  // m_rand returns a double value - multiply by 1000, else (int)nonce is always 0 !!!
-  interest->setNonce(m_rand->GetValue()*1000);
-  interest->setName(*nameWithSequence);
-
-  time::milliseconds interestLifeTime(m_interestLifeTime.GetMilliSeconds());
-  interest->setInterestLifetime(interestLifeTime);
+  shared_ptr<Interest> interest = m_interestBuilder.Build(m_interestName, seq, m_interestLifeTime);
 
   CreateTimeoutEvent(seq, m_interestLifeTime.GetMilliSeconds());
 
@@ -340,10 +611,17 @@ FileConsumer::SendFilePacket()
 
 
   m_transmittedInterests(interest, this, m_face);
-  m_face->onReceiveInterest(*interest);
+  ExpressInterest(*interest);
 
   m_curSeqNo++;
 
+  // chunks are requested in order (retransmissions first), so this was the last new one
+  if (m_hasReceivedManifest && seq == m_maxSeqNo && !m_allChunksRequested)
+  {
+    m_allChunksRequested = true;
+    Simulator::ScheduleNow(&FileConsumer::NotifyAllChunksRequested, this);
+  }
+
   return true;
 }
 
@@ -408,6 +686,9 @@ FileConsumer::CreateTimeoutEvent(uint32_t seqNo, uint32_t timeout)
 void
 FileConsumer::CheckSeqForTimeout(uint32_t seqNo)
 {
+  if (seqNo >= m_sequenceStatus.size())
+    return; // requested before the file size was known, but beyond the end of the file
+
   if (m_hasReceivedManifest == false && seqNo == 0)
   {
     // means this timeout is about the manifest
@@ -427,10 +708,9 @@ FileConsumer::CheckSeqForTimeout(uint32_t seqNo)
 
     m_packetsTimeout++;
 
-    // update estimated rtt
-    EstimatedRTT = EstimatedRTT * 2;
-    if (EstimatedRTT > m_maxRTT)
-      EstimatedRTT = m_maxRTT;
+    // back off the retransmission timeout
+    m_rtt->IncreaseMultiplier();
+    UpdateCongestionControl(true, Seconds(0));
 
 
     // call ontimeout
@@ -468,19 +748,23 @@ FileConsumer::OnData(shared_ptr<const Data> data)
 
 
   // get the hopcount
-  int hopCount = -1;
-  auto ns3PacketTag = data->getTag<Ns3PacketTag>();
-  if (ns3PacketTag != nullptr) {
-    FwHopCountTag hopCountTag;
-    if (ns3PacketTag->getPacket()->PeekPacketTag(hopCountTag)) {
-      hopCount = hopCountTag.Get();
-      NS_LOG_DEBUG("Hop count: " << hopCount);
-    }
-  }
+  int hopCount = Ns3PacketTag::hopCountOf(*data);
+  NS_LOG_DEBUG("Hop count: " << hopCount);
 
   // get interest name
   ndn::Name interestName = data->getName();
 
+  // chunk of a file left in flight by StartNextFile
+  if (!m_pipelinedFiles.empty())
+  {
+    auto file = m_pipelinedFiles.find(interestName.getPrefix(-1));
+    if (file != m_pipelinedFiles.end())
+    {
+      OnPipelinedFileData(file, interestName.at(-1).toSequenceNumber());
+      return;
+    }
+  }
+
   // Check whether this is a Manifest Packet or a Data Packet
   // Manifest packets will end with m_manifestPostfix
   // only check if we haven't received the manifest yet
@@ -493,50 +777,30 @@ FileConsumer::OnData(shared_ptr<const Data> data)
     if (lastPostfix == m_manifestPostfix)
     {
       // this means we have just received the manifest
-      // get the content value: cast unit8_t* to long* and then dereference it
-      //long fileSize =  *((long*)data->getContent().value());
-
-      uint8_t *buffer = ((uint8_t*)data->getContent().value());
       long fileSize;
-      int maxPayload;
-      memcpy(&fileSize, buffer, sizeof(long));
-      memcpy(&maxPayload, buffer+sizeof(long), sizeof(unsigned));
-
-
-      NS_LOG_DEBUG("FileConsumer: Received Manifest! FileSize=" << fileSize << ", MaxPayload=" << maxPayload);
-      m_hasReceivedManifest = true;
-      m_fileSize = fileSize;
-      m_maxPayloadSize = maxPayload;
-
-      if (m_fileSize == -1)
-      {
-        NS_LOG_UNCOND("ERROR: FileConsumer: File not found on server: " << interestName);
-        m_fileSize = 0;
-        m_curSeqNo = 0;
-        m_maxSeqNo = 0;
-      } else
-      {
-        m_curSeqNo = 0;
-        m_maxSeqNo = ceil((double)m_fileSize/(double)m_maxPayloadSize);
-        NS_LOG_DEBUG("FileConsumer: Resulting Max Seq Nr = " << m_maxSeqNo);
-
-        // Trigger OnManifest
-        m_chunkTimeoutEvents[0].Cancel();
-        OnManifest(fileSize);
-        AfterData(true, false, 0);
-      }
+      unsigned maxPayload;
+      ParseManifest(*data, fileSize, maxPayload);
+      ProcessManifest(fileSize, maxPayload);
 
       return;
     }
+
+    if (!m_useManifest && !ProcessInBandManifest(*data))
+      return;
   }
   // else: this is a normal data packet, process it as such a data packet
 
   // Get seq_nr from Interest Name
   uint32_t seqNo = interestName.at(-1).toSequenceNumber();
+
+  if (seqNo > m_maxSeqNo)
+    return; // requested before the file size was known, but beyond the end of the file
+
   m_lastSeqNoReceived = seqNo;
 
   // make sure that we mark this sequence as received
   m_sequenceStatus[seqNo] = Received;
+  UpdateCongestionControl(false, m_rtt->AckSeq(SequenceNumber32(m_rttSeqBase + seqNo)));
 
   if (m_chunkTimeoutEvents.find( seqNo ) != m_chunkTimeoutEvents.end())
   {
@@ -561,6 +825,92 @@ FileConsumer::OnData(shared_ptr<const Data> data)
 }
 
 
+void
+FileConsumer::ParseManifest(const Data& data, long& fileSize, unsigned& maxPayload)
+{
+  uint32_t payload = 0;
+  if (!FileManifest::Decode(data.getContent(), fileSize, payload))
+  {
+    NS_LOG_WARN("FileConsumer: Malformed manifest " << data.getName());
+    fileSize = -1;
+  }
+  maxPayload = payload;
+}
+
+
+bool
+FileConsumer::ProcessInBandManifest(const Data& data)
+{
+  long fileSize;
+  uint32_t maxPayload;
+
+  if (FileManifest::GetInBand(data, fileSize, maxPayload))
+  {
+    // this chunk replaces the manifest
+    ProcessManifest(fileSize, maxPayload);
+    return true;
+  }
+
+  // server does not support in-band manifests, fall back to requesting the manifest
+  NS_LOG_WARN("FileConsumer: No in-band manifest in " << data.getName() << ", requesting manifest");
+
+  uint32_t seqNo = data.getName().at(-1).toSequenceNumber();
+  if (seqNo >= m_sequenceStatus.size() || m_sequenceStatus[seqNo] == NotRequested)
+    return false; // late chunk, the manifest has already been requested
+
+  // the other chunks requested ahead cannot be used either, they will be requested again once
+  // the manifest is known, so their timeouts must not fire (and back off the RTO) meanwhile
+  for (std::map<uint32_t,EventId>::iterator it = m_chunkTimeoutEvents.begin();
+       it != m_chunkTimeoutEvents.end(); it++)
+  {
+    Simulator::Cancel(it->second);
+  }
+  m_chunkTimeoutEvents.clear();
+  if (m_pipelinedFiles.empty())
+    m_rtt->ClearSent();
+
+  for (uint32_t i = 1; i < m_sequenceStatus.size(); i++)
+  {
+    if (m_sequenceStatus[i] != Received)
+      m_sequenceStatus[i] = NotRequested;
+  }
+  m_sequenceStatus[seqNo] = NotRequested;
+
+  m_hasRequestedManifest = false;
+  ScheduleNextSendEvent();
+  return false;
+}
+
+
+void
+FileConsumer::ProcessManifest(long fileSize, unsigned maxPayload)
+{
+  NS_LOG_DEBUG("FileConsumer: Received Manifest! FileSize=" << fileSize << ", MaxPayload=" << maxPayload);
+  m_hasReceivedManifest = true;
+  m_fileSize = fileSize;
+  m_maxPayloadSize = maxPayload;
+
+  if (m_fileSize == -1)
+  {
+    NS_LOG_UNCOND("ERROR: FileConsumer: File not found on server: " << m_interestName);
+    m_fileSize = 0;
+    m_curSeqNo = 0;
+    m_maxSeqNo = 0;
+  } else
+  {
+    m_curSeqNo = 0;
+    m_maxSeqNo = ceil((double)m_fileSize/(double)m_maxPayloadSize);
+    NS_LOG_DEBUG("FileConsumer: Resulting Max Seq Nr = " << m_maxSeqNo);
+
+    // Trigger OnManifest
+    m_chunkTimeoutEvents[0].Cancel();
+    m_rtt->AckSeq(SequenceNumber32(m_rttSeqBase));
+    OnManifest(fileSize);
+    AfterData(true, false, 0);
+  }
+}
+
+
 void
 FileConsumer::AfterData(bool manifest, bool timeout, uint32_t seq_nr)
 {
@@ -627,17 +977,13 @@ FileConsumer::OnManifest(long fileSize)
 
   if (!m_outFile.empty())
   {
-    // create m_localDataCache
-    m_localDataCache = (uint8_t*)malloc(sizeof(uint8_t) * fileSize);
+    // chunks are written as they arrive, memory is bounded by the reorder window
+    if (!m_reassembler.Open(m_outFile, fileSize, m_maxPayloadSize, m_reorderWindow,
+                            m_writeOutfileMmap)) {
+      NS_FATAL_ERROR("Cannot create output file " << m_outFile);
+    }
   }
 
-
-  long SampleRTT  = Simulator::Now().GetMilliSeconds() - m_manifestRequestTime;
-
-
-  EstimatedRTT = SampleRTT;
-  DeviationRTT = SampleRTT / 2;
-
   // call trace source
   m_manifestReceivedTrace(this, _shared_interestName, fileSize);
 }
@@ -647,39 +993,11 @@ void
 FileConsumer::OnFileData(uint32_t seq_nr, const uint8_t* data, unsigned length)
 {
   NS_LOG_FUNCTION(this << seq_nr << length);
-  // write outfile if defined
+  // write outfile if defined (the last chunk is trimmed to the file size)
   if (!m_outFile.empty())
   {
-
-    // FILE * fp = fopen(m_outFile.c_str(), "ab");
-    if (seq_nr < m_maxSeqNo)
-    {
-      memcpy(m_localDataCache + (seq_nr-1)*m_maxPayloadSize, data, length);
-      //fwrite(data, sizeof(uint8_t), length, fp);
-    } else
-    {
-      memcpy(m_localDataCache + (seq_nr-1)*m_maxPayloadSize, data, m_fileSize % m_maxPayloadSize);
-      //fwrite(data, sizeof(uint8_t), m_fileSize % m_maxPayloadSize, fp);
-    }
-    //fclose(fp);
+    m_reassembler.Write(seq_nr - 1, data, length);
   }
-
-
-  long SampleRTT  = Simulator::Now().GetMilliSeconds() - m_sequenceSendTime[seq_nr];
-  m_sequenceSendTime.erase(seq_nr);
-//  delete m_sequenceSendTime[seq_nr];
-
-
-  // 90% of estimated + 10% of measured RTT
-  EstimatedRTT = (1-BETA) * EstimatedRTT + BETA * SampleRTT;
-
-  double absDiff = abs(SampleRTT - EstimatedRTT);
-
-  if (absDiff < MINIMUM_DEVIATION)
-    absDiff = MINIMUM_DEVIATION;
-
-  DeviationRTT = (1-ALPHA)* DeviationRTT + ALPHA * absDiff;
-
 }
 
 void
@@ -723,12 +1041,11 @@ FileConsumer::OnFileReceived(unsigned status, unsigned length)
   // do nothing here
   NS_LOG_DEBUG("Finally received the whole file!");
 
-  // write file to disk
+  // all chunks have been written already, just flush what is left in the reorder window
   if (!m_outFile.empty())
   {
-    FILE* fp = fopen(m_outFile.c_str(), "w");
-    fwrite(m_localDataCache, sizeof(uint8_t), m_fileSize, fp);
-    fclose(fp);
+    m_reassembler.Close();
+    NS_LOG_DEBUG("Peak reorder buffer: " << m_reassembler.GetPeakBufferedBytes() << " bytes");
   }
 
   double downloadSpeed = CalculateDownloadSpeed();
@@ -746,8 +1063,9 @@ FileConsumer::OnFileReceived(unsigned status, unsigned length)
   Simulator::Cancel(m_sendEvent);
   m_chunkTimeoutEvents.clear();
 
-  // clear m_sequenceSendTime
-  m_sequenceSendTime.clear();
+  // forget outstanding RTT samples (unless chunks of pipelined files are still in flight)
+  if (m_pipelinedFiles.empty())
+    m_rtt->ClearSent();
 
   // do not clear m_sequenceStatus here, it might still be triggered...
 }
@@ -31,8 +31,13 @@
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 #include "ns3/ndnSIM/utils/ndn-fw-hop-count-tag.hpp"
+#include "ns3/ndnSIM/utils/ndn-rtt-estimator.hpp"
+#include "ns3/ndnSIM/utils/ndn-congestion-control.hpp"
+#include "ns3/ndnSIM/utils/ndn-file-reassembler.hpp"
+#include "ns3/ndnSIM/utils/ndn-interest-builder.hpp"
 
 #include "ns3/traced-callback.h"
+#include "ns3/traced-value.h"
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
 
@@ -84,7 +89,8 @@ public:
   enum SequenceStatus { NotRequested = 0, Requested = 1, TimedOut = 2, Received = 3 };
 
 protected:
-  Ptr<UniformRandomVariable> m_rand; ///< @brief nonce generator
+  Ptr<UniformRandomVariable> m_rand; ///< @brief random variable (e.g., send-time jitter)
+  InterestBuilder m_interestBuilder; ///< @brief builder of outgoing Interests (and their nonces)
 
   virtual void
   OnData(shared_ptr<const Data> data);
@@ -116,6 +122,57 @@ protected:
   virtual bool
   SendManifestPacket();
 
+  /**
+   * \brief Reset the state of the current file (called by StartApplication and StartNextFile)
+   */
+  virtual void
+  InitFileState();
+
+  /**
+   * \brief Start downloading @p fileName without stopping the application
+   *
+   * Chunks of the current file that are still in flight are completed in the background: they
+   * are retransmitted on timeout, and OnPipelinedFileReceived is called once all of them have
+   * arrived.  The RTT estimator and congestion controller are shared by all files.  Not
+   * supported with WriteOutfile.
+   */
+  void
+  StartNextFile(const Name& fileName);
+
+  /**
+   * \brief Called once every chunk of the current file has been requested (outside of the
+   *        send event), e.g., to start the next file with StartNextFile
+   */
+  virtual void
+  OnAllChunksRequested();
+
+  /**
+   * \brief Called when a file left in flight by StartNextFile has been received completely
+   */
+  virtual void
+  OnPipelinedFileReceived(shared_ptr<const Name> fileName, double downloadSpeed);
+
+  /**
+   * \brief Check whether @p fileName has been left in flight by StartNextFile
+   */
+  bool
+  IsPipelinedFile(const Name& fileName) const;
+
+  void
+  ParseManifest(const Data& data, long& fileSize, unsigned& maxPayload);
+
+  void
+  ProcessManifest(long fileSize, unsigned maxPayload);
+
+  /**
+   * \brief Take the file size from the MetaInfo of a chunk (UseManifest == false)
+   *
+   * Falls back to requesting the manifest if the chunk does not carry it
+   * \returns false if the chunk should be ignored
+   */
+  bool
+  ProcessInBandManifest(const Data& data);
+
   virtual bool
   SendFilePacket();
 
@@ -131,6 +188,32 @@ protected:
   virtual void
   CheckSeqForTimeout(uint32_t seqNo);
 
+  /**
+   * \brief Chunks of a file that are still in flight after StartNextFile
+   */
+  struct PipelinedFile {
+    shared_ptr<Name> name;
+    long fileSize;
+    uint32_t maxSeqNo;
+    uint32_t rttSeqBase;  ///< @brief added to chunk numbers for RTT samples
+    uint32_t nMissing;    ///< @brief chunks that have not been received yet
+    int64_t startTime;    ///< @brief in milliseconds
+    std::vector<SequenceStatus> sequenceStatus;
+    std::map<uint32_t, EventId> chunkTimeoutEvents;
+  };
+
+  void
+  OnPipelinedFileData(std::map<Name, PipelinedFile>::iterator file, uint32_t seqNo);
+
+  void
+  SendPipelinedFilePacket(PipelinedFile& file, uint32_t seqNo);
+
+  void
+  CheckPipelinedSeqForTimeout(Name fileName, uint32_t seqNo);
+
+  void
+  NotifyAllChunksRequested();
+
 
   long
   GetFaceBitrate(uint32_t faceId);
@@ -138,6 +221,25 @@ protected:
   uint16_t
   GetFaceMTU(uint32_t faceId);
 
+  void
+  SetRttEstimatorType(std::string rttEstimatorType);
+
+  std::string
+  GetRttEstimatorType() const;
+
+  void
+  SetCongestionControlType(std::string congestionControlType);
+
+  std::string
+  GetCongestionControlType() const;
+
+  /**
+   * \brief Pass Data/timeout to the congestion controller (if any) and update traces
+   * \param rtt RTT sample of received Data (zero, if none)
+   */
+  void
+  UpdateCongestionControl(bool timeout, Time rtt);
+
 
   EventId m_sendEvent; ///< @brief EventId of pending "send packet" event
   long m_nextEventScheduleTime;
@@ -145,6 +247,7 @@ protected:
   Time m_interestLifeTime; ///< \brief LifeTime for interest packet
 
   std::string m_manifestPostfix;
+  bool m_useManifest;
 
 
   bool m_hasRequestedManifest;
@@ -153,6 +256,8 @@ protected:
 
 
   std::string m_outFile;
+  uint32_t m_reorderWindow;  ///< @brief out-of-order chunks held in memory while writing m_outFile
+  bool m_writeOutfileMmap;   ///< @brief map m_outFile into memory instead of writing it
 
 
   long m_fileSize;
@@ -164,15 +269,18 @@ protected:
 
 
   std::vector<SequenceStatus> m_sequenceStatus;
-  uint8_t* m_localDataCache;
+  FileReassembler m_reassembler;
   std::map<uint32_t,EventId> m_chunkTimeoutEvents;
-  std::map<uint32_t,long> m_sequenceSendTime;
 
-  long m_manifestRequestTime;
+  std::map<Name /* file name */, PipelinedFile> m_pipelinedFiles;
+  uint32_t m_rttSeqBase; ///< @brief added to chunk numbers for RTT samples, unique per file
+  bool m_allChunksRequested;
 
+  Ptr<RttEstimator> m_rtt; ///< @brief RTT estimator (shared sampling engine with Consumer apps)
+  std::string m_rttEstimatorType;
 
-  double EstimatedRTT;
-  double DeviationRTT;
+  Ptr<CongestionControl> m_congestionControl; ///< @brief congestion controller (0 = built-in scheme)
+  std::string m_congestionControlType;
 
   unsigned int m_initialRTT;
   unsigned int m_maxRTT;
@@ -198,6 +306,9 @@ protected: // callbacks/traces
             double /* EstimatedRTT */, double /* RTTVariation */
             > m_currentStatsTrace;
 
+  TracedValue<double> m_congestionWindow;    ///< @brief congestion window of the flow
+  TracedCallback<Time /* rtt */> m_rttTrace; ///< @brief RTT samples of the flow
+
   double lastDownloadBitrate;
 
 private:
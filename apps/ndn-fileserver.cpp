@@ -22,6 +22,7 @@
 #include "ns3/log.h"
 #include "ns3/string.h"
 #include "ns3/uinteger.h"
+#include "ns3/boolean.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 
@@ -35,12 +36,14 @@
 #include "model/ndn-ns3.hpp"
 #include "model/ndn-l3-protocol.hpp"
 #include "helper/ndn-fib-helper.hpp"
+#include "utils/ndn-file-manifest.hpp"
 
 #include <memory>
 #include <sys/types.h>
 #include <sys/stat.h>
 
 #include <math.h>
+#include <limits>
 
 
 NS_LOG_COMPONENT_DEFINE("ndn.FileServer");
@@ -77,7 +80,17 @@ FileServer::GetTypeId(void)
          MakeUintegerChecker<uint32_t>())
       .AddAttribute("KeyLocator",
                     "Name to be used for key locator.  If root, then key locator is not used",
-                    NameValue(), MakeNameAccessor(&FileServer::m_keyLocator), MakeNameChecker());
+                    NameValue(), MakeNameAccessor(&FileServer::m_keyLocator), MakeNameChecker())
+      .AddAttribute("InBandManifest",
+                    "Carry FinalBlockId and the manifest in the MetaInfo of every chunk, so that "
+                    "consumers can start downloading without requesting the manifest first",
+                    BooleanValue(false), MakeBooleanAccessor(&FileServer::m_inBandManifest),
+                    MakeBooleanChecker())
+      .AddAttribute("MaxDataSize",
+                    "Maximum size of Data packets, 0 to use the MTU of the first NetDevice.  "
+                    "Data larger than the MTU requires ns3::ndn::L3Protocol::Fragmentation",
+                    UintegerValue(0), MakeUintegerAccessor(&FileServer::m_maxDataSize),
+                    MakeUintegerChecker<uint16_t>());
   return tid;
 }
 
@@ -97,7 +110,7 @@ FileServer::StartApplication()
 
   FibHelper::AddRoute(GetNode(), m_prefix, m_face, 0);
 
-  m_MTU = GetFaceMTU(0);
+  m_MTU = m_maxDataSize != 0 ? m_maxDataSize : GetFaceMTU(0);
 }
 
 void
@@ -201,13 +214,8 @@ FileServer::ReturnManifestData(shared_ptr<const Interest> interest, std::string&
   data->setName(interest->getName());
   data->setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
 
-  // create a local buffer variable, which contains a long and an unsigned
-  uint8_t buffer[sizeof(long) + sizeof(unsigned)];
-  memcpy(buffer, &fileSize, sizeof(long));
-  memcpy(buffer+sizeof(long), &m_maxPayloadSize, sizeof(unsigned));
-
-  // create content with the file size in it
-  data->setContent(reinterpret_cast<const uint8_t*>(buffer), sizeof(long) + sizeof(unsigned));
+  // create content with the file size and the payload size per chunk in it
+  data->setContent(FileManifest::Encode(fileSize, m_maxPayloadSize));
 
   Signature signature;
   SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
@@ -254,6 +262,12 @@ FileServer::ReturnPayloadData(shared_ptr<const Interest> interest, std::string&
 
   data->setContent(buffer);
 
+  if (m_inBandManifest)
+  {
+    // lets the consumer start without requesting the manifest
+    FileManifest::SetInBand(*data, GetFileSize(fname), m_maxPayloadSize);
+  }
+
   Signature signature;
   SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
 
@@ -298,6 +312,12 @@ FileServer::EstimateOverhead(std::string& fname)
   auto buffer = make_shared< ::ndn::Buffer>(estimatedMaxPayloadSize);
   data->setContent(buffer);
 
+  if (m_inBandManifest)
+  {
+    // largest possible encoding of the in-band manifest
+    FileManifest::SetInBand(*data, std::numeric_limits<long>::max(), estimatedMaxPayloadSize);
+  }
+
   Signature signature;
   SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
 
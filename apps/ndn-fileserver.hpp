@@ -79,6 +79,7 @@ protected:
 
 
   uint16_t m_MTU;
+  uint16_t m_maxDataSize; ///< @brief overrides the NetDevice MTU, if not 0
 
 private:
   std::string m_prefix;
@@ -94,6 +95,8 @@ private:
 
   uint32_t m_signature;
   Name m_keyLocator;
+
+  bool m_inBandManifest;
 };
 
 } // namespace ndn
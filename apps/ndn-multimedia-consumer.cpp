@@ -32,6 +32,7 @@
 #include "utils/ndn-ns3-packet-tag.hpp"
 #include "model/ndn-app-face.hpp"
 #include "utils/ndn-rtt-mean-deviation.hpp"
+#include "utils/ndn-segment-transfer-model.hpp"
 
 #include "model/ndn-app-face.hpp"
 
@@ -70,6 +71,10 @@ MultimediaConsumer<Parent>::GetTypeId(void)
                     MakeUintegerAccessor(&MultimediaConsumer<Parent>::m_screenHeight), MakeUintegerChecker<uint32_t>())
       .template AddAttribute("MaxBufferedSeconds", "Maximum amount of buffered seconds allowed", UintegerValue(30),
                     MakeUintegerAccessor(&MultimediaConsumer<Parent>::m_maxBufferedSeconds), MakeUintegerChecker<uint32_t>())
+      .template AddAttribute("PipelineDepth", "Maximum number of segments whose chunks are in flight at the same time; "
+                          "the next segment is selected and requested once all chunks of the current one have been "
+                          "requested (1 = one segment after the other)", UintegerValue(1),
+                    MakeUintegerAccessor(&MultimediaConsumer<Parent>::m_pipelineDepth), MakeUintegerChecker<uint32_t>(1))
       .template AddAttribute("DeviceType", "PC, Laptop, Tablet, Phone, Game Console", StringValue("PC"),
                     MakeStringAccessor(&MultimediaConsumer<Parent>::m_deviceType), MakeStringChecker())
       .template AddAttribute("AllowUpscale", "Define whether or not the client has capabilities to upscale content with lower resolutions", BooleanValue(true),
@@ -88,8 +93,19 @@ MultimediaConsumer<Parent>::GetTypeId(void)
                     MakeBooleanAccessor(&MultimediaConsumer<Parent>::traceNotDownloadedSegments), MakeBooleanChecker())
       .template AddAttribute("StartUpDelay", "Defines the time to wait before trying to start playback", DoubleValue(2.0),
                     MakeDoubleAccessor(&MultimediaConsumer<Parent>::startupDelay), MakeDoubleChecker<double>())
+      .template AddAttribute("SegmentFastMode", "Request segments as single objects whose transfer is modeled "
+                          "from link bandwidth, delay and fair sharing (see ns3::ndn::SegmentTransferModel) "
+                          "instead of chunk by chunk; the MPD and init segments are always downloaded chunk by chunk. "
+                          "Fast-mode transfers do not share link capacity with packet-level traffic "
+                          "(other consumers, cross traffic), so mixed scenarios overestimate throughput",
+                          BooleanValue(false),
+                    MakeBooleanAccessor(&MultimediaConsumer<Parent>::m_segmentFastMode), MakeBooleanChecker())
       .AddTraceSource("PlayerTracer", "Trace Player consumes of multimedia data",
                       MakeTraceSourceAccessor(&MultimediaConsumer<Parent>::m_playerTracer))
+      .AddTraceSource("Throughput", "Content received per second (bits/s), sampled once per second",
+                      MakeTraceSourceAccessor(&MultimediaConsumer<Parent>::m_throughputTrace))
+      .AddTraceSource("Stall", "Start and duration of a playback stall, once it is over",
+                      MakeTraceSourceAccessor(&MultimediaConsumer<Parent>::m_stallTrace))
                     ;
 
   return tid;
@@ -101,6 +117,8 @@ MultimediaConsumer<Parent>::MultimediaConsumer() : super()
   NS_LOG_FUNCTION_NOARGS();
   mpd = NULL;
   mPlayer = NULL;
+  m_segmentTransfer = 0;
+  m_segmentTransferSize = 0;
 }
 
 
@@ -153,6 +171,10 @@ MultimediaConsumer<Parent>::StartApplication() // Called at time specified by St
   totalConsumedSegments = 0;
   requestedRepresentation = NULL;
   requestedSegmentURL = NULL;
+  m_segmentPipeline.clear();
+  m_adaptationLogicExhausted = false;
+  m_segmentTransfer = 0;
+  m_receivedBytes = 0;
 
   m_currentDownloadType = MPD;
   m_startTime = Simulator::Now().GetMilliSeconds();
@@ -169,6 +191,8 @@ MultimediaConsumer<Parent>::StartApplication() // Called at time specified by St
 
   // do base stuff
   super::StartApplication();
+
+  m_throughputEvent = Simulator::Schedule(Seconds(1.0), &MultimediaConsumer<Parent>::ThroughputUpdateEvent, this);
 }
 
 
@@ -185,6 +209,11 @@ MultimediaConsumer<Parent>::StopApplication() // Called at time specified by Sto
   m_downloadEventTimer.Cancel();
   Simulator::Cancel(m_downloadEventTimer);
 
+  Simulator::Cancel(m_bufferRetryEvent);
+  Simulator::Cancel(m_throughputEvent);
+
+  CancelSegmentTransfer();
+
   /*OK LOG ALL NOT RECEIVED FILES FROM MPD*/
   if(traceNotDownloadedSegments)
   {
@@ -495,6 +524,11 @@ MultimediaConsumer<Parent>::OnMultimediaFile()
     }
 
   }
+  else if (IsPipelining())
+  {
+    // the current segment (the latest one in the pipeline) is complete
+    OnSegmentReceived(super::m_interestName, super::lastDownloadBitrate);
+  }
   else
   {
     // normal segment
@@ -548,14 +582,17 @@ MultimediaConsumer<Parent>::OnData(shared_ptr<const Data> data)
 {
   if(requestedSegmentURL == NULL)
   {
+    m_receivedBytes += data->getContent().value_size();
     super::OnData(data);
     return;
   }
 
   std::string interestName = data->getName().toUri();
 
-  if(boost::starts_with(interestName, m_baseURL+(requestedSegmentURL->GetMediaURI())))
+  if(boost::starts_with(interestName, m_baseURL+(requestedSegmentURL->GetMediaURI())) ||
+     super::IsPipelinedFile(data->getName().getPrefix(-1)))
   {
+    m_receivedBytes += data->getContent().value_size();
     super::OnData(data);
   }
   // else
@@ -614,10 +651,15 @@ MultimediaConsumer<Parent>::DownloadSegment()
     return;
   }*/
 
+  if (IsPipelining())
+  {
+    RequestPipelinedSegment();
+    return;
+  }
+
   // get segment number and rep id
   requestedRepresentation = NULL;
   requestedSegmentNr = 0;
-
   requestedSegmentURL = mPlayer->GetAdaptationLogic()->GetNextSegment(&requestedSegmentNr, &requestedRepresentation, &m_hasDownloadedAllSegments);
 
   if(m_hasDownloadedAllSegments) // DONE
@@ -633,11 +675,290 @@ MultimediaConsumer<Parent>::DownloadSegment()
     return;
   }
 
-  super::StopApplication();
-  super::SetAttribute("FileToRequest", StringValue(m_baseURL + requestedSegmentURL->GetMediaURI()));
-  super::SetAttribute("WriteOutfile", StringValue(""));
-  super::SetAttribute("StartWindowSize", StringValue("10"));
-  super::StartApplication();
+  if (m_segmentFastMode)
+  {
+    DownloadSegmentFast(Name(m_baseURL + requestedSegmentURL->GetMediaURI()));
+  }
+  else
+  {
+    super::StopApplication();
+    super::SetAttribute("FileToRequest", StringValue(m_baseURL + requestedSegmentURL->GetMediaURI()));
+    super::SetAttribute("WriteOutfile", StringValue(""));
+    super::SetAttribute("StartWindowSize", StringValue("10"));
+    super::StartApplication();
+  }
+}
+
+
+template<class Parent>
+void
+MultimediaConsumer<Parent>::DownloadSegmentFast(const Name& name)
+{
+  // in case the producer cannot tell the segment size, estimate it from the MPD
+  m_segmentTransferSize = requestedRepresentation->GetBandwidth() / 8.0 * GetSegmentDuration(requestedRepresentation);
+
+  m_segmentTransferName = make_shared<Name>(name);
+  m_segmentTransferStartTime = Simulator::Now().GetMilliSeconds();
+  super::m_downloadStartedTrace(this, m_segmentTransferName);
+
+  RequestSegmentTransfer();
+}
+
+
+template<class Parent>
+void
+MultimediaConsumer<Parent>::RequestSegmentTransfer()
+{
+  NS_LOG_DEBUG("Requesting segment " << *m_segmentTransferName << " from the segment transfer model");
+
+  m_segmentTransfer = SegmentTransferModel::Get()->Request(super::GetNode(), *m_segmentTransferName, m_segmentTransferSize,
+                        MakeCallback(&MultimediaConsumer<Parent>::OnSegmentTransferred, this),
+                        MakeCallback(&MultimediaConsumer<Parent>::OnSegmentTransferFailed, this));
+}
+
+
+template<class Parent>
+void
+MultimediaConsumer<Parent>::OnSegmentTransferred(uint64_t size)
+{
+  m_segmentTransfer = 0;
+
+  // same as FileConsumer, but a segment found in the local cache must not yield an infinite bitrate
+  int64_t downloadTime = std::max<int64_t>(Simulator::Now().GetMilliSeconds() - m_segmentTransferStartTime, 1);
+  super::lastDownloadBitrate = ((double)(size * 8)) / (((double)downloadTime) / 1000.0);
+
+  m_receivedBytes += size;
+
+  NS_LOG_DEBUG("Segment transferred after " << downloadTime << "ms; AvgSpeed = " << super::lastDownloadBitrate << " bits per second.");
+  super::m_downloadFinishedTrace(this, m_segmentTransferName, super::lastDownloadBitrate, downloadTime);
+
+  OnMultimediaFile();
+}
+
+
+template<class Parent>
+void
+MultimediaConsumer<Parent>::OnSegmentTransferFailed()
+{
+  m_segmentTransfer = 0;
+
+  NS_LOG_DEBUG("Transfer of segment " << *m_segmentTransferName << " failed, requesting it again in 1s");
+  m_segmentRetryEvent = Simulator::Schedule(Seconds(1.0), &MultimediaConsumer<Parent>::RequestSegmentTransfer, this);
+}
+
+
+template<class Parent>
+void
+MultimediaConsumer<Parent>::CancelSegmentTransfer()
+{
+  Simulator::Cancel(m_segmentRetryEvent);
+
+  if (m_segmentTransfer == 0)
+    return;
+
+  SegmentTransferModel::Get()->Cancel(m_segmentTransfer);
+  m_segmentTransfer = 0;
+}
+
+
+template<class Parent>
+bool
+MultimediaConsumer<Parent>::IsPipelining() const
+{
+  return m_pipelineDepth > 1 && !m_segmentFastMode;
+}
+
+
+template<class Parent>
+bool
+MultimediaConsumer<Parent>::HasPipelineBudget() const
+{
+  if (m_segmentPipeline.empty())
+    return true;
+
+  unsigned int inFlight = 0;
+  double committedSeconds = mPlayer->GetBufferLevel();
+  for (const PipelinedSegment& segment : m_segmentPipeline)
+  {
+    committedSeconds += GetSegmentDuration(segment.representation);
+    if (!segment.received)
+      inFlight++;
+  }
+
+  if (inFlight >= m_pipelineDepth)
+    return false;
+
+  // assume the next segment is as long as the last selected one
+  return committedSeconds + GetSegmentDuration(m_segmentPipeline.back().representation) <= m_maxBufferedSeconds;
+}
+
+
+template<class Parent>
+void
+MultimediaConsumer<Parent>::RequestPipelinedSegment()
+{
+  // the current segment must be requested completely before the next one is started
+  if (super::m_active && !super::m_finishedDownloadingFile && !super::m_allChunksRequested &&
+      !m_segmentPipeline.empty())
+    return; // OnAllChunksRequested will try again
+
+  if (m_adaptationLogicExhausted)
+  {
+    m_hasDownloadedAllSegments = m_segmentPipeline.empty();
+    return;
+  }
+
+  if (!HasPipelineBudget())
+  {
+    // try again in 1 second (or as soon as a segment has been received)
+    m_downloadEventTimer = Simulator::Schedule(Seconds(1.0), &MultimediaConsumer<Parent>::DownloadSegment, this);
+    return;
+  }
+
+  // the adaptation decision is taken now, with the latest download bitrate
+  PipelinedSegment segment;
+  segment.representation = NULL;
+  segment.segmentNr = 0;
+  segment.received = false;
+  segment.bitrate = 0.0;
+  segment.segmentURL = mPlayer->GetAdaptationLogic()->GetNextSegment(&segment.segmentNr, &segment.representation, &m_adaptationLogicExhausted);
+
+  if (m_adaptationLogicExhausted) // DONE
+  {
+    NS_LOG_DEBUG("No more segments available for download!\n");
+    m_hasDownloadedAllSegments = m_segmentPipeline.empty();
+    return;
+  }
+
+  if (segment.segmentURL == NULL) //IDLE
+  {
+    NS_LOG_DEBUG("IDLE\n");
+    m_downloadEventTimer = Simulator::Schedule(Seconds(1.0), &MultimediaConsumer<Parent>::DownloadSegment, this);
+    return;
+  }
+
+  segment.name = make_shared<Name>(m_baseURL + segment.segmentURL->GetMediaURI());
+  m_segmentPipeline.push_back(segment);
+
+  requestedSegmentURL = segment.segmentURL;
+  requestedRepresentation = segment.representation;
+  requestedSegmentNr = segment.segmentNr;
+
+  NS_LOG_DEBUG("Requesting segment " << segment.segmentNr << " (rep=" << segment.representation->GetId()
+               << "), " << m_segmentPipeline.size() << " segments in the pipeline");
+
+  if (super::m_active && super::m_outFile.empty())
+  {
+    // chunks of the previous segment that are still in flight are completed in the background
+    super::StartNextFile(*segment.name);
+  }
+  else
+  {
+    super::StopApplication();
+    super::SetAttribute("FileToRequest", StringValue(segment.name->toUri()));
+    super::SetAttribute("WriteOutfile", StringValue(""));
+    super::SetAttribute("StartWindowSize", StringValue("10"));
+    super::StartApplication();
+  }
+}
+
+
+template<class Parent>
+void
+MultimediaConsumer<Parent>::OnSegmentReceived(const Name& name, double bitrate)
+{
+  for (PipelinedSegment& segment : m_segmentPipeline)
+  {
+    if (!segment.received && *segment.name == name)
+    {
+      NS_LOG_DEBUG("Segment " << segment.segmentNr << " received");
+      segment.received = true;
+      segment.bitrate = bitrate;
+      break;
+    }
+  }
+
+  mPlayer->SetLastDownloadBitRate(bitrate);
+  AddReceivedSegmentsToBuffer();
+
+  // there is room for the next segment now
+  m_currentDownloadType = Segment;
+  ScheduleDownloadOfSegment();
+}
+
+
+template<class Parent>
+void
+MultimediaConsumer<Parent>::AddReceivedSegmentsToBuffer()
+{
+  while (!m_segmentPipeline.empty() && m_segmentPipeline.front().received)
+  {
+    const PipelinedSegment& segment = m_segmentPipeline.front();
+    if (!mPlayer->EnoughSpaceInBuffer(segment.segmentNr, segment.representation, m_isLayeredContent))
+    {
+      // try again in 1 second, and again and again...
+      if (!m_bufferRetryEvent.IsRunning())
+        m_bufferRetryEvent = Simulator::Schedule(Seconds(1.0), &MultimediaConsumer<Parent>::AddReceivedSegmentsToBuffer, this);
+      return;
+    }
+
+    if(mPlayer->AddToBuffer(segment.segmentNr, segment.representation, segment.bitrate, m_isLayeredContent))
+      NS_LOG_DEBUG("Segment Accepted for Buffering");
+    else
+      NS_LOG_DEBUG("Segment Rejected for Buffering");
+
+    m_segmentPipeline.pop_front();
+  }
+
+  if (m_segmentPipeline.empty() && m_adaptationLogicExhausted)
+    m_hasDownloadedAllSegments = true;
+}
+
+
+template<class Parent>
+void
+MultimediaConsumer<Parent>::OnAllChunksRequested()
+{
+  super::OnAllChunksRequested();
+
+  if (m_mpdParsed && m_currentDownloadType == Segment && IsPipelining())
+    ScheduleDownloadOfSegment();
+}
+
+
+template<class Parent>
+void
+MultimediaConsumer<Parent>::OnPipelinedFileReceived(shared_ptr<const Name> fileName, double downloadSpeed)
+{
+  super::OnPipelinedFileReceived(fileName, downloadSpeed);
+
+  if (mPlayer != NULL)
+    OnSegmentReceived(*fileName, downloadSpeed);
+}
+
+
+template<class Parent>
+void
+MultimediaConsumer<Parent>::ThroughputUpdateEvent()
+{
+  m_throughputTrace(this, m_receivedBytes * 8.0);
+  m_receivedBytes = 0;
+
+  if (!m_hasDownloadedAllSegments)
+    m_throughputEvent = Simulator::Schedule(Seconds(1.0), &MultimediaConsumer<Parent>::ThroughputUpdateEvent, this);
+}
+
+
+template<class Parent>
+double
+MultimediaConsumer<Parent>::GetSegmentDuration(const IRepresentation* representation)
+{
+  dash::mpd::ISegmentList* segmentList = representation->GetSegmentList();
+  if (segmentList == NULL)
+    return 0.0;
+
+  uint32_t timescale = segmentList->GetTimescale();
+  return (double)segmentList->GetDuration() / (timescale > 0 ? timescale : 1);
 }
 
 
@@ -682,7 +1003,19 @@ MultimediaConsumer<Parent>::DoPlay()
       {
         //abort download ...
         NS_LOG_DEBUG("Aborting to download a segment with repId = " << requestedRepresentation->GetId().c_str());
-        super::StopApplication();
+        if (m_segmentFastMode)
+          CancelSegmentTransfer();
+        else
+          super::StopApplication();
+
+        if (IsPipelining())
+        {
+          // segments in flight are dropped (StopApplication abandoned their chunks)
+          m_segmentPipeline.erase(std::remove_if(m_segmentPipeline.begin(), m_segmentPipeline.end(),
+                                                 [] (const PipelinedSegment& segment) { return !segment.received; }),
+                                  m_segmentPipeline.end());
+          AddReceivedSegmentsToBuffer();
+        }
         mPlayer->SetLastDownloadBitRate(0.0);//set dl_bitrate to zero.
         ScheduleDownloadOfSegment();
       }
@@ -722,6 +1055,7 @@ MultimediaConsumer<Parent>::consume()
       // we had a freeze/stall, but we can continue playing now
       // measure:
       freezeTime = (Simulator::Now().GetMilliSeconds() - m_freezeStartTime);
+      m_stallTrace(this, MilliSeconds(m_freezeStartTime), MilliSeconds(freezeTime));
       m_freezeStartTime = 0;
       NS_LOG_DEBUG("Freeze Of " << freezeTime << " milliseconds is over!");
     }
@@ -56,6 +56,9 @@
 #include <boost/random/random_device.hpp>
 #include <boost/random/uniform_int_distribution.hpp>
 
+#include <algorithm>
+#include <deque>
+
 #define MULTIMEDIA_CONSUMER_LOOP_TIMER 0.1
 #define MIN_BUFFER_LEVEL 4.0
 
@@ -106,6 +109,7 @@ protected:
   bool m_allowUpscale;        ///< \brief Whether or not it is possible to upscale content with lower resolutions to the screen width/height
   bool m_allowDownscale;      ///< \brief Whether or not it is possible to downscale content with higher resolutions to the screen width/height
   unsigned int m_maxBufferedSeconds; ///< \brief The maximum amount of buffered seconds
+  unsigned int m_pipelineDepth; ///< \brief The maximum number of segments whose chunks are in flight at the same time
   double startupDelay;
 
   std::string m_startRepresentationId;  ///< \brief The representation ID for initializing streaming
@@ -145,6 +149,32 @@ protected:
   const dash::mpd::IRepresentation* requestedRepresentation;
   unsigned int requestedSegmentNr;
 
+  /**
+   * \brief A segment that has been requested while others are still in flight (PipelineDepth > 1)
+   */
+  struct PipelinedSegment {
+    dash::mpd::ISegmentURL* segmentURL;
+    const dash::mpd::IRepresentation* representation;
+    unsigned int segmentNr;
+    shared_ptr<Name> name;
+    bool received;
+    double bitrate; ///< \brief download bitrate, once received
+  };
+
+  std::deque<PipelinedSegment> m_segmentPipeline; ///< \brief requested segments not in the buffer yet, in download order
+  bool m_adaptationLogicExhausted; ///< \brief adaptation logic has no more segments, but pipeline might
+  EventId m_bufferRetryEvent;
+
+  uint64_t m_receivedBytes; ///< \brief content bytes received since the last throughput sample
+  EventId m_throughputEvent;
+
+  bool m_segmentFastMode; ///< \brief request segments as single objects from the SegmentTransferModel
+  uint64_t m_segmentTransfer; ///< \brief handle of the segment transfer in fast mode (0 = none)
+  int64_t m_segmentTransferStartTime;
+  shared_ptr<Name> m_segmentTransferName;
+  uint64_t m_segmentTransferSize; ///< \brief size to request, if the producer cannot tell
+  EventId m_segmentRetryEvent; ///< \brief request again after a failed transfer
+
 
   void SchedulePlay(double wait_time = MULTIMEDIA_CONSUMER_LOOP_TIMER);
   void DoPlay();
@@ -177,10 +207,76 @@ protected:
   virtual void
   DownloadSegment();
 
+  /**
+   * \brief Request the segment as a single object from the SegmentTransferModel (fast mode)
+   */
+  void
+  DownloadSegmentFast(const Name& name);
+
+  /**
+   * \brief Request the segment of the current fast-mode download from the SegmentTransferModel
+   */
+  void
+  RequestSegmentTransfer();
+
+  void
+  OnSegmentTransferred(uint64_t size);
+
+  /**
+   * \brief Request the segment again after one second, like Interests that are not answered
+   */
+  void
+  OnSegmentTransferFailed();
+
+  void
+  CancelSegmentTransfer();
+
+  bool
+  IsPipelining() const;
+
+  /**
+   * \brief Select the next segment and request it, while earlier segments are still in flight
+   *
+   * The adaptation logic is asked when the segment is requested, i.e., once all chunks of the
+   * previous segment have been requested, as long as fewer than PipelineDepth segments are in
+   * flight and the buffer level plus the duration of all segments in the pipeline stays within
+   * MaxBufferedSeconds
+   */
+  void
+  RequestPipelinedSegment();
+
+  bool
+  HasPipelineBudget() const;
+
+  void
+  OnSegmentReceived(const Name& name, double bitrate);
+
+  /**
+   * \brief Add received segments to the buffer, in the order in which they were requested
+   */
+  void
+  AddReceivedSegmentsToBuffer();
+
+  virtual void
+  OnAllChunksRequested();
+
+  virtual void
+  OnPipelinedFileReceived(shared_ptr<const Name> fileName, double downloadSpeed);
+
+  void
+  ThroughputUpdateEvent();
+
+  static double
+  GetSegmentDuration(const dash::mpd::IRepresentation* representation);
+
   TracedCallback<Ptr<ns3::ndn::App> /*App*/, unsigned int /*SegmentNr*/, 
                 std::string /*RepresentationId*/, unsigned int /* experiendedBitrate */,
                 unsigned int /*StallingTime*/, unsigned int /* buffer level */, std::vector<std::string> /*DependencyIds*/> m_playerTracer;
 
+  TracedCallback<Ptr<ns3::ndn::App> /*App*/, double /* bits per second */> m_throughputTrace;
+
+  TracedCallback<Ptr<ns3::ndn::App> /*App*/, Time /*StallStart*/, Time /*StallDuration*/> m_stallTrace;
+
 };
 
 } // namespace ndn
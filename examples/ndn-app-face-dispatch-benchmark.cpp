@@ -0,0 +1,116 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-app-face-dispatch-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/point-to-point-layout-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <chrono>
+
+namespace ns3 {
+
+/**
+ * This scenario runs the ndn-grid scenario (scaled up: --grid nodes per side, a consumer on
+ * every node of the first row and a producer on every node of the last row) and reports the
+ * number of simulation events and the wall-clock time, with either the default AppFace delivery
+ * (one event per packet towards an application) or direct dispatch
+ * (L3Protocol::DirectAppFaceDispatch):
+ *
+ *     ./waf --run="ndn-app-face-dispatch-benchmark"
+ *     ./waf --run="ndn-app-face-dispatch-benchmark --direct=1"
+ */
+
+int
+main(int argc, char* argv[])
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("10"));
+
+  bool direct = false;
+  uint32_t gridSize = 3;
+  std::string frequency = "100";
+  double duration = 20.0;
+
+  CommandLine cmd;
+  cmd.AddValue("direct", "Deliver packets to applications through the per-node dispatcher", direct);
+  cmd.AddValue("grid", "Size of the grid (number of nodes per side)", gridSize);
+  cmd.AddValue("frequency", "Interests per second of each consumer", frequency);
+  cmd.AddValue("duration", "Simulation time (in seconds)", duration);
+  cmd.Parse(argc, argv);
+
+  Config::SetDefault("ns3::ndn::L3Protocol::DirectAppFaceDispatch", BooleanValue(direct));
+
+  PointToPointHelper p2p;
+  PointToPointGridHelper grid(gridSize, gridSize, p2p);
+  grid.BoundingBox(100, 100, 200, 200);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  ndn::StrategyChoiceHelper::InstallAll("/", "/localhost/nfd/strategy/best-route");
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  for (uint32_t i = 0; i < gridSize; i++) {
+    std::string prefix = "/prefix/" + std::to_string(i);
+
+    ndn::AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+    consumerHelper.SetPrefix(prefix);
+    consumerHelper.SetAttribute("Frequency", StringValue(frequency));
+    consumerHelper.Install(grid.GetNode(0, i));
+
+    ndn::AppHelper producerHelper("ns3::ndn::Producer");
+    producerHelper.SetPrefix(prefix);
+    producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+    producerHelper.Install(grid.GetNode(gridSize - 1, gridSize - 1 - i));
+
+    ndnGlobalRoutingHelper.AddOrigins(prefix, grid.GetNode(gridSize - 1, gridSize - 1 - i));
+  }
+
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+
+  Simulator::Stop(Seconds(duration));
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  Simulator::Run();
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  std::cout << "Direct AppFace dispatch: " << (direct ? "on" : "off") << std::endl;
+  std::cout << "Events: " << Simulator::GetEventCount() << std::endl;
+  std::cout << "Wall-clock time: " << elapsed.count() << " s" << std::endl;
+
+  Simulator::Destroy();
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
@@ -0,0 +1,172 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-congestion-control-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <map>
+
+namespace ns3 {
+
+/**
+ * This scenario measures bottleneck utilization and Jain's fairness index of competing
+ * window-based consumers (ndn::ConsumerWindow) with the selected congestion controller:
+ *
+ *     consumer0 ---\                           /--- producer
+ *     consumer1 ----+-- router0 ===== router1 -+
+ *     ...       ---/     (bottleneck)
+ *
+ * Every consumer requests its own prefix, so there are no cache hits between flows.  With
+ * --rttSpread, the access link of consumer i gets i * rttSpread additional delay, which shows
+ * how fair the controller is to flows with different RTTs.
+ *
+ *     ./waf --run="ndn-congestion-control-benchmark --cc=ns3::ndn::CongestionControlCubic"
+ *     ./waf --run="ndn-congestion-control-benchmark --cc=ns3::ndn::CongestionControlAimd
+ *                  --flows=8 --rttSpread=10ms"
+ *
+ * An empty --cc runs the built-in window scheme of ConsumerWindow.
+ */
+
+static std::map<Ptr<ndn::App>, uint64_t> g_receivedBytes;
+
+static void
+ReceivedData(shared_ptr<const ndn::Data> data, Ptr<ndn::App> app, shared_ptr<ndn::Face> face)
+{
+  g_receivedBytes[app] += data->getContent().value_size();
+}
+
+static void
+ResetCounters()
+{
+  for (auto& flow : g_receivedBytes) {
+    flow.second = 0;
+  }
+}
+
+int
+main(int argc, char* argv[])
+{
+  std::string congestionControl = "ns3::ndn::CongestionControlAimd";
+  uint32_t flows = 4;
+  std::string bottleneckRate = "10Mbps";
+  std::string bottleneckDelay = "10ms";
+  std::string rttSpread = "0ms";
+  uint32_t queueSize = 100;
+  double duration = 60.0;
+  double warmup = 10.0;
+
+  CommandLine cmd;
+  cmd.AddValue("cc", "TypeId of the congestion controller (empty for the built-in scheme)",
+               congestionControl);
+  cmd.AddValue("flows", "Number of consumers", flows);
+  cmd.AddValue("rate", "Data rate of the bottleneck link", bottleneckRate);
+  cmd.AddValue("delay", "Delay of the bottleneck link", bottleneckDelay);
+  cmd.AddValue("rttSpread", "Additional access link delay per consumer index", rttSpread);
+  cmd.AddValue("queue", "Queue size of the bottleneck (in packets)", queueSize);
+  cmd.AddValue("duration", "Simulation time (in seconds)", duration);
+  cmd.AddValue("warmup", "Time (in seconds) excluded from the measurement", warmup);
+  cmd.Parse(argc, argv);
+
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", UintegerValue(queueSize));
+
+  NodeContainer consumers;
+  consumers.Create(flows);
+  NodeContainer routers;
+  routers.Create(2);
+  Ptr<Node> producer = CreateObject<Node>();
+
+  PointToPointHelper bottleneck;
+  bottleneck.SetDeviceAttribute("DataRate", StringValue(bottleneckRate));
+  bottleneck.SetChannelAttribute("Delay", StringValue(bottleneckDelay));
+  bottleneck.Install(routers.Get(0), routers.Get(1));
+
+  PointToPointHelper access;
+  access.SetDeviceAttribute("DataRate", StringValue("1Gbps"));
+  access.SetChannelAttribute("Delay", StringValue("1ms"));
+  access.Install(routers.Get(1), producer);
+  for (uint32_t i = 0; i < flows; i++) {
+    access.SetChannelAttribute("Delay", TimeValue(MilliSeconds(1) + Time(rttSpread) * i));
+    access.Install(consumers.Get(i), routers.Get(0));
+  }
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  ndn::StrategyChoiceHelper::InstallAll("/", "/localhost/nfd/strategy/best-route");
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  ndn::AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix("/flow");
+  producerHelper.SetAttribute("PayloadSize", UintegerValue(1024));
+  producerHelper.Install(producer);
+  ndnGlobalRoutingHelper.AddOrigins("/flow", producer);
+
+  ndn::AppHelper consumerHelper("ns3::ndn::ConsumerWindow");
+  consumerHelper.SetAttribute("CongestionControl", StringValue(congestionControl));
+  consumerHelper.SetAttribute("PayloadSize", UintegerValue(1024));
+  for (uint32_t i = 0; i < flows; i++) {
+    consumerHelper.SetPrefix("/flow/" + std::to_string(i));
+    consumerHelper.Install(consumers.Get(i));
+  }
+
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+
+  Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/ReceivedDatas",
+                                MakeCallback(&ReceivedData));
+
+  // exclude the warmup period from the measurement
+  Simulator::Schedule(Seconds(warmup), &ResetCounters);
+
+  Simulator::Stop(Seconds(duration));
+  Simulator::Run();
+
+  double sum = 0;
+  double sumOfSquares = 0;
+  for (const auto& flow : g_receivedBytes) {
+    double rate = flow.second * 8.0 / (duration - warmup);
+    std::cout << "Node " << flow.first->GetNode()->GetId() << ": " << rate / 1e6 << " Mbps"
+              << std::endl;
+    sum += rate;
+    sumOfSquares += rate * rate;
+  }
+
+  double capacity = DataRate(bottleneckRate).GetBitRate();
+  std::cout << "Utilization: " << sum / capacity << " (payload only)" << std::endl;
+  std::cout << "Jain fairness: " << (sumOfSquares > 0 ? sum * sum / (flows * sumOfSquares) : 0)
+            << std::endl;
+
+  Simulator::Destroy();
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
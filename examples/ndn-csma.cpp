@@ -58,7 +58,10 @@ main(int argc, char* argv[])
   Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
 
   // Read optional command-line parameters (e.g., enable visualizer with ./waf --run=<> --visualize
+  bool unicast = false;
+
   CommandLine cmd;
+  cmd.AddValue("unicast", "Send Interests over unicast adjacency instead of broadcast", unicast);
   cmd.Parse(argc, argv);
 
   // Creating nodes
@@ -72,8 +75,14 @@ main(int argc, char* argv[])
   // Install NDN stack on all nodes
   ndn::StackHelper ndnHelper;
   ndnHelper.SetDefaultRoutes(true);
+  ndnHelper.SetUnicastAdjacencies(unicast);
   ndnHelper.InstallAll();
 
+  if (unicast) {
+    // node 1 no longer sees the traffic between the consumer and the producer
+    ndn::FibHelper::AddRoute(nodes.Get(0), "/prefix", nodes.Get(2), 1);
+  }
+
   // Installing applications
 
   // Consumer
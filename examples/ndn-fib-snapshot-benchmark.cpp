@@ -0,0 +1,189 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-fib-snapshot-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/point-to-point-layout-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/utils/mem-usage.hpp"
+#include "ns3/ndnSIM/utils/topology/rocketfuel-map-reader.hpp"
+
+#include <chrono>
+
+namespace ns3 {
+
+/**
+ * This scenario compares memory footprint and lookup latency of NFD FIB and frozen FIB
+ * snapshots (ndn::FibSnapshot).  Every node originates `--prefixes` prefixes, routes are
+ * calculated with GlobalRoutingHelper, and then every node's FIB is frozen.  Snapshots are
+ * kept in addition to the NFD FIB (the forwarder does not use them), so their memory adds up.
+ *
+ * The topology is either a grid or read from a file: Rocketfuel maps (.cch) are read with
+ * RocketfuelMapReader, other files with AnnotatedTopologyReader.
+ *
+ *     ./waf --run="ndn-fib-snapshot-benchmark --grid=20"
+ *     ./waf --run="ndn-fib-snapshot-benchmark --topology=maps/1239.cch --lookups=100000"
+ */
+
+static NodeContainer
+ReadTopology(const std::string& file)
+{
+  if (file.size() > 4 && file.substr(file.size() - 4) == ".cch") {
+    RocketfuelParams params;
+    params.averageRtt = 0.25;
+    params.clientNodeDegrees = 2;
+    params.minb2bBandwidth = "40Mbps";
+    params.minb2bDelay = "5ms";
+    params.maxb2bBandwidth = "100Mbps";
+    params.maxb2bDelay = "10ms";
+    params.minb2gBandwidth = "10Mbps";
+    params.minb2gDelay = "5ms";
+    params.maxb2gBandwidth = "20Mbps";
+    params.maxb2gDelay = "10ms";
+    params.ming2cBandwidth = "1Mbps";
+    params.ming2cDelay = "70ms";
+    params.maxg2cBandwidth = "3Mbps";
+    params.maxg2cDelay = "10ms";
+
+    static RocketfuelMapReader reader("/rocketfuel", 1.0);
+    reader.SetFileName(file);
+    return reader.Read(params, true, true);
+  }
+  else {
+    static AnnotatedTopologyReader reader("");
+    reader.SetFileName(file);
+    return reader.Read();
+  }
+}
+
+int
+main(int argc, char* argv[])
+{
+  std::string topology;
+  uint32_t gridSize = 20;
+  uint32_t prefixesPerNode = 1;
+  uint32_t lookups = 10000;
+
+  CommandLine cmd;
+  cmd.AddValue("topology", "Topology file (.cch for Rocketfuel maps), grid is used if empty",
+               topology);
+  cmd.AddValue("grid", "Size of the grid (number of nodes per side)", gridSize);
+  cmd.AddValue("prefixes", "Number of prefixes originated by each node", prefixesPerNode);
+  cmd.AddValue("lookups", "Number of FIB lookups per node", lookups);
+  cmd.Parse(argc, argv);
+
+  NodeContainer nodes;
+  if (topology.empty()) {
+    PointToPointHelper p2p;
+    PointToPointGridHelper grid(gridSize, gridSize, p2p);
+    grid.BoundingBox(100, 100, 200, 200);
+    nodes = NodeContainer::GetGlobal();
+  }
+  else {
+    nodes = ReadTopology(topology);
+  }
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.Install(nodes);
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.Install(nodes);
+
+  std::vector<Name> prefixes;
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    for (uint32_t i = 0; i < prefixesPerNode; i++) {
+      Name prefix("/node" + std::to_string((*node)->GetId()));
+      prefix.appendNumber(i);
+      ndnGlobalRoutingHelper.AddOrigin(prefix.toUri(), *node);
+      prefixes.push_back(prefix);
+    }
+  }
+
+  int64_t memBefore = MemUsage::Get();
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+  int64_t memFib = MemUsage::Get() - memBefore;
+
+  memBefore = MemUsage::Get();
+  ndn::FibHelper::Freeze(nodes);
+
+  size_t snapshotBytes = 0;
+  std::vector<shared_ptr<const ndn::FibSnapshot>> snapshots;
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    snapshots.push_back((*node)->GetObject<ndn::L3Protocol>()->getFibSnapshot());
+    snapshotBytes += snapshots.back()->getMemoryUsage();
+  }
+  int64_t memSnapshots = MemUsage::Get() - memBefore;
+
+  // names under random origin prefixes, with a few extra components
+  Ptr<UniformRandomVariable> rand = CreateObject<UniformRandomVariable>();
+  std::vector<Name> names;
+  for (uint32_t i = 0; i < lookups; i++) {
+    Name name(prefixes[rand->GetInteger(0, prefixes.size() - 1)]);
+    name.append("segment").appendSegment(i);
+    names.push_back(name);
+  }
+
+  typedef std::chrono::steady_clock Clock;
+  size_t matches = 0;
+
+  Clock::time_point start = Clock::now();
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    const nfd::Fib& fib = (*node)->GetObject<ndn::L3Protocol>()->getForwarder()->getFib();
+    for (const Name& name : names) {
+      matches += fib.findLongestPrefixMatch(name)->hasNextHops();
+    }
+  }
+  Clock::duration fibTime = Clock::now() - start;
+
+  start = Clock::now();
+  for (const auto& snapshot : snapshots) {
+    for (const Name& name : names) {
+      matches += snapshot->findLongestPrefixMatch(name) != nullptr;
+    }
+  }
+  Clock::duration snapshotTime = Clock::now() - start;
+
+  double nLookups = 1.0 * nodes.GetN() * names.size();
+  std::cout << "Nodes: " << nodes.GetN() << ", FIB entries: " << snapshots.front()->size()
+            << " per node, matches: " << matches << std::endl;
+  std::cout << "NFD FIB:       " << memFib / 1024 << " KiB (RSS growth), "
+            << std::chrono::duration<double, std::nano>(fibTime).count() / nLookups
+            << " ns/lookup" << std::endl;
+  std::cout << "FIB snapshots: " << snapshotBytes / 1024 << " KiB (" << memSnapshots / 1024
+            << " KiB RSS growth), "
+            << std::chrono::duration<double, std::nano>(snapshotTime).count() / nLookups
+            << " ns/lookup" << std::endl;
+
+  Simulator::Destroy();
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
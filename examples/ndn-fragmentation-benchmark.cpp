@@ -0,0 +1,124 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-fragmentation-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <chrono>
+
+namespace ns3 {
+
+/**
+ * This scenario transfers the same amount of data (--bytes, 4 MB by default) over a chain of
+ * four nodes using Data packets of --payload bytes, and reports the number of Data packets,
+ * simulation events and the wall-clock time.  Payloads larger than the MTU are carried in
+ * NDNLP fragments (L3Protocol::Fragmentation):
+ *
+ *     +----------+     10Mbps     +--------+     10Mbps     +--------+     10Mbps     +----------+
+ *     | consumer | <------------> | router | <------------> | router | <------------> | producer |
+ *     +----------+      10ms      +--------+      10ms      +--------+      10ms      +----------+
+ *
+ *     ./waf --run="ndn-fragmentation-benchmark --payload=1400"
+ *     ./waf --run="ndn-fragmentation-benchmark --payload=16384"
+ *     ./waf --run="ndn-fragmentation-benchmark --payload=65000"
+ */
+
+int
+main(int argc, char* argv[])
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  // queues must hold all fragments of several Data packets
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("500"));
+
+  uint32_t payload = 16384;
+  uint32_t bytes = 4 * 1024 * 1024;
+  double duration = 30.0;
+
+  CommandLine cmd;
+  cmd.AddValue("payload", "Payload size of Data packets", payload);
+  cmd.AddValue("bytes", "Amount of data to transfer", bytes);
+  cmd.AddValue("duration", "Simulation time (in seconds)", duration);
+  cmd.Parse(argc, argv);
+
+  Config::SetDefault("ns3::ndn::L3Protocol::Fragmentation", BooleanValue(true));
+
+  NodeContainer nodes;
+  nodes.Create(4);
+
+  PointToPointHelper p2p;
+  p2p.Install(nodes.Get(0), nodes.Get(1));
+  p2p.Install(nodes.Get(1), nodes.Get(2));
+  p2p.Install(nodes.Get(2), nodes.Get(3));
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  ndn::StrategyChoiceHelper::InstallAll("/", "/localhost/nfd/strategy/best-route");
+
+  ndn::FibHelper::AddRoute(nodes.Get(0), "/prefix", nodes.Get(1), 1);
+  ndn::FibHelper::AddRoute(nodes.Get(1), "/prefix", nodes.Get(2), 1);
+  ndn::FibHelper::AddRoute(nodes.Get(2), "/prefix", nodes.Get(3), 1);
+
+  uint32_t nData = (bytes + payload - 1) / payload;
+
+  ndn::AppHelper consumerHelper("ns3::ndn::ConsumerWindow");
+  consumerHelper.SetPrefix("/prefix");
+  consumerHelper.SetAttribute("Window", StringValue("4"));
+  consumerHelper.SetAttribute("MaxSeq", StringValue(std::to_string(nData)));
+  consumerHelper.Install(nodes.Get(0));
+
+  ndn::AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix("/prefix");
+  producerHelper.SetAttribute("PayloadSize", UintegerValue(payload));
+  producerHelper.Install(nodes.Get(3));
+
+  Simulator::Stop(Seconds(duration));
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  Simulator::Run();
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  shared_ptr<ndn::Face> face =
+    nodes.Get(0)->GetObject<ndn::L3Protocol>()->getFaceByNetDevice(nodes.Get(0)->GetDevice(0));
+
+  std::cout << "Payload: " << payload << " bytes, MTU: " << nodes.Get(0)->GetDevice(0)->GetMtu()
+            << " bytes" << std::endl;
+  std::cout << "Data packets: " << face->getFaceStatus().getNInDatas() << " of " << nData
+            << std::endl;
+  std::cout << "Events: " << Simulator::GetEventCount() << std::endl;
+  std::cout << "Wall-clock time: " << elapsed.count() << " s" << std::endl;
+
+  Simulator::Destroy();
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
@@ -0,0 +1,123 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+// ndn-l3-rate-tracer-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/point-to-point-layout-module.h"
+#include "ns3/ndnSIM-module.h"
+
+namespace ns3 {
+
+/**
+ * This scenario measures the overhead of L3RateTracer on packet processing.  The same grid
+ * scenario is run with and without the tracer, and wall clock time of Simulator::Run is reported.
+ *
+ * Every node of the first row of the grid runs a consumer, requesting data from the producer in
+ * the opposite corner of the grid.
+ *
+ *     ./waf --run="ndn-l3-rate-tracer-benchmark --tracer=0"
+ *     ./waf --run="ndn-l3-rate-tracer-benchmark --tracer=1"
+ */
+
+int
+main(int argc, char* argv[])
+{
+  uint32_t gridSize = 10;
+  uint32_t frequency = 1000;
+  double stopTime = 20.0;
+  bool tracer = true;
+
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("1Gbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("1ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("100"));
+
+  CommandLine cmd;
+  cmd.AddValue("grid", "Size of the grid (number of nodes per side)", gridSize);
+  cmd.AddValue("frequency", "Interests per second sent by each consumer", frequency);
+  cmd.AddValue("stop", "Simulation time in seconds", stopTime);
+  cmd.AddValue("tracer", "Enable L3RateTracer", tracer);
+  cmd.Parse(argc, argv);
+
+  PointToPointHelper p2p;
+  PointToPointGridHelper grid(gridSize, gridSize, p2p);
+  grid.BoundingBox(100, 100, 200, 200);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  ndn::StrategyChoiceHelper::InstallAll("/", "/localhost/nfd/strategy/best-route");
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  Ptr<Node> producer = grid.GetNode(gridSize - 1, gridSize - 1);
+  NodeContainer consumerNodes;
+  for (uint32_t col = 0; col < gridSize - 1; col++) {
+    consumerNodes.Add(grid.GetNode(0, col));
+  }
+
+  std::string prefix = "/prefix";
+
+  ndn::AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix(prefix);
+  consumerHelper.SetAttribute("Frequency", DoubleValue(frequency));
+  consumerHelper.Install(consumerNodes);
+
+  ndn::AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix(prefix);
+  producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+  producerHelper.Install(producer);
+
+  ndnGlobalRoutingHelper.AddOrigins(prefix, producer);
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+
+  if (tracer) {
+    ndn::L3RateTracer::InstallAll("/dev/null", Seconds(0.5));
+  }
+
+  Simulator::Stop(Seconds(stopTime));
+
+  SystemWallClockMs clock;
+  clock.Start();
+
+  Simulator::Run();
+
+  int64_t elapsed = clock.End();
+
+  std::cout << "L3RateTracer " << (tracer ? "enabled" : "disabled") << ": " << elapsed << " ms"
+            << std::endl;
+
+  ndn::L3RateTracer::Destroy();
+  Simulator::Destroy();
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
@@ -0,0 +1,142 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-multimedia-fast-mode-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <chrono>
+
+namespace ns3 {
+
+/**
+ * This scenario streams the same video to --clients DASH clients behind a shared bottleneck
+ * and reports the number of simulation events and the wall-clock time.  With --fast, every
+ * segment is requested as a single object from the SegmentTransferModel instead of chunk by
+ * chunk (MultimediaConsumer::SegmentFastMode).  Compare the PlayerTracer output of both runs
+ * to validate the fast mode for a given scenario:
+ *
+ *     +---------+     100Mbps     +--------+     20Mbps     +--------+
+ *     | clients | <-------------> | router | <------------> | server |
+ *     +---------+       5ms       +--------+      20ms      +--------+
+ *
+ *     ./waf --run="ndn-multimedia-fast-mode-benchmark --trace=packet-level.txt"
+ *     ./waf --run="ndn-multimedia-fast-mode-benchmark --fast --trace=fast-mode.txt"
+ */
+
+int
+main(int argc, char* argv[])
+{
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("100"));
+
+  uint32_t nClients = 10;
+  bool fast = false;
+  double duration = 120.0;
+  std::string trace = "dash-trace.txt";
+
+  CommandLine cmd;
+  cmd.AddValue("clients", "Number of DASH clients", nClients);
+  cmd.AddValue("fast", "Request whole segments from the segment transfer model", fast);
+  cmd.AddValue("duration", "Simulation time (in seconds)", duration);
+  cmd.AddValue("trace", "Output file of the DASH player tracer", trace);
+  cmd.Parse(argc, argv);
+
+  // the object-level caches do not know about the Content Store of the nodes
+  Config::SetDefault("ns3::ndn::SegmentTransferModel::CacheSize", UintegerValue(100 * 1024 * 1024));
+
+  NodeContainer clients;
+  clients.Create(nClients);
+  Ptr<Node> router = CreateObject<Node>();
+  Ptr<Node> server = CreateObject<Node>();
+
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute("DataRate", StringValue("100Mbps"));
+  p2p.SetChannelAttribute("Delay", StringValue("5ms"));
+  for (uint32_t i = 0; i < nClients; i++) {
+    p2p.Install(clients.Get(i), router);
+  }
+
+  p2p.SetDeviceAttribute("DataRate", StringValue("20Mbps"));
+  p2p.SetChannelAttribute("Delay", StringValue("20ms"));
+  p2p.Install(router, server);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.setCsSize(10000);
+  ndnHelper.InstallAll();
+
+  ndn::StrategyChoiceHelper::InstallAll("/myprefix", "/localhost/nfd/strategy/best-route");
+
+  ndn::AppHelper consumerHelper("ns3::ndn::FileConsumerCbr::MultimediaConsumer");
+  consumerHelper.SetAttribute("AllowUpscale", BooleanValue(true));
+  consumerHelper.SetAttribute("AllowDownscale", BooleanValue(false));
+  consumerHelper.SetAttribute("ScreenWidth", UintegerValue(1920));
+  consumerHelper.SetAttribute("ScreenHeight", UintegerValue(1080));
+  consumerHelper.SetAttribute("StartRepresentationId", StringValue("auto"));
+  consumerHelper.SetAttribute("MaxBufferedSeconds", UintegerValue(30));
+  consumerHelper.SetAttribute("StartUpDelay", StringValue("0.1"));
+  consumerHelper.SetAttribute("AdaptationLogic", StringValue("dash::player::RateAndBufferBasedAdaptationLogic"));
+  consumerHelper.SetAttribute("MpdFileToRequest", StringValue("/myprefix/FakeVid1/vid1.mpd"));
+  consumerHelper.SetAttribute("SegmentFastMode", BooleanValue(fast));
+
+  for (uint32_t i = 0; i < nClients; i++) {
+    ApplicationContainer app = consumerHelper.Install(clients.Get(i));
+    // desynchronize the clients
+    app.Start(Seconds(0.5 * i));
+  }
+
+  ndn::AppHelper fakeDASHProducerHelper("ns3::ndn::FakeMultimediaServer");
+  fakeDASHProducerHelper.SetPrefix("/myprefix/FakeVid1");
+  fakeDASHProducerHelper.SetAttribute("MetaDataFile", StringValue("representations/netflix_vid1.csv"));
+  fakeDASHProducerHelper.SetAttribute("MPDFileName", StringValue("vid1.mpd"));
+  fakeDASHProducerHelper.Install(server);
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+  ndnGlobalRoutingHelper.AddOrigins("/myprefix", server);
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+
+  ndn::DASHPlayerTracer::InstallAll(trace);
+
+  Simulator::Stop(Seconds(duration));
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  Simulator::Run();
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  std::cout << (fast ? "Segment fast mode" : "Packet level") << ", " << nClients << " clients"
+            << std::endl;
+  std::cout << "Events: " << Simulator::GetEventCount() << std::endl;
+  std::cout << "Wall-clock time: " << elapsed.count() << " s" << std::endl;
+
+  Simulator::Destroy();
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
@@ -23,10 +23,27 @@
 #include "ns3/point-to-point-module.h"
 #include "ns3/ndnSIM-module.h"
 #include "ns3/ndnSIM/apps/ndn-app.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-fileconsumer-tracer.hpp"
+
+#include <fstream>
 
 
 namespace ns3 {
 
+static void
+ThroughputTrace(std::ostream* os, Ptr<ndn::App> app, double bitsPerSecond)
+{
+  *os << Simulator::Now().ToDouble(Time::S) << "\t" << app->GetNode()->GetId() << "\t"
+      << bitsPerSecond << std::endl;
+}
+
+static void
+StallTrace(std::ostream* os, Ptr<ndn::App> app, Time start, Time duration)
+{
+  *os << start.ToDouble(Time::S) << "\t" << app->GetNode()->GetId() << "\t"
+      << duration.ToDouble(Time::S) << std::endl;
+}
+
 int
 main(int argc, char* argv[])
 {
@@ -36,7 +53,12 @@ main(int argc, char* argv[])
   Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
 
   // Read optional command-line parameters (e.g., enable visualizer with ./waf --run=<> --visualize
+  // --pipelineDepth=N keeps the chunks of up to N segments in flight, compare
+  // throughput-trace.txt and stall-trace.txt of different runs
+  uint32_t pipelineDepth = 1;
+
   CommandLine cmd;
+  cmd.AddValue("pipelineDepth", "Maximum number of segments in flight", pipelineDepth);
   cmd.Parse(argc, argv);
 
   // Creating nodes
@@ -67,6 +89,7 @@ main(int argc, char* argv[])
   consumerHelper.SetAttribute("StartRepresentationId", StringValue("auto"));
   consumerHelper.SetAttribute("MaxBufferedSeconds", UintegerValue(30));
   consumerHelper.SetAttribute("StartUpDelay", StringValue("0.1"));
+  consumerHelper.SetAttribute("PipelineDepth", UintegerValue(pipelineDepth));
 
   consumerHelper.SetAttribute("AdaptationLogic", StringValue("dash::player::RateAndBufferBasedAdaptationLogic"));
   consumerHelper.SetAttribute("MpdFileToRequest", StringValue(std::string("/myprefix/AVC/BBB-2s.mpd" )));
@@ -98,8 +121,18 @@ main(int argc, char* argv[])
   Simulator::Stop(Seconds(1200.0));
 
   ndn::DASHPlayerTracer::InstallAll("dash-output.txt");
+  ndn::FileConsumerTracer::InstallAll("file-consumer-trace.txt");
   ndn::CsTracer::InstallAll("cs-trace.txt", Seconds(1));
 
+  std::ofstream throughputFile("throughput-trace.txt");
+  throughputFile << "Time\tNode\tBitsPerSecond" << std::endl;
+  app1.Get(0)->TraceConnectWithoutContext("Throughput",
+                                          MakeBoundCallback(&ThroughputTrace, &throughputFile));
+
+  std::ofstream stallFile("stall-trace.txt");
+  stallFile << "Time\tNode\tDuration" << std::endl;
+  app1.Get(0)->TraceConnectWithoutContext("Stall", MakeBoundCallback(&StallTrace, &stallFile));
+
   Simulator::Run();
   Simulator::Destroy();
 
@@ -0,0 +1,124 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-tracers-install-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/utils/tracers/ndn-fileconsumer-tracer.hpp"
+
+#include <boost/lexical_cast.hpp>
+
+namespace ns3 {
+
+/**
+ * This scenario measures how long it takes to install application-level tracers
+ * (AppDelayTracer, FileConsumerTracer, FileConsumerLogTracer, DASHPlayerTracer) on a large
+ * number of nodes, each running one consumer application.  No simulation is run.
+ *
+ * For comparison, the baseline repeats the config path resolution of the old install, where each
+ * tracer called Config::ConnectWithoutContext("/NodeList/<id>/ApplicationList/*/<source>") for
+ * each node and trace source (7 per node), which made the install grow quadratically.
+ *
+ *     ./waf --run="ndn-tracers-install-benchmark --nodes=1000"
+ *     ./waf --run="ndn-tracers-install-benchmark --nodes=10000"
+ *     ./waf --run="ndn-tracers-install-benchmark --nodes=50000 --baseline=0"
+ */
+
+// LastRetransmittedInterestDataDelay, FirstInterestDataDelay (AppDelayTracer), PlayerTracer
+// (DASHPlayerTracer), FileDownloadFinished, ManifestReceived, FileDownloadStarted
+// (FileConsumerTracer), CurrentPacketStats (FileConsumerLogTracer)
+static const uint32_t N_TRACE_SOURCES = 7;
+
+static int64_t
+resolveConfigPaths(const NodeContainer& nodes)
+{
+  SystemWallClockMs clock;
+  clock.Start();
+
+  uint32_t nMatches = 0;
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); ++node) {
+    // Config::ConnectWithoutContext resolves everything up to the trace source name
+    std::string path =
+      "/NodeList/" + boost::lexical_cast<std::string>((*node)->GetId()) + "/ApplicationList/*";
+    for (uint32_t i = 0; i < N_TRACE_SOURCES; i++) {
+      nMatches += Config::LookupMatches(path).GetN();
+    }
+  }
+
+  int64_t elapsed = clock.End();
+  NS_ASSERT(nMatches == nodes.GetN() * N_TRACE_SOURCES);
+  return elapsed;
+}
+
+int
+main(int argc, char* argv[])
+{
+  uint32_t nNodes = 1000;
+  bool baseline = true;
+
+  CommandLine cmd;
+  cmd.AddValue("nodes", "Number of nodes", nNodes);
+  cmd.AddValue("baseline", "Also time the config path resolution of the old install", baseline);
+  cmd.Parse(argc, argv);
+
+  NodeContainer nodes;
+  nodes.Create(nNodes);
+
+  ndn::AppHelper consumerHelper("ns3::ndn::FileConsumerCbr");
+  consumerHelper.SetAttribute("FileToRequest", StringValue("/myprefix/file1.img"));
+  consumerHelper.Install(nodes);
+
+  if (baseline) {
+    std::cout << nNodes << " nodes: config paths resolved in " << resolveConfigPaths(nodes)
+              << " ms (baseline)" << std::endl;
+  }
+
+  SystemWallClockMs clock;
+  clock.Start();
+
+  ndn::AppDelayTracer::InstallAll("/dev/null");
+  ndn::FileConsumerTracer::InstallAll("/dev/null");
+  ndn::FileConsumerLogTracer::InstallAll("/dev/null");
+  ndn::DASHPlayerTracer::InstallAll("/dev/null");
+
+  int64_t elapsed = clock.End();
+
+  std::cout << nNodes << " nodes: tracers installed in " << elapsed << " ms" << std::endl;
+
+  ndn::AppDelayTracer::Destroy();
+  ndn::FileConsumerTracer::Destroy();
+  ndn::FileConsumerLogTracer::Destroy();
+  ndn::DASHPlayerTracer::Destroy();
+
+  Simulator::Destroy();
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
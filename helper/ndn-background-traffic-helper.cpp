@@ -0,0 +1,211 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-background-traffic-helper.hpp"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+#include "ns3/queue.h"
+#include "ns3/point-to-point-net-device.h"
+#include "ns3/point-to-point-channel.h"
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+NS_LOG_COMPONENT_DEFINE("ndn.BackgroundTrafficHelper");
+
+namespace ns3 {
+namespace ndn {
+
+// the link is never fully reserved by background traffic
+static const double MAX_LOAD = 0.99;
+
+struct BackgroundLink {
+  DataRate capacity;     ///< @brief DataRate of the device without background traffic
+  bool hasMaxPackets;
+  uint32_t maxPackets;   ///< @brief queue size without background traffic
+  bool hasMaxBytes;
+  uint32_t maxBytes;
+  uint64_t reserved;     ///< @brief sum of the background rates (bits/s)
+};
+
+struct BackgroundFlow {
+  std::vector<Ptr<PointToPointNetDevice>> devices;
+  uint64_t rate;
+};
+
+static std::map<Ptr<PointToPointNetDevice>, BackgroundLink> g_links;
+static std::map<uint32_t, BackgroundFlow> g_flows;
+static uint32_t g_lastFlowId = 0;
+static bool g_isClearScheduled = false;
+
+uint32_t
+BackgroundTrafficHelper::AddFlow(const NodeContainer& path, const DataRate& rate)
+{
+  NS_LOG_FUNCTION(path.GetN() << rate);
+  NS_ASSERT_MSG(path.GetN() >= 2, "Path should contain at least two nodes");
+
+  if (!g_isClearScheduled) {
+    Simulator::ScheduleDestroy(&BackgroundTrafficHelper::clear);
+    g_isClearScheduled = true;
+  }
+
+  BackgroundFlow flow;
+  flow.rate = rate.GetBitRate();
+
+  for (uint32_t i = 0; i + 1 < path.GetN(); i++) {
+    Ptr<PointToPointNetDevice> device = getDevice(path.Get(i), path.Get(i + 1));
+
+    if (g_links.find(device) == g_links.end()) {
+      BackgroundLink& link = g_links[device];
+
+      DataRateValue dataRate;
+      device->GetAttribute("DataRate", dataRate);
+      link.capacity = dataRate.Get();
+
+      UintegerValue maxPackets;
+      link.hasMaxPackets = device->GetQueue()->GetAttributeFailSafe("MaxPackets", maxPackets);
+      link.maxPackets = maxPackets.Get();
+
+      UintegerValue maxBytes;
+      link.hasMaxBytes = device->GetQueue()->GetAttributeFailSafe("MaxBytes", maxBytes);
+      link.maxBytes = maxBytes.Get();
+
+      link.reserved = 0;
+    }
+
+    g_links[device].reserved += flow.rate;
+    flow.devices.push_back(device);
+    update(device);
+  }
+
+  uint32_t flowId = ++g_lastFlowId;
+  g_flows[flowId] = flow;
+  return flowId;
+}
+
+void
+BackgroundTrafficHelper::SetFlowRate(uint32_t flowId, const DataRate& rate)
+{
+  NS_LOG_FUNCTION(flowId << rate);
+
+  auto flow = g_flows.find(flowId);
+  NS_ASSERT_MSG(flow != g_flows.end(), "Unknown background flow " << flowId);
+
+  for (const auto& device : flow->second.devices) {
+    g_links[device].reserved -= flow->second.rate;
+    g_links[device].reserved += rate.GetBitRate();
+    update(device);
+  }
+  flow->second.rate = rate.GetBitRate();
+}
+
+void
+BackgroundTrafficHelper::RemoveFlow(uint32_t flowId)
+{
+  NS_LOG_FUNCTION(flowId);
+
+  auto flow = g_flows.find(flowId);
+  NS_ASSERT_MSG(flow != g_flows.end(), "Unknown background flow " << flowId);
+
+  for (const auto& device : flow->second.devices) {
+    g_links[device].reserved -= flow->second.rate;
+    update(device);
+  }
+  g_flows.erase(flow);
+}
+
+DataRate
+BackgroundTrafficHelper::GetResidualRate(Ptr<Node> from, Ptr<Node> to)
+{
+  DataRateValue dataRate;
+  getDevice(from, to)->GetAttribute("DataRate", dataRate);
+  return dataRate.Get();
+}
+
+Ptr<PointToPointNetDevice>
+BackgroundTrafficHelper::getDevice(Ptr<Node> from, Ptr<Node> to)
+{
+  NS_ASSERT(from != nullptr && to != nullptr);
+
+  for (uint32_t deviceId = 0; deviceId < from->GetNDevices(); deviceId++) {
+    Ptr<PointToPointNetDevice> device = DynamicCast<PointToPointNetDevice>(from->GetDevice(deviceId));
+    if (device == nullptr)
+      continue;
+
+    Ptr<PointToPointChannel> channel = DynamicCast<PointToPointChannel>(device->GetChannel());
+    if (channel == nullptr)
+      continue;
+
+    Ptr<NetDevice> other = channel->GetDevice(0);
+    if (other == device)
+      other = channel->GetDevice(1);
+
+    if (other->GetNode() == to)
+      return device;
+  }
+
+  NS_FATAL_ERROR("There is no point-to-point link from node " << from->GetId() << " to node "
+                                                              << to->GetId());
+  return nullptr;
+}
+
+void
+BackgroundTrafficHelper::update(Ptr<PointToPointNetDevice> device)
+{
+  BackgroundLink& link = g_links[device];
+
+  double capacity = link.capacity.GetBitRate();
+  double load = std::min(link.reserved / capacity, MAX_LOAD);
+  device->SetDataRate(DataRate(static_cast<uint64_t>(capacity * (1 - load) + 0.5)));
+
+  // mean number of packets in an M/M/1 queue with the background load; the time to send them is
+  // not added as a delay, foreground packets already queue behind the reduced DataRate
+  int64_t occupancy = static_cast<int64_t>(load / (1 - load) + 0.5);
+
+  NS_LOG_DEBUG("Node " << device->GetNode()->GetId() << ", device " << device->GetIfIndex()
+               << ": load " << load << ", occupancy " << occupancy << " packets");
+
+  if (link.hasMaxPackets) {
+    int64_t maxPackets = std::max<int64_t>(link.maxPackets - occupancy, 1);
+    device->GetQueue()->SetAttribute("MaxPackets", UintegerValue(maxPackets));
+  }
+
+  if (link.hasMaxBytes) {
+    int64_t mtu = device->GetMtu();
+    int64_t maxBytes = std::max<int64_t>(link.maxBytes - occupancy * mtu,
+                                         std::min<int64_t>(link.maxBytes, mtu));
+    device->GetQueue()->SetAttribute("MaxBytes", UintegerValue(maxBytes));
+  }
+}
+
+void
+BackgroundTrafficHelper::clear()
+{
+  g_flows.clear();
+  g_links.clear();
+  g_isClearScheduled = false;
+}
+
+} // namespace ndn
+} // namespace ns3
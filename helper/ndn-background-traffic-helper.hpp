@@ -0,0 +1,109 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_BACKGROUND_TRAFFIC_HELPER_H
+#define NDN_BACKGROUND_TRAFFIC_HELPER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/ptr.h"
+#include "ns3/node.h"
+#include "ns3/node-container.h"
+#include "ns3/data-rate.h"
+
+namespace ns3 {
+
+class PointToPointNetDevice;
+
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Helper to load point-to-point links with fluid background traffic
+ *
+ * A background flow is declared as a rate over a path of nodes and does not generate any
+ * packets.  Instead, every PointToPointNetDevice sending the flow (towards the next node of the
+ * path) is updated whenever a flow is added, removed or changes its rate:
+ *
+ * - the DataRate of the device is reduced by the sum of the background rates (capacity
+ *   reservation), but to no less than 1% of the link capacity;
+ * - the transmit queue is shortened by the mean number of background packets that would be
+ *   queued, rho / (1 - rho) for a load of rho (occupancy), rounded to whole packets.
+ *
+ * Foreground packets therefore see the residual bandwidth and buffer space of each direction
+ * without per-packet events for the background load.  Their queueing delay results from the
+ * residual rate; no M/M/1 waiting time is added on top of it, and the channel delay, which is
+ * shared by both directions, is not changed.  Only mean values are modeled: the variation of the
+ * queueing delay (jitter) and losses caused by background bursts are not.  Background traffic
+ * does not react to foreground traffic (e.g., it does not back off), and the link rate seen by
+ * tracers that sample the DataRate at installation time is not updated.
+ *
+ * Note that only PointToPointChannels are supported by this helper
+ */
+class BackgroundTrafficHelper {
+public:
+  /**
+   * @brief Add background flow along @p path (e.g., from producer to consumer)
+   * @param path nodes of the path; consecutive nodes must be connected by a point-to-point link
+   * @param rate rate of the flow
+   * @returns ID of the flow
+   */
+  static uint32_t
+  AddFlow(const NodeContainer& path, const DataRate& rate);
+
+  /**
+   * @brief Change the rate of the background flow
+   */
+  static void
+  SetFlowRate(uint32_t flowId, const DataRate& rate);
+
+  /**
+   * @brief Remove the background flow
+   *
+   * Once all flows crossing a link are removed, the original DataRate and queue size of the link
+   * are restored.
+   */
+  static void
+  RemoveFlow(uint32_t flowId);
+
+  /**
+   * @brief Get the rate left for foreground traffic sent by @p from towards @p to
+   */
+  static DataRate
+  GetResidualRate(Ptr<Node> from, Ptr<Node> to);
+
+private:
+  static Ptr<PointToPointNetDevice>
+  getDevice(Ptr<Node> from, Ptr<Node> to);
+
+  /**
+   * @brief Apply the current background load to the device
+   */
+  static void
+  update(Ptr<PointToPointNetDevice> device);
+
+  static void
+  clear();
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_BACKGROUND_TRAFFIC_HELPER_H
@@ -36,6 +36,7 @@
 #include "ns3/point-to-point-helper.h"
 #include "ns3/callback.h"
 #include "ns3/node-list.h"
+#include "ns3/node-container.h"
 #include "ns3/data-rate.h"
 
 #include "daemon/mgmt/fib-manager.hpp"
@@ -48,6 +49,42 @@ namespace ndn {
 
 NS_LOG_COMPONENT_DEFINE("ndn.FibHelper");
 
+/**
+ * \brief Find face towards otherNode over a multi-access (non point-to-point) link
+ *
+ * Unicast adjacency face is preferred, if the stack created one for otherNode
+ */
+static shared_ptr<Face>
+getMultiAccessFace(Ptr<Node> node, Ptr<Node> otherNode)
+{
+  Ptr<L3Protocol> ndn = node->GetObject<L3Protocol>();
+  NS_ASSERT_MSG(ndn != 0, "Ndn stack should be installed on the node");
+
+  for (uint32_t deviceId = 0; deviceId < node->GetNDevices(); deviceId++) {
+    Ptr<NetDevice> netDevice = node->GetDevice(deviceId);
+    if (DynamicCast<PointToPointNetDevice>(netDevice) != 0)
+      continue;
+
+    Ptr<Channel> channel = netDevice->GetChannel();
+    if (channel == 0)
+      continue;
+
+    for (uint32_t otherDeviceId = 0; otherDeviceId < channel->GetNDevices(); otherDeviceId++) {
+      Ptr<NetDevice> otherDevice = channel->GetDevice(otherDeviceId);
+      if (otherDevice->GetNode() != otherNode)
+        continue;
+
+      shared_ptr<Face> face = ndn->getFaceByNetDevice(netDevice, otherDevice->GetAddress());
+      if (face == nullptr)
+        face = ndn->getFaceByNetDevice(netDevice);
+      if (face != nullptr)
+        return face;
+    }
+  }
+
+  return nullptr;
+}
+
 void
 FibHelper::AddNextHop(const ControlParameters& parameters, Ptr<Node> node)
 {
@@ -160,6 +197,12 @@ FibHelper::AddRoute(Ptr<Node> node, const Name& prefix, Ptr<Node> otherNode, int
     }
   }
 
+  shared_ptr<Face> face = getMultiAccessFace(node, otherNode);
+  if (face != nullptr) {
+    AddRoute(node, prefix, face, metric);
+    return;
+  }
+
   NS_FATAL_ERROR("Cannot add route: Node# " << node->GetId() << " and Node# " << otherNode->GetId()
                                             << " are not connected");
 }
@@ -246,6 +289,12 @@ FibHelper::RemoveRoute(Ptr<Node> node, const Name& prefix, Ptr<Node> otherNode)
     }
   }
 
+  shared_ptr<Face> face = getMultiAccessFace(node, otherNode);
+  if (face != nullptr) {
+    RemoveRoute(node, prefix, face);
+    return;
+  }
+
   NS_FATAL_ERROR("Cannot remove route: Node# " << node->GetId() << " and Node# " << otherNode->GetId()
                                             << " are not connected");
 }
@@ -259,6 +308,29 @@ FibHelper::RemoveRoute(const std::string& nodeName, const Name& prefix,
   RemoveRoute(node, prefix, otherNode);
 }
 
+void
+FibHelper::Freeze(Ptr<Node> node)
+{
+  Ptr<L3Protocol> ndn = node->GetObject<L3Protocol>();
+  NS_ASSERT_MSG(ndn != 0, "Ndn stack should be installed on the node");
+
+  ndn->freezeFib();
+}
+
+void
+FibHelper::Freeze(const NodeContainer& nodes)
+{
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    Freeze(*node);
+  }
+}
+
+void
+FibHelper::FreezeAll()
+{
+  Freeze(NodeContainer::GetGlobal());
+}
+
 } // namespace ndn
 
 } // namespace ns
@@ -24,6 +24,7 @@
 #include "ns3/ndnSIM/model/ndn-face.hpp"
 
 #include "ns3/node.h"
+#include "ns3/node-container.h"
 #include "ns3/object-vector.h"
 #include "ns3/pointer.h"
 
@@ -151,6 +152,33 @@ public:
   static void
   RemoveRoute(const std::string& nodeName, const Name& prefix, const std::string& otherNodeName);
 
+  /**
+   * @brief Switch FIB of the node into the frozen mode (see L3Protocol::freezeFib)
+   *
+   * Intended to be called once routes are calculated, e.g., after
+   * GlobalRoutingHelper::CalculateRoutes.  Routes added or removed afterwards (through this
+   * helper or by prefix registrations) and removed faces trigger a rebuild of the node's
+   * FibSnapshot.
+   *
+   * \param node Node
+   */
+  static void
+  Freeze(Ptr<Node> node);
+
+  /**
+   * @brief Switch FIB of the nodes into the frozen mode
+   *
+   * \param nodes Nodes
+   */
+  static void
+  Freeze(const NodeContainer& nodes);
+
+  /**
+   * @brief Switch FIB of all nodes into the frozen mode
+   */
+  static void
+  FreezeAll();
+
 private:
   static void
   GenerateCommand(Interest& interest);
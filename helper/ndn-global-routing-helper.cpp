@@ -100,13 +100,19 @@ GlobalRoutingHelper::Install(Ptr<Node> node)
       continue;
     }
 
-    if (ch->GetNDevices() == 2) // e.g., point-to-point channel
+    // unicast adjacency faces on multi-access channels lead directly to the neighbor
+    bool isAdjacency = !face->GetRemoteAddress().IsInvalid();
+
+    if (ch->GetNDevices() == 2 || isAdjacency) // e.g., point-to-point channel
     {
       for (uint32_t deviceId = 0; deviceId < ch->GetNDevices(); deviceId++) {
         Ptr<NetDevice> otherSide = ch->GetDevice(deviceId);
         if (nd == otherSide)
           continue;
 
+        if (isAdjacency && otherSide->GetAddress() != face->GetRemoteAddress())
+          continue;
+
         Ptr<Node> otherNode = otherSide->GetNode();
         NS_ASSERT(otherNode != 0);
 
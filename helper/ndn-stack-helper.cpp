@@ -23,6 +23,7 @@
 #include "ns3/names.h"
 #include "ns3/string.h"
 #include "ns3/point-to-point-net-device.h"
+#include "ns3/channel.h"
 
 #include "model/ndn-l3-protocol.hpp"
 #include "model/ndn-net-device-face.hpp"
@@ -41,6 +42,7 @@ namespace ndn {
 
 StackHelper::StackHelper()
   : m_needSetDefaultRoutes(false)
+  , m_needUnicastAdjacencies(false)
   , m_maxCsSize(100)
   , m_isRibManagerDisabled(false)
   , m_isFaceManagerDisabled(false)
@@ -83,6 +85,29 @@ StackHelper::SetDefaultRoutes(bool needSet)
   m_needSetDefaultRoutes = needSet;
 }
 
+void
+StackHelper::SetUnicastAdjacencies(bool needSet)
+{
+  NS_LOG_FUNCTION(this << needSet);
+  m_needUnicastAdjacencies = needSet;
+}
+
+void
+StackHelper::EnableInterestPacking(TypeId netDeviceType, Time interval)
+{
+  NS_LOG_FUNCTION(this << netDeviceType << interval);
+  DisableInterestPacking(netDeviceType);
+  m_interestPacking.push_back(std::make_pair(netDeviceType, interval));
+}
+
+void
+StackHelper::DisableInterestPacking(TypeId netDeviceType)
+{
+  m_interestPacking.remove_if([&] (const std::pair<TypeId, Time>& i) {
+      return (i.first == netDeviceType);
+    });
+}
+
 void
 StackHelper::SetStackAttributes(const std::string& attr1, const std::string& value1,
                                 const std::string& attr2, const std::string& value2,
@@ -321,9 +346,49 @@ StackHelper::createAndRegisterFace(Ptr<Node> node, Ptr<L3Protocol> ndn, Ptr<NetD
     // default route with lowest priority possible
     FibHelper::AddRoute(node, "/", face, std::numeric_limits<int32_t>::max());
   }
+
+  for (const auto& item : m_interestPacking) {
+    if (device->GetInstanceTypeId() == item.first ||
+        device->GetInstanceTypeId().IsChildOf(item.first)) {
+      face->EnableInterestPacking(item.second);
+      break;
+    }
+  }
+
+  // adjacency faces inherit Interest packing
+  if (m_needUnicastAdjacencies) {
+    createAdjacencyFaces(node, ndn, face);
+  }
   return face;
 }
 
+void
+StackHelper::createAdjacencyFaces(Ptr<Node> node, Ptr<L3Protocol> ndn,
+                                  const shared_ptr<NetDeviceFace>& multicastFace) const
+{
+  Ptr<NetDevice> device = multicastFace->GetNetDevice();
+  if (device->IsPointToPoint() || !device->IsBroadcast())
+    return;
+
+  Ptr<Channel> channel = device->GetChannel();
+  if (channel == 0)
+    return;
+
+  for (uint32_t deviceId = 0; deviceId < channel->GetNDevices(); deviceId++) {
+    Ptr<NetDevice> otherDevice = channel->GetDevice(deviceId);
+    if (otherDevice == device || otherDevice->GetNode() == node)
+      continue;
+
+    shared_ptr<NetDeviceFace> face =
+      std::make_shared<NetDeviceFace>(multicastFace, otherDevice->GetAddress());
+
+    ndn->addFace(face);
+    NS_LOG_LOGIC("Node " << node->GetId() << ": added unicast adjacency with "
+                         << otherDevice->GetAddress() << " (node "
+                         << otherDevice->GetNode()->GetId() << ") as face #" << face->getId());
+  }
+}
+
 void
 StackHelper::disableRibManager()
 {
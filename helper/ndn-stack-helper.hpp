@@ -179,6 +179,39 @@ public:
   void
   SetDefaultRoutes(bool needSet);
 
+  /**
+   * \brief Set flag indicating necessity to create unicast adjacency faces
+   *
+   * For every multi-access NetDevice (e.g., CSMA or Wi-Fi), the stack will create, in addition
+   * to the face that transmits to the broadcast address, one unicast face per other NetDevice
+   * attached to the same channel.  Default routes (SetDefaultRoutes) are installed only on the
+   * broadcast face, while FibHelper::AddRoute towards a neighbor node and GlobalRoutingHelper
+   * use the unicast faces.
+   *
+   * Only NetDevices already attached to the channel at install time become adjacencies.
+   */
+  void
+  SetUnicastAdjacencies(bool needSet);
+
+  /**
+   * \brief Pack Interests into shared frames on faces of NetDevices of the given type
+   *
+   * Interests sent to the same face within \p interval are transmitted back-to-back in one
+   * frame, up to the MTU of the NetDevice (see NetDeviceFace::EnableInterestPacking)
+   *
+   * @param netDeviceType type of NetDevice (e.g., WifiNetDevice::GetTypeId()), subclasses
+   * included
+   * @param interval maximum time an Interest waits for other Interests
+   */
+  void
+  EnableInterestPacking(TypeId netDeviceType, Time interval = Seconds(0));
+
+  /**
+   * \brief Stop packing Interests on faces of NetDevices of the given type
+   */
+  void
+  DisableInterestPacking(TypeId netDeviceType);
+
   static KeyChain&
   getKeyChain();
 
@@ -246,6 +279,10 @@ private:
   shared_ptr<NetDeviceFace>
   createAndRegisterFace(Ptr<Node> node, Ptr<L3Protocol> ndn, Ptr<NetDevice> device) const;
 
+  void
+  createAdjacencyFaces(Ptr<Node> node, Ptr<L3Protocol> ndn,
+                       const shared_ptr<NetDeviceFace>& multicastFace) const;
+
   bool m_isRibManagerDisabled;
   bool m_isFaceManagerDisabled;
   bool m_isStatusServerDisabled;
@@ -260,10 +297,13 @@ private:
   ObjectFactory m_contentStoreFactory;
 
   bool m_needSetDefaultRoutes;
+  bool m_needUnicastAdjacencies;
   size_t m_maxCsSize;
 
   typedef std::list<std::pair<TypeId, NetDeviceFaceCreateCallback>> NetDeviceCallbackList;
   NetDeviceCallbackList m_netDeviceCallbacks;
+
+  std::list<std::pair<TypeId, Time>> m_interestPacking;
 };
 
 } // namespace ndn
@@ -26,15 +26,6 @@
 #include "../../utils/trie/multi-policy.hpp"
 #include "../../utils/trie/aggregate-stats-policy.hpp"
 
-#define NS_OBJECT_ENSURE_REGISTERED_TEMPL(type, templ)                                             \
-  static struct X##type##templ##RegistrationClass {                                                \
-    X##type##templ##RegistrationClass()                                                            \
-    {                                                                                              \
-      ns3::TypeId tid = type<templ>::GetTypeId();                                                  \
-      tid.GetParent();                                                                             \
-    }                                                                                              \
-  } x_##type##templ##RegistrationVariable
-
 namespace ns3 {
 namespace ndn {
 
@@ -46,49 +37,31 @@ namespace cs {
 /**
  * @brief ContentStore with LRU cache replacement policy
  **/
-template class ContentStoreImpl<lru_policy_traits>;
+NDN_CS_REGISTER(ContentStoreImpl, lru_policy_traits);
 
 /**
  * @brief ContentStore with random cache replacement policy
  **/
-template class ContentStoreImpl<random_policy_traits>;
+NDN_CS_REGISTER(ContentStoreImpl, random_policy_traits);
 
 /**
  * @brief ContentStore with FIFO cache replacement policy
  **/
-template class ContentStoreImpl<fifo_policy_traits>;
+NDN_CS_REGISTER(ContentStoreImpl, fifo_policy_traits);
 
 /**
  * @brief ContentStore with Least Frequently Used (LFU) cache replacement policy
  **/
-template class ContentStoreImpl<lfu_policy_traits>;
-
-NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, lru_policy_traits);
-NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, random_policy_traits);
-NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, fifo_policy_traits);
-NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, lfu_policy_traits);
-
-typedef multi_policy_traits<boost::mpl::vector2<lru_policy_traits, aggregate_stats_policy_traits>>
-  LruWithCountsTraits;
-typedef multi_policy_traits<boost::mpl::vector2<random_policy_traits,
-                                                aggregate_stats_policy_traits>>
-  RandomWithCountsTraits;
-typedef multi_policy_traits<boost::mpl::vector2<fifo_policy_traits, aggregate_stats_policy_traits>>
-  FifoWithCountsTraits;
-typedef multi_policy_traits<boost::mpl::vector2<lfu_policy_traits, aggregate_stats_policy_traits>>
-  LfuWithCountsTraits;
-
-template class ContentStoreImpl<LruWithCountsTraits>;
-NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, LruWithCountsTraits);
-
-template class ContentStoreImpl<RandomWithCountsTraits>;
-NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, RandomWithCountsTraits);
-
-template class ContentStoreImpl<FifoWithCountsTraits>;
-NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, FifoWithCountsTraits);
-
-template class ContentStoreImpl<LfuWithCountsTraits>;
-NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, LfuWithCountsTraits);
+NDN_CS_REGISTER(ContentStoreImpl, lfu_policy_traits);
+
+NDN_CS_REGISTER(ContentStoreImpl, multi_policy_traits<lru_policy_traits,
+                                                   aggregate_stats_policy_traits>);
+NDN_CS_REGISTER(ContentStoreImpl, multi_policy_traits<random_policy_traits,
+                                                   aggregate_stats_policy_traits>);
+NDN_CS_REGISTER(ContentStoreImpl, multi_policy_traits<fifo_policy_traits,
+                                                   aggregate_stats_policy_traits>);
+NDN_CS_REGISTER(ContentStoreImpl, multi_policy_traits<lfu_policy_traits,
+                                                   aggregate_stats_policy_traits>);
 
 #ifdef DOXYGEN
 // /**
@@ -33,6 +33,30 @@
 
 #include "../../utils/trie/trie-with-policy.hpp"
 
+/// @cond include_hidden
+#define NDN_CS_CONCAT_IMPL(a, b) a##b
+#define NDN_CS_CONCAT(a, b) NDN_CS_CONCAT_IMPL(a, b)
+/// @endcond
+
+/**
+ * @ingroup ndn-cs
+ * @brief Explicitly instantiate content store template for the policy and register its TypeId
+ *
+ * The policy can be any type, including multi_policy_traits with several policies, e.g.,
+ *
+ *     NDN_CS_REGISTER(ContentStoreImpl,
+ *                     multi_policy_traits<lru_policy_traits, aggregate_stats_policy_traits>);
+ */
+#define NDN_CS_REGISTER(type, ...)                                                                 \
+  template class type<__VA_ARGS__>;                                                                \
+  static struct NDN_CS_CONCAT(X##type##RegistrationClass, __LINE__) {                              \
+    NDN_CS_CONCAT(X##type##RegistrationClass, __LINE__)()                                          \
+    {                                                                                              \
+      ns3::TypeId tid = type<__VA_ARGS__>::GetTypeId();                                            \
+      tid.GetParent();                                                                             \
+    }                                                                                              \
+  } NDN_CS_CONCAT(x_##type##RegistrationVariable, __LINE__)
+
 namespace ns3 {
 namespace ndn {
 namespace cs {
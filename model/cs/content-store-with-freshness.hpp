@@ -26,6 +26,7 @@
 
 #include "../../utils/trie/multi-policy.hpp"
 #include "custom-policies/freshness-policy.hpp"
+#include "ns3/nstime.h"
 
 namespace ns3 {
 namespace ndn {
@@ -37,14 +38,9 @@ namespace cs {
  */
 template<class Policy>
 class ContentStoreWithFreshness
-  : public ContentStoreImpl<ndnSIM::
-                              multi_policy_traits<boost::mpl::
-                                                    vector2<Policy,
-                                                            ndnSIM::freshness_policy_traits>>> {
+  : public ContentStoreImpl<ndnSIM::multi_policy_traits<Policy, ndnSIM::freshness_policy_traits>> {
 public:
-  typedef ContentStoreImpl<ndnSIM::multi_policy_traits<boost::mpl::
-                                                         vector2<Policy,
-                                                                 ndnSIM::freshness_policy_traits>>>
+  typedef ContentStoreImpl<ndnSIM::multi_policy_traits<Policy, ndnSIM::freshness_policy_traits>>
     super;
 
   typedef typename super::policy_container::template index<1>::type freshness_policy_container;
@@ -63,13 +59,25 @@ private:
   CleanExpired();
 
   inline void
-  RescheduleCleaning();
+  StartCleaning();
+
+  void
+  SetExpiryGranularity(const Time& granularity)
+  {
+    this->getPolicy().template get<freshness_policy_container>().set_granularity(granularity);
+  }
+
+  Time
+  GetExpiryGranularity() const
+  {
+    return this->getPolicy().template get<freshness_policy_container>().get_granularity();
+  }
 
 private:
   static LogComponent g_log; ///< @brief Logging variable
 
-  EventId m_cleanEvent;
-  Time m_scheduledCleaningTime;
+  EventId m_cleanEvent; ///< @brief Next wheel advance, pending only while fresh items exist
+  Time m_cleanTime;     ///< @brief Time of m_cleanEvent
 };
 
 //////////////////////////////////////////
@@ -89,8 +97,15 @@ ContentStoreWithFreshness<Policy>::GetTypeId()
                         .SetParent<super>()
                         .template AddConstructor<ContentStoreWithFreshness<Policy>>()
 
-    // trace stuff here
-    ;
+                        .AddAttribute("ExpiryGranularity",
+                                      "Tick length of the timer wheel driving freshness expiry. "
+                                      "Stale entries are removed at most one tick late",
+                                      TimeValue(MilliSeconds(10)),
+                                      MakeTimeAccessor(&ContentStoreWithFreshness<Policy>::
+                                                         GetExpiryGranularity,
+                                                       &ContentStoreWithFreshness<Policy>::
+                                                         SetExpiryGranularity),
+                                      MakeTimeChecker());
 
   return tid;
 }
@@ -104,39 +119,30 @@ ContentStoreWithFreshness<Policy>::Add(shared_ptr<const Data> data)
     return false;
 
   NS_LOG_DEBUG(data->getName() << " added to cache");
-  RescheduleCleaning();
+  StartCleaning();
   return true;
 }
 
 template<class Policy>
 inline void
-ContentStoreWithFreshness<Policy>::RescheduleCleaning()
+ContentStoreWithFreshness<Policy>::StartCleaning()
 {
   const freshness_policy_container& freshness =
     this->getPolicy().template get<freshness_policy_container>();
 
-  if (freshness.size() > 0) {
-    Time nextStateTime =
-      freshness_policy_container::policy_base::get_freshness(&(*freshness.begin()));
-
-    if (m_scheduledCleaningTime.IsZero() ||      // if not yet scheduled
-        m_scheduledCleaningTime > nextStateTime) // if new item expire sooner than already scheduled
-    {
-      if (m_cleanEvent.IsRunning()) {
-        Simulator::Remove(m_cleanEvent); // just canceling would not clean up list of events
-      }
-
-      // NS_LOG_DEBUG ("Next event in: " << (nextStateTime - Now ()).ToDouble (Time::S) << "s");
-      m_cleanEvent = Simulator::Schedule(nextStateTime - Now(),
-                                         &ContentStoreWithFreshness<Policy>::CleanExpired, this);
-      m_scheduledCleaningTime = nextStateTime;
-    }
-  }
-  else {
-    if (m_cleanEvent.IsRunning()) {
-      Simulator::Remove(m_cleanEvent); // just canceling would not clean up list of events
-    }
-  }
+  if (freshness.empty())
+    return;
+
+  // The event is placed at the next tick at which something is due in the wheel, so it only
+  // has to be moved when a new item expires before everything that is already there
+  Time next = freshness.next_tick();
+  if (m_cleanEvent.IsRunning() && m_cleanTime <= next)
+    return;
+
+  Simulator::Cancel(m_cleanEvent);
+  m_cleanTime = next;
+  m_cleanEvent = Simulator::Schedule(next - Simulator::Now(),
+                                     &ContentStoreWithFreshness<Policy>::CleanExpired, this);
 }
 
 template<class Policy>
@@ -148,24 +154,16 @@ ContentStoreWithFreshness<Policy>::CleanExpired()
 
   // NS_LOG_LOGIC (">> Cleaning: Total number of items:" << this->getPolicy ().size () << ", items
   // with freshness: " << freshness.size ());
-  Time now = Simulator::Now();
-
-  while (!freshness.empty()) {
-    typename freshness_policy_container::iterator entry = freshness.begin();
-
-    if (freshness_policy_container::policy_base::get_freshness(&(*entry))
-        <= now) // is the record stale?
-    {
-      super::erase(&(*entry));
-    }
-    else
-      break; // nothing else to do. All later records will not be stale
+  freshness.advance(Simulator::Now());
+
+  // erasing an entry unlinks it from the list of due items
+  while (!freshness.due().empty()) {
+    super::erase(&freshness.due().front());
   }
   // NS_LOG_LOGIC ("<< Cleaning: Total number of items:" << this->getPolicy ().size () << ", items
   // with freshness: " << freshness.size ());
 
-  m_scheduledCleaningTime = Time();
-  RescheduleCleaning();
+  StartCleaning();
 }
 
 template<class Policy>
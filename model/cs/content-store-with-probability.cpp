@@ -24,15 +24,6 @@
 #include "../../utils/trie/fifo-policy.hpp"
 #include "../../utils/trie/lfu-policy.hpp"
 
-#define NS_OBJECT_ENSURE_REGISTERED_TEMPL(type, templ)                                             \
-  static struct X##type##templ##RegistrationClass {                                                \
-    X##type##templ##RegistrationClass()                                                            \
-    {                                                                                              \
-      ns3::TypeId tid = type<templ>::GetTypeId();                                                  \
-      tid.GetParent();                                                                             \
-    }                                                                                              \
-  } x_##type##templ##RegistrationVariable
-
 namespace ns3 {
 namespace ndn {
 
@@ -44,28 +35,22 @@ namespace cs {
 /**
  * @brief ContentStore with freshness and LRU cache replacement policy
  **/
-template class ContentStoreWithProbability<lru_policy_traits>;
+NDN_CS_REGISTER(ContentStoreWithProbability, lru_policy_traits);
 
 /**
  * @brief ContentStore with freshness and random cache replacement policy
  **/
-template class ContentStoreWithProbability<random_policy_traits>;
+NDN_CS_REGISTER(ContentStoreWithProbability, random_policy_traits);
 
 /**
  * @brief ContentStore with freshness and FIFO cache replacement policy
  **/
-template class ContentStoreWithProbability<fifo_policy_traits>;
+NDN_CS_REGISTER(ContentStoreWithProbability, fifo_policy_traits);
 
 /**
  * @brief ContentStore with freshness and Least Frequently Used (LFU) cache replacement policy
  **/
-template class ContentStoreWithProbability<lfu_policy_traits>;
-
-NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithProbability, lru_policy_traits);
-NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithProbability, random_policy_traits);
-NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithProbability, fifo_policy_traits);
-
-NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithProbability, lfu_policy_traits);
+NDN_CS_REGISTER(ContentStoreWithProbability, lfu_policy_traits);
 
 #ifdef DOXYGEN
 // /**
@@ -40,13 +40,11 @@ namespace cs {
  */
 template<class Policy>
 class ContentStoreWithProbability
-  : public ContentStoreImpl<ndnSIM::multi_policy_traits<boost::mpl::
-                                                          vector2<ndnSIM::probability_policy_traits,
-                                                                  Policy>>> {
+  : public ContentStoreImpl<ndnSIM::multi_policy_traits<ndnSIM::probability_policy_traits,
+                                                        Policy>> {
 public:
-  typedef ContentStoreImpl<ndnSIM::multi_policy_traits<boost::mpl::
-                                                         vector2<ndnSIM::probability_policy_traits,
-                                                                 Policy>>> super;
+  typedef ContentStoreImpl<ndnSIM::multi_policy_traits<ndnSIM::probability_policy_traits, Policy>>
+    super;
 
   typedef typename super::policy_container::template index<0>::type probability_policy_container;
 
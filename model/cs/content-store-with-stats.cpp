@@ -24,15 +24,6 @@
 #include "../../utils/trie/fifo-policy.hpp"
 #include "../../utils/trie/lfu-policy.hpp"
 
-#define NS_OBJECT_ENSURE_REGISTERED_TEMPL(type, templ)                                             \
-  static struct X##type##templ##RegistrationClass {                                                \
-    X##type##templ##RegistrationClass()                                                            \
-    {                                                                                              \
-      ns3::TypeId tid = type<templ>::GetTypeId();                                                  \
-      tid.GetParent();                                                                             \
-    }                                                                                              \
-  } x_##type##templ##RegistrationVariable
-
 namespace ns3 {
 namespace ndn {
 
@@ -44,28 +35,22 @@ namespace cs {
 /**
  * @brief ContentStore with stats and LRU cache replacement policy
  **/
-template class ContentStoreWithStats<lru_policy_traits>;
+NDN_CS_REGISTER(ContentStoreWithStats, lru_policy_traits);
 
 /**
  * @brief ContentStore with stats and random cache replacement policy
  **/
-template class ContentStoreWithStats<random_policy_traits>;
+NDN_CS_REGISTER(ContentStoreWithStats, random_policy_traits);
 
 /**
  * @brief ContentStore with stats and FIFO cache replacement policy
  **/
-template class ContentStoreWithStats<fifo_policy_traits>;
+NDN_CS_REGISTER(ContentStoreWithStats, fifo_policy_traits);
 
 /**
  * @brief ContentStore with stats and Least Frequently Used (LFU) cache replacement policy
  **/
-template class ContentStoreWithStats<lfu_policy_traits>;
-
-NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithStats, lru_policy_traits);
-NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithStats, random_policy_traits);
-NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithStats, fifo_policy_traits);
-
-NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithStats, lfu_policy_traits);
+NDN_CS_REGISTER(ContentStoreWithStats, lfu_policy_traits);
 
 #ifdef DOXYGEN
 // /**
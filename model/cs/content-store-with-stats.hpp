@@ -37,16 +37,11 @@ namespace cs {
  */
 template<class Policy>
 class ContentStoreWithStats
-  : public ContentStoreImpl<ndnSIM::
-                              multi_policy_traits<boost::mpl::
-                                                    vector2<Policy,
-                                                            ndnSIM::
-                                                              lifetime_stats_policy_traits>>> {
+  : public ContentStoreImpl<ndnSIM::multi_policy_traits<Policy,
+                                                        ndnSIM::lifetime_stats_policy_traits>> {
 public:
-  typedef ContentStoreImpl<ndnSIM::
-                             multi_policy_traits<boost::mpl::
-                                                   vector2<Policy,
-                                                           ndnSIM::lifetime_stats_policy_traits>>>
+  typedef ContentStoreImpl<ndnSIM::multi_policy_traits<Policy,
+                                                       ndnSIM::lifetime_stats_policy_traits>>
     super;
 
   typedef typename super::policy_container::template index<1>::type lifetime_stats_container;
@@ -31,12 +31,25 @@
 #include <ns3/simulator.h>
 #include <ns3/traced-callback.h>
 
+#include <algorithm>
+#include <limits>
+#include <vector>
+
 namespace ns3 {
 namespace ndn {
 namespace ndnSIM {
 
 /**
  * @brief Traits for freshness policy
+ *
+ * Items with a positive FreshnessPeriod are kept in a two-level hierarchical timer wheel
+ * (plus an overflow list for very long periods) with ticks of `granularity` length.  Insertion
+ * and removal are O(1); advance() moves items whose expiry tick has passed into the list of due
+ * items, so an item is reported stale at most one tick after its exact expiry time.
+ *
+ * The wheel only needs to be advanced when a level-0 slot with items comes due, a non-empty
+ * level-1 slot has to be cascaded, or the overflow list has to be re-sorted; next_tick() tells
+ * when that is, so that idle ticks do not cost a simulator event.
  */
 struct freshness_policy_traits {
   /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
@@ -46,7 +59,9 @@ struct freshness_policy_traits {
     return "Freshness";
   }
 
-  struct policy_hook_type : public boost::intrusive::set_member_hook<> {
+  struct policy_hook_type
+    : public boost::intrusive::list_member_hook<
+        boost::intrusive::link_mode<boost::intrusive::auto_unlink>> {
     Time timeWhenShouldExpire;
   };
 
@@ -58,6 +73,9 @@ struct freshness_policy_traits {
 
   template<class Base, class Container, class Hook>
   struct policy {
+    typedef boost::intrusive::list<Container, boost::intrusive::constant_time_size<false>,
+                                   Hook> policy_container;
+
     static Time&
     get_freshness(typename Container::iterator item)
     {
@@ -72,27 +90,24 @@ struct freshness_policy_traits {
                policy_container::value_traits::to_node_ptr(*item))->timeWhenShouldExpire;
     }
 
-    template<class Key>
-    struct MemberHookLess {
-      bool
-      operator()(const Key& a, const Key& b) const
-      {
-        return get_freshness(&a) < get_freshness(&b);
-      }
-    };
-
-    typedef boost::intrusive::multiset<Container,
-                                       boost::intrusive::compare<MemberHookLess<Container>>,
-                                       Hook> policy_container;
-
-    class type : public policy_container {
+    class type {
     public:
       typedef policy policy_base; // to get access to get_freshness methods from outside
       typedef Container parent_trie;
+      typedef policy_container slot_type;
+
+      static const uint64_t LEVEL0_SLOTS = 256;
+      static const uint64_t LEVEL1_SLOTS = 64;
 
       type(Base& base)
         : base_(base)
         , max_size_(100)
+        , granularity_(MilliSeconds(10))
+        , current_tick_(0)
+        , next_tick_(NO_TICK)
+        , size_(0)
+        , level0_(LEVEL0_SLOTS)
+        , level1_(LEVEL1_SLOTS)
       {
       }
 
@@ -107,13 +122,25 @@ struct freshness_policy_traits {
       {
         time::milliseconds freshness = item->payload()->GetData()->getFreshnessPeriod();
         if (freshness > time::milliseconds::zero()) {
+          if (size_ == 0) {
+            // wheel was idle, so it is not being advanced; bring it to the current time
+            current_tick_ = Simulator::Now().GetTimeStep() / granularity_.GetTimeStep();
+            next_tick_ = NO_TICK;
+          }
+          else {
+            // the wheel is only advanced when something is due, so slots are relative to an
+            // earlier tick; nothing is due in between, so this only rolls over empty slots
+            roll(Simulator::Now());
+          }
+
           get_freshness(item) = Simulator::Now() + MilliSeconds(freshness.count());
 
           // push item only if freshness is non zero. otherwise, this payload is not
           // controlled by the policy.
           // Note that .size() on this policy would return only the number of items with
           // non-infinite freshness policy
-          policy_container::insert(*item);
+          place(*item);
+          ++size_;
         }
 
         return true;
@@ -131,14 +158,25 @@ struct freshness_policy_traits {
         time::milliseconds freshness = item->payload()->GetData()->getFreshnessPeriod();
         if (freshness > time::milliseconds::zero()) {
           // erase only if freshness is positive (otherwise an item is not in the policy)
-          policy_container::erase(policy_container::s_iterator_to(*item));
+          static_cast<typename policy_container::value_traits::hook_type*>(
+            policy_container::value_traits::to_node_ptr(*item))->unlink();
+          --size_;
         }
       }
 
       inline void
       clear()
       {
-        policy_container::clear();
+        for (typename std::vector<slot_type>::iterator slot = level0_.begin();
+             slot != level0_.end(); slot++)
+          slot->clear();
+        for (typename std::vector<slot_type>::iterator slot = level1_.begin();
+             slot != level1_.end(); slot++)
+          slot->clear();
+        overflow_.clear();
+        due_.clear();
+        size_ = 0;
+        next_tick_ = NO_TICK;
       }
 
       inline void
@@ -153,13 +191,171 @@ struct freshness_policy_traits {
         return max_size_;
       }
 
+      /**
+       * @brief Set length of a wheel tick (only takes effect on an empty policy)
+       */
+      inline void
+      set_granularity(const Time& granularity)
+      {
+        if (size_ == 0 && granularity.IsStrictlyPositive())
+          granularity_ = granularity;
+      }
+
+      inline const Time&
+      get_granularity() const
+      {
+        return granularity_;
+      }
+
+      /**
+       * @brief Time at which the wheel should next be advanced (only meaningful if not empty)
+       *
+       * This is the tick of the earliest non-empty level-0 slot, level-1 slot (to be cascaded),
+       * or the next overflow cascade, whichever comes first.  Erased items are not accounted
+       * for until the next advance(), so the wheel may be advanced earlier than necessary.
+       */
+      inline Time
+      next_tick() const
+      {
+        return TimeStep(std::max(next_tick_, current_tick_ + 1) * granularity_.GetTimeStep());
+      }
+
+      /**
+       * @brief Advance the wheel up to @p now, moving all items whose expiry tick has passed
+       *        into the list of due items (see due())
+       */
+      inline void
+      advance(const Time& now)
+      {
+        roll(now);
+        next_tick_ = find_next_tick();
+      }
+
+      /**
+       * @brief Items found stale by the last advance() call
+       *
+       * Items leave this list when they are erased from the policy
+       */
+      inline slot_type&
+      due()
+      {
+        return due_;
+      }
+
+      inline size_t
+      size() const
+      {
+        return size_;
+      }
+
+      inline bool
+      empty() const
+      {
+        return size_ == 0;
+      }
+
     private:
       type()
         : base_(*((Base*)0)){};
 
+      static const uint64_t NO_TICK = std::numeric_limits<uint64_t>::max();
+
+      inline void
+      roll(const Time& now)
+      {
+        uint64_t target = now.GetTimeStep() / granularity_.GetTimeStep();
+        while (current_tick_ < target) {
+          ++current_tick_;
+
+          if (current_tick_ % (LEVEL0_SLOTS * LEVEL1_SLOTS) == 0)
+            cascade(overflow_);
+          if (current_tick_ % LEVEL0_SLOTS == 0)
+            cascade(level1_[(current_tick_ / LEVEL0_SLOTS) % LEVEL1_SLOTS]);
+
+          due_.splice(due_.end(), level0_[current_tick_ % LEVEL0_SLOTS]);
+        }
+      }
+
+      inline uint64_t
+      find_next_tick() const
+      {
+        uint64_t next = NO_TICK;
+
+        // level-0 slots hold items expiring within the next LEVEL0_SLOTS - 1 ticks
+        for (uint64_t tick = current_tick_ + 1; tick < current_tick_ + LEVEL0_SLOTS; ++tick) {
+          if (!level0_[tick % LEVEL0_SLOTS].empty()) {
+            next = tick;
+            break;
+          }
+        }
+
+        // a level-1 slot is cascaded at the first tick of its block
+        uint64_t block = current_tick_ / LEVEL0_SLOTS;
+        for (uint64_t i = 1; i <= LEVEL1_SLOTS; ++i) {
+          if (!level1_[(block + i) % LEVEL1_SLOTS].empty()) {
+            next = std::min(next, (block + i) * LEVEL0_SLOTS);
+            break;
+          }
+        }
+
+        if (!overflow_.empty()) {
+          uint64_t round = LEVEL0_SLOTS * LEVEL1_SLOTS;
+          next = std::min(next, (current_tick_ / round + 1) * round);
+        }
+
+        return next;
+      }
+
+      inline void
+      place(Container& item)
+      {
+        const Time& expire = get_freshness(&item);
+        uint64_t step = granularity_.GetTimeStep();
+        uint64_t tick = (expire.GetTimeStep() + step - 1) / step;
+
+        uint64_t round = LEVEL0_SLOTS * LEVEL1_SLOTS;
+        if (tick <= current_tick_) {
+          due_.push_back(item);
+        }
+        else if (tick - current_tick_ < LEVEL0_SLOTS) {
+          level0_[tick % LEVEL0_SLOTS].push_back(item);
+          next_tick_ = std::min(next_tick_, tick);
+        }
+        else if (tick - current_tick_ < round) {
+          level1_[(tick / LEVEL0_SLOTS) % LEVEL1_SLOTS].push_back(item);
+          next_tick_ = std::min(next_tick_, tick / LEVEL0_SLOTS * LEVEL0_SLOTS);
+        }
+        else {
+          overflow_.push_back(item);
+          next_tick_ = std::min(next_tick_, (current_tick_ / round + 1) * round);
+        }
+      }
+
+      inline void
+      cascade(slot_type& slot)
+      {
+        slot_type pending;
+        pending.splice(pending.end(), slot);
+        while (!pending.empty()) {
+          Container& item = pending.front();
+          pending.pop_front();
+          place(item);
+        }
+      }
+
     private:
       Base& base_;
       size_t max_size_;
+
+      Time granularity_;
+      uint64_t current_tick_;
+      uint64_t next_tick_; ///< @brief lower bound of the tick at which advance() is needed
+      size_t size_;
+
+      std::vector<slot_type> level0_;
+      std::vector<slot_type> level1_;
+      slot_type overflow_;
+      slot_type due_;
     };
   };
 };
@@ -26,16 +26,88 @@
 #include "ns3/simulator.h"
 
 #include "apps/ndn-app.hpp"
+#include "ndn-l3-protocol.hpp"
 
 NS_LOG_COMPONENT_DEFINE("ndn.AppFace");
 
 namespace ns3 {
 namespace ndn {
 
+AppFaceDispatcher::Guard::Guard(AppFaceDispatcher* dispatcher)
+  : m_dispatcher(dispatcher)
+{
+  if (m_dispatcher != nullptr)
+    m_dispatcher->m_depth++;
+}
+
+AppFaceDispatcher::Guard::~Guard()
+{
+  if (m_dispatcher == nullptr)
+    return;
+
+  m_dispatcher->m_depth--;
+  if (m_dispatcher->m_depth == 0)
+    m_dispatcher->dispatch();
+}
+
+AppFaceDispatcher::AppFaceDispatcher()
+  : m_depth(0)
+{
+}
+
+AppFaceDispatcher::~AppFaceDispatcher()
+{
+  m_dispatchEvent.Cancel();
+}
+
+void
+AppFaceDispatcher::deliver(Ptr<App> app, shared_ptr<const Interest> interest)
+{
+  m_queue.push_back(Delivery{app, interest, nullptr});
+
+  if (m_depth == 0 && !m_dispatchEvent.IsRunning())
+    m_dispatchEvent = Simulator::ScheduleNow(&AppFaceDispatcher::dispatchScheduled, this);
+}
+
+void
+AppFaceDispatcher::deliver(Ptr<App> app, shared_ptr<const Data> data)
+{
+  m_queue.push_back(Delivery{app, nullptr, data});
+
+  if (m_depth == 0 && !m_dispatchEvent.IsRunning())
+    m_dispatchEvent = Simulator::ScheduleNow(&AppFaceDispatcher::dispatchScheduled, this);
+}
+
+void
+AppFaceDispatcher::dispatch()
+{
+  // packets that the applications send meanwhile are queued and dispatched by this loop, after
+  // the application callback has returned
+  m_depth++;
+  while (!m_queue.empty()) {
+    Delivery delivery = std::move(m_queue.front());
+    m_queue.pop_front();
+
+    if (delivery.interest != nullptr)
+      delivery.app->OnInterest(delivery.interest);
+    else
+      delivery.app->OnData(delivery.data);
+  }
+  m_depth--;
+}
+
+void
+AppFaceDispatcher::dispatchScheduled()
+{
+  if (m_depth == 0)
+    dispatch();
+}
+
 AppFace::AppFace(Ptr<App> app)
   : LocalFace(FaceUri("appFace://"), FaceUri("appFace://"))
   , m_node(app->GetNode())
   , m_app(app)
+  , m_dispatcher(m_node->GetObject<L3Protocol>()->getAppFaceDispatcher())
 {
   NS_LOG_FUNCTION(this << app);
 
@@ -53,6 +125,12 @@ AppFace::close()
   this->fail("Close connection");
 }
 
+Ptr<App>
+AppFace::GetApp() const
+{
+  return m_app;
+}
+
 void
 AppFace::sendInterest(const Interest& interest)
 {
@@ -61,7 +139,10 @@ AppFace::sendInterest(const Interest& interest)
   this->emitSignal(onSendInterest, interest);
 
   // to decouple callbacks
-  Simulator::ScheduleNow(&App::OnInterest, m_app, interest.shared_from_this());
+  if (m_dispatcher != nullptr)
+    m_dispatcher->deliver(m_app, interest.shared_from_this());
+  else
+    Simulator::ScheduleNow(&App::OnInterest, m_app, interest.shared_from_this());
 }
 
 void
@@ -72,7 +153,10 @@ AppFace::sendData(const Data& data)
   this->emitSignal(onSendData, data);
 
   // to decouple callbacks
-  Simulator::ScheduleNow(&App::OnData, m_app, data.shared_from_this());
+  if (m_dispatcher != nullptr)
+    m_dispatcher->deliver(m_app, data.shared_from_this());
+  else
+    Simulator::ScheduleNow(&App::OnData, m_app, data.shared_from_this());
 }
 
 void
@@ -24,6 +24,12 @@
 #include "ns3/ndnSIM/NFD/daemon/face/local-face.hpp"
 #include "ns3/ndnSIM/model/ndn-face.hpp"
 
+#include "ns3/event-id.h"
+
+#include <deque>
+
+#include <boost/noncopyable.hpp>
+
 namespace ns3 {
 
 class Packet;
@@ -33,6 +39,76 @@ namespace ndn {
 
 class App;
 
+/**
+ * \ingroup ndn-face
+ * \brief Per-node queue of packets towards applications (direct AppFace dispatch)
+ *
+ * Packets for applications cannot be delivered while the forwarder is still processing the
+ * packet that produced them, as the application may immediately call back into the forwarder.
+ * Instead of scheduling one event per packet, NetDeviceFace::receive holds a Guard, and packets
+ * queued meanwhile are delivered in FIFO order as soon as the Guard is released, i.e., still
+ * within the same simulation event.  Packets that the applications send while being dispatched
+ * are queued and processed by the same loop once the application callback has returned.
+ *
+ * Packets sent by applications outside of a dispatch loop (e.g., from a timer), as well as
+ * packets queued by forwarder timers, are delivered by a single scheduled event per batch, so an
+ * application is never called back from within its own call into the forwarder.
+ *
+ * \see L3Protocol attribute DirectAppFaceDispatch
+ */
+class AppFaceDispatcher : boost::noncopyable {
+public:
+  /**
+   * \brief Marks processing of a packet from the network (no-op for nullptr dispatcher)
+   */
+  class Guard : boost::noncopyable {
+  public:
+    explicit Guard(AppFaceDispatcher* dispatcher);
+
+    ~Guard();
+
+  private:
+    AppFaceDispatcher* m_dispatcher;
+  };
+
+  AppFaceDispatcher();
+
+  ~AppFaceDispatcher();
+
+  /**
+   * \brief Queue Interest for delivery to application
+   */
+  void
+  deliver(Ptr<App> app, shared_ptr<const Interest> interest);
+
+  /**
+   * \brief Queue Data for delivery to application
+   */
+  void
+  deliver(Ptr<App> app, shared_ptr<const Data> data);
+
+private:
+  /**
+   * \brief Deliver all queued packets
+   */
+  void
+  dispatch();
+
+  void
+  dispatchScheduled();
+
+private:
+  struct Delivery {
+    Ptr<App> app;
+    shared_ptr<const Interest> interest; ///< @brief nullptr for Data
+    shared_ptr<const Data> data;
+  };
+
+  std::deque<Delivery> m_queue;
+  uint32_t m_depth;        ///< @brief number of active Guards (or dispatch loops)
+  EventId m_dispatchEvent; ///< @brief dispatch of packets queued without Guard
+};
+
 /**
  * \ingroup ndn-face
  * \brief Implementation of application Ndn face
@@ -80,9 +156,16 @@ public: // from nfd::Face
   virtual void
   close();
 
+  /**
+   * @brief Get the application attached to the face
+   */
+  Ptr<App>
+  GetApp() const;
+
 private:
   Ptr<Node> m_node;
   Ptr<App> m_app;
+  AppFaceDispatcher* m_dispatcher; ///< @brief nullptr, unless direct dispatch is enabled
 };
 
 } // namespace ndn
@@ -0,0 +1,197 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-fib-snapshot.hpp"
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+
+#include "ns3/ndnSIM/NFD/daemon/table/fib.hpp"
+
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE("ndn.FibSnapshot");
+
+namespace ns3 {
+namespace ndn {
+
+// FNV-1a parameters
+static const uint64_t HASH_OFFSET_BASIS = 14695981039346656037ULL;
+static const uint64_t HASH_PRIME = 1099511628211ULL;
+
+// names up to this length are hashed without a heap allocation
+static const size_t MAX_STACK_COMPONENTS = 32;
+
+static inline uint64_t
+getSlot(uint64_t hash, uint64_t mask)
+{
+  return ((hash * 0x9E3779B97F4A7C15ULL) >> 32) & mask;
+}
+
+FibSnapshot::FibSnapshot(const nfd::Fib& fib)
+{
+  size_t nNextHops = 0;
+  for (const auto& entry : fib) {
+    nNextHops += entry.getNextHops().size();
+  }
+
+  // entries point into m_nextHops, so it must not be reallocated while filling
+  m_nextHops.reserve(nNextHops);
+  m_entries.reserve(fib.size());
+
+  std::vector<size_t> counts;
+  for (const auto& entry : fib) {
+    const Name& prefix = entry.getPrefix();
+
+    Entry compiled;
+    compiled.m_hash = HASH_OFFSET_BASIS;
+    for (const auto& component : prefix) {
+      compiled.m_hash = hashComponent(compiled.m_hash, component);
+    }
+    compiled.m_prefix = prefix;
+    compiled.m_nNextHops = entry.getNextHops().size();
+    compiled.m_nextHops = m_nextHops.data() + m_nextHops.size();
+
+    for (const auto& nextHop : entry.getNextHops()) {
+      m_nextHops.push_back(NextHop{nextHop.getFace()->getId(), nextHop.getCost()});
+    }
+    m_entries.push_back(compiled);
+
+    if (counts.size() <= prefix.size())
+      counts.resize(prefix.size() + 1, 0);
+    counts[prefix.size()]++;
+  }
+
+  m_tables.resize(counts.size());
+  for (size_t length = 0; length < counts.size(); length++) {
+    if (counts[length] == 0) {
+      m_tables[length].mask = 0;
+      continue;
+    }
+
+    // keep load factor at or below 1/2
+    uint64_t capacity = 2;
+    while (capacity < 2 * counts[length])
+      capacity <<= 1;
+
+    m_tables[length].mask = capacity - 1;
+    m_tables[length].slots.assign(capacity, 0);
+  }
+
+  for (size_t i = 0; i < m_entries.size(); i++) {
+    const Entry& entry = m_entries[i];
+    Table& table = m_tables[entry.m_prefix.size()];
+
+    // prefixes with colliding hashes simply occupy different slots
+    uint64_t slot = getSlot(entry.m_hash, table.mask);
+    while (table.slots[slot] != 0) {
+      slot = (slot + 1) & table.mask;
+    }
+    table.slots[slot] = i + 1;
+  }
+
+  NS_LOG_DEBUG("Compiled " << m_entries.size() << " FIB entries (" << m_nextHops.size()
+                           << " next hops) into " << getMemoryUsage() << " bytes");
+}
+
+const FibSnapshot::Entry*
+FibSnapshot::findLongestPrefixMatch(const Name& name) const
+{
+  if (m_tables.empty())
+    return nullptr;
+
+  size_t maxLength = std::min(name.size(), m_tables.size() - 1);
+
+  uint64_t stackHashes[MAX_STACK_COMPONENTS + 1];
+  std::vector<uint64_t> heapHashes;
+  uint64_t* hashes = stackHashes;
+  if (maxLength > MAX_STACK_COMPONENTS) {
+    heapHashes.resize(maxLength + 1);
+    hashes = heapHashes.data();
+  }
+
+  hashes[0] = HASH_OFFSET_BASIS;
+  for (size_t i = 0; i < maxLength; i++) {
+    hashes[i + 1] = hashComponent(hashes[i], name.get(i));
+  }
+
+  for (size_t length = maxLength + 1; length-- > 0;) {
+    const Entry* entry = find(name, length, hashes[length]);
+    if (entry != nullptr)
+      return entry;
+  }
+  return nullptr;
+}
+
+size_t
+FibSnapshot::getMemoryUsage() const
+{
+  size_t bytes = sizeof(FibSnapshot) + m_nextHops.capacity() * sizeof(NextHop)
+                 + m_entries.capacity() * sizeof(Entry) + m_tables.capacity() * sizeof(Table);
+  for (const auto& table : m_tables) {
+    bytes += table.slots.capacity() * sizeof(uint32_t);
+  }
+  for (const auto& entry : m_entries) {
+    bytes += entry.m_prefix.wireEncode().size();
+  }
+  return bytes;
+}
+
+uint64_t
+FibSnapshot::hashComponent(uint64_t hash, const name::Component& component)
+{
+  // component type is included to tell apart, e.g., generic and implicit digest components
+  uint32_t type = component.type();
+  for (size_t i = 0; i < sizeof(type); i++) {
+    hash = (hash ^ ((type >> (8 * i)) & 0xFF)) * HASH_PRIME;
+  }
+
+  // length prefix, so that /a/bc and /ab/c produce different chains
+  uint64_t length = component.value_size();
+  for (size_t i = 0; i < sizeof(length); i++) {
+    hash = (hash ^ ((length >> (8 * i)) & 0xFF)) * HASH_PRIME;
+  }
+
+  const uint8_t* value = component.value();
+  for (size_t i = 0; i < component.value_size(); i++) {
+    hash = (hash ^ value[i]) * HASH_PRIME;
+  }
+  return hash;
+}
+
+const FibSnapshot::Entry*
+FibSnapshot::find(const Name& name, size_t prefixLength, uint64_t hash) const
+{
+  const Table& table = m_tables[prefixLength];
+  if (table.slots.empty())
+    return nullptr;
+
+  uint64_t slot = getSlot(hash, table.mask);
+  while (table.slots[slot] != 0) {
+    const Entry& entry = m_entries[table.slots[slot] - 1];
+    if (entry.m_hash == hash && entry.m_prefix.isPrefixOf(name))
+      return &entry;
+    slot = (slot + 1) & table.mask;
+  }
+  return nullptr;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,161 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_FIB_SNAPSHOT_HPP
+#define NDN_FIB_SNAPSHOT_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/model/ndn-face.hpp"
+
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+namespace nfd {
+class Fib;
+} // namespace nfd
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \ingroup ndn
+ * \brief Immutable copy of a node's FIB for longest prefix match lookups
+ *
+ * The snapshot is compiled from nfd::Fib into one open-addressing hash table per prefix
+ * length, keyed by a 64-bit hash of the prefix name components.  Next hops of all entries
+ * share a single array and reference faces by FaceId.
+ *
+ * A lookup hashes the name once, component by component, and then probes the tables from the
+ * longest present prefix length down.  The prefix of an entry with a matching hash is compared
+ * with the name, so hash collisions do not cause false matches.
+ *
+ * The snapshot is kept in addition to nfd::Fib, which the forwarder keeps using for its own
+ * lookups.  It serves ndnSIM-side analysis (e.g., SegmentTransferModel), it does not reduce
+ * the memory or speed up the forwarding of the node.
+ *
+ * \see L3Protocol::freezeFib
+ */
+class FibSnapshot : boost::noncopyable {
+public:
+  struct NextHop {
+    nfd::FaceId faceId;
+    uint64_t cost;
+  };
+
+  class Entry {
+  public:
+    /**
+     * \brief Number of name components in the entry's prefix
+     */
+    size_t
+    getPrefixLength() const
+    {
+      return m_prefix.size();
+    }
+
+    const Name&
+    getPrefix() const
+    {
+      return m_prefix;
+    }
+
+    /**
+     * \brief Next hops of the entry, ordered by cost (same order as in nfd::fib::Entry)
+     */
+    const NextHop*
+    begin() const
+    {
+      return m_nextHops;
+    }
+
+    const NextHop*
+    end() const
+    {
+      return m_nextHops + m_nNextHops;
+    }
+
+    size_t
+    size() const
+    {
+      return m_nNextHops;
+    }
+
+  private:
+    friend class FibSnapshot;
+
+    uint64_t m_hash;
+    Name m_prefix;
+    uint32_t m_nNextHops;
+    const NextHop* m_nextHops;
+  };
+
+  /**
+   * \brief Compile snapshot of the current state of @p fib
+   */
+  explicit FibSnapshot(const nfd::Fib& fib);
+
+  /**
+   * \brief Find entry with the longest prefix of @p name
+   * \return pointer to the entry (valid as long as the snapshot exists) or nullptr
+   */
+  const Entry*
+  findLongestPrefixMatch(const Name& name) const;
+
+  /**
+   * \brief Number of FIB entries in the snapshot
+   */
+  size_t
+  size() const
+  {
+    return m_entries.size();
+  }
+
+  /**
+   * \brief Approximate number of bytes allocated by the snapshot
+   */
+  size_t
+  getMemoryUsage() const;
+
+private:
+  static uint64_t
+  hashComponent(uint64_t hash, const name::Component& component);
+
+  /**
+   * \brief Find entry with the prefix of @p name of @p prefixLength components
+   */
+  const Entry*
+  find(const Name& name, size_t prefixLength, uint64_t hash) const;
+
+private:
+  struct Table {
+    uint64_t mask;
+    std::vector<uint32_t> slots; ///< @brief index in m_entries + 1, 0 for an empty slot
+  };
+
+  std::vector<NextHop> m_nextHops;
+  std::vector<Entry> m_entries;
+  std::vector<Table> m_tables; ///< @brief tables indexed by prefix length
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_FIB_SNAPSHOT_HPP
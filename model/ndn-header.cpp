@@ -19,15 +19,60 @@
 
 #include "ndn-header.hpp"
 
-#include <iosfwd>
-#include <boost/iostreams/concepts.hpp>
-#include <boost/iostreams/stream.hpp>
-
-namespace io = boost::iostreams;
+#include <ndn-cxx/encoding/buffer.hpp>
 
 namespace ns3 {
 namespace ndn {
 
+static uint32_t
+sizeOfVarNumber(uint64_t number)
+{
+  return number < 253 ? 1 : number <= 0xFFFF ? 3 : number <= 0xFFFFFFFF ? 5 : 9;
+}
+
+static void
+writeVarNumber(ns3::Buffer::Iterator& i, uint64_t number)
+{
+  if (number < 253) {
+    i.WriteU8(number);
+  }
+  else if (number <= 0xFFFF) {
+    i.WriteU8(253);
+    i.WriteHtonU16(number);
+  }
+  else if (number <= 0xFFFFFFFF) {
+    i.WriteU8(254);
+    i.WriteHtonU32(number);
+  }
+  else {
+    i.WriteU8(255);
+    i.WriteHtonU64(number);
+  }
+}
+
+static uint64_t
+readVarNumber(ns3::Buffer::Iterator& i)
+{
+  if (i.GetRemainingSize() < 1)
+    throw ::ndn::tlv::Error("Truncated VAR-NUMBER");
+
+  uint8_t first = i.ReadU8();
+  uint32_t size = first < 253 ? 0 : first == 253 ? 2 : first == 254 ? 4 : 8;
+  if (i.GetRemainingSize() < size)
+    throw ::ndn::tlv::Error("Truncated VAR-NUMBER");
+
+  switch (first) {
+  case 253:
+    return i.ReadNtohU16();
+  case 254:
+    return i.ReadNtohU32();
+  case 255:
+    return i.ReadNtohU64();
+  default:
+    return first;
+  }
+}
+
 template<>
 ns3::TypeId
 PacketHeader<Interest>::GetTypeId()
@@ -87,41 +132,26 @@ PacketHeader<Pkt>::Serialize(ns3::Buffer::Iterator start) const
   start.Write(m_packet->wireEncode().wire(), m_packet->wireEncode().size());
 }
 
-class Ns3BufferIteratorSource : public io::source {
-public:
-  Ns3BufferIteratorSource(ns3::Buffer::Iterator& is)
-    : m_is(is)
-  {
-  }
-
-  std::streamsize
-  read(char* buf, std::streamsize nMaxRead)
-  {
-    std::streamsize i = 0;
-    for (; i < nMaxRead && !m_is.IsEnd(); ++i) {
-      buf[i] = m_is.ReadU8();
-    }
-    if (i == 0) {
-      return -1;
-    }
-    else {
-      return i;
-    }
-  }
-
-private:
-  ns3::Buffer::Iterator& m_is;
-};
-
 template<class Pkt>
 uint32_t
 PacketHeader<Pkt>::Deserialize(ns3::Buffer::Iterator start)
 {
+  // Block::fromStream refuses blocks larger than MAX_NDN_PACKET_SIZE, while packets
+  // reassembled from link-layer fragments can be larger
+  ns3::Buffer::Iterator i = start;
+  readVarNumber(i); // type
+  uint64_t length = readVarNumber(i);
+  if (length > i.GetRemainingSize())
+    throw ::ndn::tlv::Error("TLV length exceeds the packet size");
+  uint32_t size = i.GetDistanceFrom(start) + length;
+
+  auto buffer = make_shared< ::ndn::Buffer>(size);
+  start.Read(buffer->buf(), size);
+
   auto packet = make_shared<Pkt>();
-  io::stream<Ns3BufferIteratorSource> is(start);
-  packet->wireDecode(::ndn::Block::fromStream(is));
+  packet->wireDecode(::ndn::Block(buffer));
   m_packet = packet;
-  return packet->wireEncode().size();
+  return size;
 }
 
 template<>
@@ -145,6 +175,171 @@ PacketHeader<Pkt>::getPacket()
   return m_packet;
 }
 
+NS_OBJECT_ENSURE_REGISTERED(LpFragmentHeader);
+
+TypeId
+LpFragmentHeader::GetTypeId()
+{
+  static ns3::TypeId tid =
+    ns3::TypeId("ns3::ndn::LpFragmentHeader")
+    .SetGroupName("Ndn")
+    .SetParent<Header>()
+    .AddConstructor<LpFragmentHeader>()
+    ;
+  return tid;
+}
+
+TypeId
+LpFragmentHeader::GetInstanceTypeId(void) const
+{
+  return GetTypeId();
+}
+
+LpFragmentHeader::LpFragmentHeader()
+  : m_sequence(0)
+  , m_fragIndex(0)
+  , m_fragCount(1)
+  , m_fragmentSize(0)
+{
+}
+
+LpFragmentHeader::LpFragmentHeader(uint64_t sequence, uint64_t fragIndex, uint64_t fragCount,
+                                   uint32_t fragmentSize)
+  : m_sequence(sequence)
+  , m_fragIndex(fragIndex)
+  , m_fragCount(fragCount)
+  , m_fragmentSize(fragmentSize)
+{
+}
+
+static uint32_t
+sizeOfNonNegativeInteger(uint64_t number)
+{
+  return number <= 0xFF ? 1 : number <= 0xFFFF ? 2 : number <= 0xFFFFFFFF ? 4 : 8;
+}
+
+static void
+writeNonNegativeIntegerField(ns3::Buffer::Iterator& i, uint32_t type, uint64_t number)
+{
+  uint32_t size = sizeOfNonNegativeInteger(number);
+  writeVarNumber(i, type);
+  writeVarNumber(i, size);
+  switch (size) {
+  case 1:
+    i.WriteU8(number);
+    break;
+  case 2:
+    i.WriteHtonU16(number);
+    break;
+  case 4:
+    i.WriteHtonU32(number);
+    break;
+  default:
+    i.WriteHtonU64(number);
+  }
+}
+
+static uint64_t
+readNonNegativeIntegerField(ns3::Buffer::Iterator& i, uint32_t type)
+{
+  if (readVarNumber(i) != type) {
+    throw ::ndn::tlv::Error("Unexpected field in LpPacket");
+  }
+
+  uint64_t length = readVarNumber(i);
+  if (length > i.GetRemainingSize()) {
+    throw ::ndn::tlv::Error("Truncated NonNegativeInteger");
+  }
+
+  switch (length) {
+  case 1:
+    return i.ReadU8();
+  case 2:
+    return i.ReadNtohU16();
+  case 4:
+    return i.ReadNtohU32();
+  case 8:
+    return i.ReadNtohU64();
+  default:
+    throw ::ndn::tlv::Error("Invalid length of NonNegativeInteger");
+  }
+}
+
+uint32_t
+LpFragmentHeader::getFieldsSize() const
+{
+  return 2 + 8 // Sequence is always 8 octets
+    + 2 + sizeOfNonNegativeInteger(m_fragIndex)
+    + 2 + sizeOfNonNegativeInteger(m_fragCount)
+    + 1 + sizeOfVarNumber(m_fragmentSize);
+}
+
+uint32_t
+LpFragmentHeader::GetSerializedSize(void) const
+{
+  uint32_t length = getFieldsSize() + m_fragmentSize;
+  return 1 + sizeOfVarNumber(length) + getFieldsSize();
+}
+
+void
+LpFragmentHeader::Serialize(ns3::Buffer::Iterator start) const
+{
+  writeVarNumber(start, TLV_LP_PACKET);
+  writeVarNumber(start, getFieldsSize() + m_fragmentSize);
+
+  writeVarNumber(start, TLV_SEQUENCE);
+  writeVarNumber(start, 8);
+  start.WriteHtonU64(m_sequence);
+
+  writeNonNegativeIntegerField(start, TLV_FRAG_INDEX, m_fragIndex);
+  writeNonNegativeIntegerField(start, TLV_FRAG_COUNT, m_fragCount);
+
+  writeVarNumber(start, TLV_FRAGMENT);
+  writeVarNumber(start, m_fragmentSize);
+}
+
+uint32_t
+LpFragmentHeader::Deserialize(ns3::Buffer::Iterator start)
+{
+  ns3::Buffer::Iterator i = start;
+  if (readVarNumber(i) != TLV_LP_PACKET) {
+    throw ::ndn::tlv::Error("Not an LpPacket");
+  }
+  readVarNumber(i); // length, includes the fragment
+
+  if (readVarNumber(i) != TLV_SEQUENCE || readVarNumber(i) != 8) {
+    throw ::ndn::tlv::Error("LpPacket without Sequence");
+  }
+  if (i.GetRemainingSize() < 8) {
+    throw ::ndn::tlv::Error("Truncated Sequence");
+  }
+  m_sequence = i.ReadNtohU64();
+
+  m_fragIndex = readNonNegativeIntegerField(i, TLV_FRAG_INDEX);
+  m_fragCount = readNonNegativeIntegerField(i, TLV_FRAG_COUNT);
+  if (m_fragIndex >= m_fragCount) {
+    throw ::ndn::tlv::Error("FragIndex is out of range");
+  }
+
+  if (readVarNumber(i) != TLV_FRAGMENT) {
+    throw ::ndn::tlv::Error("LpPacket without Fragment");
+  }
+  uint64_t fragmentSize = readVarNumber(i);
+  if (fragmentSize > i.GetRemainingSize()) {
+    throw ::ndn::tlv::Error("Fragment exceeds the packet size");
+  }
+  m_fragmentSize = fragmentSize;
+
+  return i.GetDistanceFrom(start);
+}
+
+void
+LpFragmentHeader::Print(std::ostream& os) const
+{
+  os << "LP: seq=" << m_sequence << " frag=" << m_fragIndex << "/" << m_fragCount
+     << " size=" << m_fragmentSize;
+}
+
 typedef PacketHeader<Interest> InterestHeader;
 typedef PacketHeader<Data> DataHeader;
 
@@ -46,6 +46,10 @@ public:
   virtual void
   Serialize(ns3::Buffer::Iterator start) const;
 
+  /**
+   * \throws ::ndn::tlv::Error if the buffer is shorter than the TLV length or the packet cannot
+   *         be decoded
+   */
   virtual uint32_t
   Deserialize(ns3::Buffer::Iterator start);
 
@@ -59,6 +63,92 @@ private:
   shared_ptr<const Pkt> m_packet;
 };
 
+/**
+ * \ingroup ndn-face
+ * \brief NDNLP fragmentation header
+ *
+ * Encodes LpPacket TLV with Sequence, FragIndex, FragCount fields and the type and length of the
+ * Fragment field.  The fragment itself is the payload of the ns-3 packet following the header,
+ * so the header and the payload together form a valid NDNLPv2 LpPacket on the wire.
+ *
+ * Fragments of one network-layer packet carry consecutive sequence numbers, starting from
+ * (Sequence - FragIndex).
+ */
+class LpFragmentHeader : public Header {
+public:
+  enum {
+    TLV_LP_PACKET = 100,
+    TLV_FRAGMENT = 80,
+    TLV_SEQUENCE = 81,
+    TLV_FRAG_INDEX = 82,
+    TLV_FRAG_COUNT = 83
+  };
+
+  /// \brief upper bound of GetSerializedSize() for fragments smaller than 64 KB
+  static const uint32_t MAX_SERIALIZED_SIZE = 6 + 10 + 10 + 10 + 4;
+
+  static ns3::TypeId
+  GetTypeId();
+
+  virtual TypeId
+  GetInstanceTypeId(void) const;
+
+  LpFragmentHeader();
+
+  LpFragmentHeader(uint64_t sequence, uint64_t fragIndex, uint64_t fragCount,
+                   uint32_t fragmentSize);
+
+  virtual uint32_t
+  GetSerializedSize(void) const;
+
+  virtual void
+  Serialize(ns3::Buffer::Iterator start) const;
+
+  /**
+   * \throws ::ndn::tlv::Error if the header is not an LpPacket with fragmentation fields
+   */
+  virtual uint32_t
+  Deserialize(ns3::Buffer::Iterator start);
+
+  virtual void
+  Print(std::ostream& os) const;
+
+  uint64_t
+  getSequence() const
+  {
+    return m_sequence;
+  }
+
+  uint64_t
+  getFragIndex() const
+  {
+    return m_fragIndex;
+  }
+
+  uint64_t
+  getFragCount() const
+  {
+    return m_fragCount;
+  }
+
+  uint32_t
+  getFragmentSize() const
+  {
+    return m_fragmentSize;
+  }
+
+private:
+  /// \brief size of the LpPacket value, without the fragment payload
+  uint32_t
+  getFieldsSize() const;
+
+private:
+  uint64_t m_sequence;
+  uint64_t m_fragIndex;
+  uint64_t m_fragCount;
+  uint32_t m_fragmentSize;
+};
+
 } // namespace ndn
 } // namespace ns3
 
@@ -24,6 +24,8 @@
 #include "ns3/log.h"
 #include "ns3/callback.h"
 #include "ns3/uinteger.h"
+#include "ns3/boolean.h"
+#include "ns3/string.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/object-vector.h"
 #include "ns3/pointer.h"
@@ -32,6 +34,8 @@
 #include "ndn-face.hpp"
 
 #include "ndn-net-device-face.hpp"
+#include "ndn-app-face.hpp"
+#include "ndn-fib-snapshot.hpp"
 #include "../helper/ndn-stack-helper.hpp"
 #include "cs/ndn-content-store.hpp"
 
@@ -69,6 +73,30 @@ L3Protocol::GetTypeId(void)
       .SetParent<Object>()
       .AddConstructor<L3Protocol>()
 
+      .AddAttribute("DirectAppFaceDispatch",
+                    "Deliver packets to applications at the end of the forwarder's processing "
+                    "instead of scheduling one event per packet",
+                    BooleanValue(false),
+                    MakeBooleanAccessor(&L3Protocol::m_isDirectAppFaceDispatch),
+                    MakeBooleanChecker())
+
+      .AddAttribute("Fragmentation",
+                    "Split packets larger than the NetDevice MTU into NDNLP fragments "
+                    "(reassembly is always enabled)",
+                    BooleanValue(false),
+                    MakeBooleanAccessor(&L3Protocol::m_isFragmentationEnabled),
+                    MakeBooleanChecker())
+      .AddAttribute("ReassemblyTimeout",
+                    "Time after which an incompletely received fragmented packet is dropped",
+                    StringValue("500ms"),
+                    MakeTimeAccessor(&L3Protocol::m_reassemblyTimeout),
+                    MakeTimeChecker())
+      .AddAttribute("MaxFragments",
+                    "Maximum number of fragments of a packet, packets announcing more are dropped",
+                    UintegerValue(64),
+                    MakeUintegerAccessor(&L3Protocol::m_maxFragments),
+                    MakeUintegerChecker<uint32_t>(2))
+
       .AddTraceSource("OutInterests", "OutInterests",
                       MakeTraceSourceAccessor(&L3Protocol::m_outInterests),
                       "ns3::ndn::L3Protocol::InterestTraceCallback")
@@ -91,6 +119,12 @@ L3Protocol::GetTypeId(void)
       .AddTraceSource("TimedOutInterests", "TimedOutInterests",
                       MakeTraceSourceAccessor(&L3Protocol::m_timedOutInterests),
                       "ns3::ndn::L3Protocol::TimedOutInterestsCallback")
+
+      ////////////////////////////////////////////////////////////////////
+
+      .AddTraceSource("FaceAdded", "Face has been added to the NDN stack (face ID is assigned)",
+                      MakeTraceSourceAccessor(&L3Protocol::m_faceAdded),
+                      "ns3::ndn::L3Protocol::FaceTraceCallback")
     ;
   return tid;
 }
@@ -167,10 +201,18 @@ private:
   nfd::ConfigSection m_config;
 
   Ptr<ContentStore> m_csFromNdnSim;
+
+  bool m_isFibFrozen = false;
+  shared_ptr<const FibSnapshot> m_fibSnapshot; ///< @brief nullptr if FIB is not frozen or modified
+
+  std::unique_ptr<AppFaceDispatcher> m_appFaceDispatcher;
 };
 
 L3Protocol::L3Protocol()
   : m_impl(new Impl())
+  , m_isDirectAppFaceDispatch(false)
+  , m_isFragmentationEnabled(false)
+  , m_maxFragments(64)
 {
   NS_LOG_FUNCTION(this);
 }
@@ -193,6 +235,11 @@ L3Protocol::initialize()
 
   m_impl->m_forwarder->getFaceTable().addReserved(make_shared<nfd::NullFace>(), nfd::FACEID_NULL);
 
+  // nexthops of a removed face are removed from all FIB entries
+  m_impl->m_forwarder->getFaceTable().onRemove.connect([this] (shared_ptr<Face>) {
+      this->invalidateFibSnapshot();
+    });
+
   m_impl->m_forwarder->beforeSatisfyInterest.connect(std::ref(m_satisfiedInterests));
   m_impl->m_forwarder->beforeExpirePendingInterest.connect(std::ref(m_timedOutInterests));
 }
@@ -227,6 +274,15 @@ L3Protocol::initializeManagement()
 
   m_impl->m_internalFace = make_shared<InternalFace>();
 
+  // FIB management commands (FibHelper, prefix registrations) are answered through the internal
+  // face once the FIB has been modified
+  nfd::Face& internalFace = *m_impl->m_internalFace;
+  internalFace.onReceiveData.connect([this] (const Data& data) {
+      static const Name fibManagementPrefix("/localhost/nfd/fib");
+      if (fibManagementPrefix.isPrefixOf(data.getName()))
+        this->invalidateFibSnapshot();
+    });
+
   m_impl->m_fibManager = make_shared<FibManager>(std::ref(forwarder->getFib()),
                                                  bind(&Forwarder::getFace, forwarder.get(), _1),
                                                  m_impl->m_internalFace, keyChain);
@@ -337,6 +393,62 @@ L3Protocol::getConfig()
   return m_impl->m_config;
 }
 
+void
+L3Protocol::freezeFib()
+{
+  m_impl->m_isFibFrozen = true;
+  m_impl->m_fibSnapshot = nullptr;
+}
+
+shared_ptr<const FibSnapshot>
+L3Protocol::getFibSnapshot()
+{
+  if (!m_impl->m_isFibFrozen)
+    return nullptr;
+
+  if (m_impl->m_fibSnapshot == nullptr) {
+    NS_LOG_DEBUG("Rebuilding FIB snapshot");
+    m_impl->m_fibSnapshot = make_shared<FibSnapshot>(m_impl->m_forwarder->getFib());
+  }
+  return m_impl->m_fibSnapshot;
+}
+
+void
+L3Protocol::invalidateFibSnapshot()
+{
+  m_impl->m_fibSnapshot = nullptr;
+}
+
+AppFaceDispatcher*
+L3Protocol::getAppFaceDispatcher()
+{
+  if (!m_isDirectAppFaceDispatch)
+    return nullptr;
+
+  if (m_impl->m_appFaceDispatcher == nullptr)
+    m_impl->m_appFaceDispatcher.reset(new AppFaceDispatcher());
+
+  return m_impl->m_appFaceDispatcher.get();
+}
+
+bool
+L3Protocol::isFragmentationEnabled() const
+{
+  return m_isFragmentationEnabled;
+}
+
+Time
+L3Protocol::getReassemblyTimeout() const
+{
+  return m_reassemblyTimeout;
+}
+
+uint32_t
+L3Protocol::getMaxFragments() const
+{
+  return m_maxFragments;
+}
+
 /*
  * This method is called by AddAgregate and completes the aggregation
  * by setting the node in the ndn stack
@@ -388,6 +500,8 @@ L3Protocol::addFace(shared_ptr<Face> face)
 
   face->onSendData.connect([this, face](const Data& data) { this->m_outData(data, *face); });
 
+  m_faceAdded(*face);
+
   return face->getId();
 }
 
@@ -405,13 +519,20 @@ L3Protocol::getFaceById(nfd::FaceId id) const
 
 shared_ptr<Face>
 L3Protocol::getFaceByNetDevice(Ptr<NetDevice> netDevice) const
+{
+  return getFaceByNetDevice(netDevice, Address());
+}
+
+shared_ptr<Face>
+L3Protocol::getFaceByNetDevice(Ptr<NetDevice> netDevice, const Address& remoteAddress) const
 {
   for (const auto& i : m_impl->m_forwarder->getFaceTable()) {
     shared_ptr<NetDeviceFace> netDeviceFace = std::dynamic_pointer_cast<NetDeviceFace>(i);
     if (netDeviceFace == nullptr)
       continue;
 
-    if (netDeviceFace->GetNetDevice() == netDevice)
+    if (netDeviceFace->GetNetDevice() == netDevice
+        && netDeviceFace->GetRemoteAddress() == remoteAddress)
       return i;
   }
   return nullptr;
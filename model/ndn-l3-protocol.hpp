@@ -51,6 +51,9 @@ class Header;
 
 namespace ndn {
 
+class FibSnapshot;
+class AppFaceDispatcher;
+
 /**
  * \defgroup ndn ndnSIM: NDN simulation module
  *
@@ -138,10 +141,75 @@ public:
 
   /**
    * \brief Get face for NetDevice
+   *
+   * On multi-access NetDevices, this is the face that transmits to the broadcast address
    */
   shared_ptr<Face>
   getFaceByNetDevice(Ptr<NetDevice> netDevice) const;
 
+  /**
+   * \brief Get unicast adjacency face for the neighbor with \p remoteAddress on NetDevice
+   */
+  shared_ptr<Face>
+  getFaceByNetDevice(Ptr<NetDevice> netDevice, const Address& remoteAddress) const;
+
+  /**
+   * \brief Switch node's FIB into the frozen mode
+   *
+   * In the frozen mode, the node's FIB is compiled into an immutable FibSnapshot, which is
+   * available through getFibSnapshot().  FIB mutations still go to the NFD FIB and invalidate
+   * the snapshot, which is then rebuilt on the next getFibSnapshot() call.  The snapshot is
+   * invalidated automatically after every FIB management command (FibHelper, prefix
+   * registrations of applications) and whenever a face is removed.
+   *
+   * \see FibHelper::Freeze
+   */
+  void
+  freezeFib();
+
+  /**
+   * \brief Get snapshot of node's FIB, or nullptr if FIB is not frozen
+   *
+   * A snapshot obtained earlier stays valid (but stale) after the FIB has been modified
+   */
+  shared_ptr<const FibSnapshot>
+  getFibSnapshot();
+
+  /**
+   * \brief Notify that NFD FIB has been modified and the snapshot needs to be rebuilt
+   *
+   * Only needed when nfd::Fib is modified directly, bypassing the FIB manager
+   */
+  void
+  invalidateFibSnapshot();
+
+  /**
+   * \brief Get the queue of packets towards node's applications
+   * \return nullptr, unless the DirectAppFaceDispatch attribute is set
+   *
+   * \see AppFaceDispatcher
+   */
+  AppFaceDispatcher*
+  getAppFaceDispatcher();
+
+  /**
+   * \brief Check whether NetDeviceFaces split packets larger than the MTU into fragments
+   */
+  bool
+  isFragmentationEnabled() const;
+
+  /**
+   * \brief Get time after which incomplete fragmented packets are dropped
+   */
+  Time
+  getReassemblyTimeout() const;
+
+  /**
+   * \brief Get maximum number of fragments that NetDeviceFaces reassemble into one packet
+   */
+  uint32_t
+  getMaxFragments() const;
+
   /**
    * \brief Get NFD config (boost::property_tree)
    */
@@ -158,6 +226,7 @@ public:
 
   typedef void (*SatisfiedInterestsCallback)(const nfd::pit::Entry& pitEntry, const Face& inFace, const Data& data);
   typedef void (*TimedOutInterestsCallback)(const nfd::pit::Entry& pitEntry);
+  typedef void (*FaceTraceCallback)(const Face& face);
 
 protected:
   virtual void
@@ -189,6 +258,11 @@ private:
   // These objects are aggregated, but for optimization, get them here
   Ptr<Node> m_node; ///< \brief node on which ndn stack is installed
 
+  bool m_isDirectAppFaceDispatch; ///< \brief deliver packets to apps through AppFaceDispatcher
+  bool m_isFragmentationEnabled; ///< \brief fragment packets larger than the NetDevice MTU
+  Time m_reassemblyTimeout; ///< \brief lifetime of partially received packets
+  uint32_t m_maxFragments;  ///< \brief limit of FragCount accepted by the reassembly
+
   TracedCallback<const Interest&, const Face&>
     m_inInterests; ///< @brief trace of incoming Interests
   TracedCallback<const Interest&, const Face&>
@@ -199,6 +273,8 @@ private:
 
   TracedCallback<const nfd::pit::Entry&, const Face&/*in face*/, const Data&> m_satisfiedInterests;
   TracedCallback<const nfd::pit::Entry&> m_timedOutInterests;
+
+  TracedCallback<const Face&> m_faceAdded; ///< @brief trace of faces added to the stack
 };
 
 } // namespace ndn
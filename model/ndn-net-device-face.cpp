@@ -19,13 +19,16 @@
 
 #include "ndn-net-device-face.hpp"
 #include "ndn-l3-protocol.hpp"
+#include "ndn-app-face.hpp"
 
 #include "ndn-ns3.hpp"
+#include "ndn-header.hpp"
 
 #include "ns3/net-device.h"
 #include "ns3/log.h"
 #include "ns3/packet.h"
 #include "ns3/node.h"
+#include "ns3/simulator.h"
 #include "ns3/pointer.h"
 
 // #include "ns3/address.h"
@@ -33,26 +36,107 @@
 #include "ns3/channel.h"
 
 #include "../utils/ndn-fw-hop-count-tag.hpp"
+#include "../utils/ndn-ns3-packet-tag.hpp"
+
+#include <algorithm>
 
 NS_LOG_COMPONENT_DEFINE("ndn.NetDeviceFace");
 
 namespace ns3 {
 namespace ndn {
 
+/**
+ * \brief Get size of the Interest or Data at the beginning of the packet
+ * \returns 0, if the packet does not start with a complete Interest or Data
+ */
+static uint32_t
+getPacketSize(Ptr<const Packet> packet)
+{
+  uint8_t buf[1 + 9];
+  uint32_t nRead = packet->CopyData(buf, sizeof(buf));
+  if (nRead < 2 || (buf[0] != ::ndn::tlv::Interest && buf[0] != ::ndn::tlv::Data))
+    return 0;
+
+  uint64_t length = buf[1];
+  uint32_t lengthSize = 1;
+  if (buf[1] == 253 && nRead >= 4) {
+    length = (buf[2] << 8) | buf[3];
+    lengthSize = 3;
+  }
+  else if (buf[1] == 254 && nRead >= 6) {
+    length = (uint32_t(buf[2]) << 24) | (buf[3] << 16) | (buf[4] << 8) | buf[5];
+    lengthSize = 5;
+  }
+  else if (buf[1] >= 253) {
+    return 0;
+  }
+
+  uint64_t size = 1 + lengthSize + length;
+  return size <= packet->GetSize() ? size : 0;
+}
+
 NetDeviceFace::NetDeviceFace(Ptr<Node> node, const Ptr<NetDevice>& netDevice)
   : Face(FaceUri("netDeviceFace://"), FaceUri("netDeviceFace://"))
   , m_node(node)
   , m_netDevice(netDevice)
+  , m_appFaceDispatcher(nullptr)
+  , m_isFragmentationEnabled(false)
+  , m_nextFragmentSequence(0)
+  , m_reassemblyTimeout(MilliSeconds(500))
+  , m_maxFragments(64)
+  , m_isInterestPackingEnabled(false)
+  , m_packedSize(0)
 {
   NS_LOG_FUNCTION(this << netDevice);
 
+  Ptr<L3Protocol> l3 = m_node->GetObject<L3Protocol>();
+  if (l3 != 0) {
+    m_appFaceDispatcher = l3->getAppFaceDispatcher();
+    m_isFragmentationEnabled = l3->isFragmentationEnabled();
+    m_reassemblyTimeout = l3->getReassemblyTimeout();
+    m_maxFragments = l3->getMaxFragments();
+  }
+
   setMetric(1); // default metric
 
   NS_ASSERT_MSG(m_netDevice != 0, "NetDeviceFace needs to be assigned a valid NetDevice");
+  m_destination = m_netDevice->GetBroadcast();
 
+  // frames unicast to other nodes on multi-access media are dropped by the NetDevice,
+  // before they are copied and decoded
   m_node->RegisterProtocolHandler(MakeCallback(&NetDeviceFace::receiveFromNetDevice, this),
                                   L3Protocol::ETHERNET_FRAME_TYPE, m_netDevice,
-                                  true /*promiscuous mode*/);
+                                  false /*promiscuous mode*/);
+}
+
+NetDeviceFace::NetDeviceFace(const shared_ptr<NetDeviceFace>& multicastFace,
+                             const Address& remoteAddress)
+  : Face(FaceUri("netDeviceFace://"), FaceUri("netDeviceFace://"))
+  , m_node(multicastFace->m_node)
+  , m_netDevice(multicastFace->m_netDevice)
+  , m_appFaceDispatcher(multicastFace->m_appFaceDispatcher)
+  , m_remoteAddress(remoteAddress)
+  , m_destination(remoteAddress)
+  , m_multicastFace(multicastFace)
+  , m_isFragmentationEnabled(multicastFace->m_isFragmentationEnabled)
+  , m_nextFragmentSequence(0)
+  , m_reassemblyTimeout(multicastFace->m_reassemblyTimeout)
+  , m_maxFragments(multicastFace->m_maxFragments)
+  , m_isInterestPackingEnabled(multicastFace->m_isInterestPackingEnabled)
+  , m_interestPackingInterval(multicastFace->m_interestPackingInterval)
+  , m_packedSize(0)
+{
+  NS_LOG_FUNCTION(this << m_netDevice << remoteAddress);
+
+  setMetric(1); // default metric
+
+  NS_ASSERT_MSG(!remoteAddress.IsInvalid(), "Unicast adjacency needs a valid neighbor address");
+  NS_ASSERT_MSG(multicastFace->m_remoteAddress.IsInvalid(),
+                "Unicast adjacency can only be created on top of the multicast face");
+  NS_ASSERT_MSG(multicastFace->m_adjacencies.count(remoteAddress) == 0,
+                "Unicast adjacency with " << remoteAddress << " already exists");
+
+  multicastFace->m_adjacencies[remoteAddress] = this;
 }
 
 NetDeviceFace::~NetDeviceFace()
@@ -64,7 +148,22 @@ NetDeviceFace::~NetDeviceFace()
 void
 NetDeviceFace::close()
 {
-  m_node->UnregisterProtocolHandler(MakeCallback(&NetDeviceFace::receiveFromNetDevice, this));
+  Simulator::Cancel(m_packingEvent);
+  m_packed.clear();
+  m_packedSize = 0;
+
+  Simulator::Cancel(m_reassemblyExpiryEvent);
+  m_partialPackets.clear();
+  m_partialPacketExpiry.clear();
+
+  if (m_remoteAddress.IsInvalid()) {
+    m_node->UnregisterProtocolHandler(MakeCallback(&NetDeviceFace::receiveFromNetDevice, this));
+  }
+  else {
+    shared_ptr<NetDeviceFace> multicastFace = m_multicastFace.lock();
+    if (multicastFace != nullptr)
+      multicastFace->m_adjacencies.erase(m_remoteAddress);
+  }
   this->fail("Close connection");
 }
 
@@ -74,19 +173,126 @@ NetDeviceFace::GetNetDevice() const
   return m_netDevice;
 }
 
+const Address&
+NetDeviceFace::GetRemoteAddress() const
+{
+  return m_remoteAddress;
+}
+
+size_t
+NetDeviceFace::GetNPartialPackets() const
+{
+  return m_partialPackets.size();
+}
+
+void
+NetDeviceFace::EnableInterestPacking(Time interval)
+{
+  NS_LOG_FUNCTION(this << interval);
+  m_isInterestPackingEnabled = true;
+  m_interestPackingInterval = interval;
+}
+
+void
+NetDeviceFace::DisableInterestPacking()
+{
+  NS_LOG_FUNCTION(this);
+  flushPacked();
+  m_isInterestPackingEnabled = false;
+}
+
 void
-NetDeviceFace::send(Ptr<Packet> packet)
+NetDeviceFace::send(Ptr<Packet> packet, int32_t hopCount)
 {
-  NS_ASSERT_MSG(packet->GetSize() <= m_netDevice->GetMtu(),
+  NS_ASSERT_MSG(m_isFragmentationEnabled || packet->GetSize() <= m_netDevice->GetMtu(),
                 "Packet size " << packet->GetSize() << " exceeds device MTU "
                                << m_netDevice->GetMtu());
 
-  FwHopCountTag tag;
-  packet->RemovePacketTag(tag);
-  tag.Increment();
-  packet->AddPacketTag(tag);
+  // packet built by Convert::ToPacket carries no packet tags, hop count is taken from the
+  // metadata slot of the received packet (-1 for locally generated ones)
+  packet->AddPacketTag(FwHopCountTag(std::max(hopCount, 0) + 1));
+
+  if (packet->GetSize() > m_netDevice->GetMtu()) {
+    sendFragments(packet);
+    return;
+  }
+
+  m_netDevice->Send(packet, m_destination, L3Protocol::ETHERNET_FRAME_TYPE);
+}
+
+void
+NetDeviceFace::sendFragments(Ptr<Packet> packet)
+{
+  uint32_t mtu = m_netDevice->GetMtu();
+  NS_ASSERT_MSG(mtu > LpFragmentHeader::MAX_SERIALIZED_SIZE, "Device MTU is too small for NDNLP");
+
+  uint32_t maxFragmentSize = mtu - LpFragmentHeader::MAX_SERIALIZED_SIZE;
+  uint32_t size = packet->GetSize();
+  uint64_t fragCount = (size + maxFragmentSize - 1) / maxFragmentSize;
+
+  // all faces of the NetDevice draw from one sequence space, so the receiver can tell apart
+  // fragments of broadcast and unicast packets
+  shared_ptr<NetDeviceFace> multicastFace = m_multicastFace.lock();
+  uint64_t& nextSequence =
+    multicastFace != nullptr ? multicastFace->m_nextFragmentSequence : m_nextFragmentSequence;
+  uint64_t sequence = nextSequence;
+  nextSequence += fragCount;
+
+  NS_LOG_DEBUG("Splitting " << size << " bytes into " << fragCount << " fragments");
+
+  for (uint64_t fragIndex = 0; fragIndex < fragCount; ++fragIndex) {
+    uint32_t offset = fragIndex * maxFragmentSize;
+    uint32_t fragmentSize = std::min(maxFragmentSize, size - offset);
+
+    // fragments inherit packet tags, including the hop count
+    Ptr<Packet> fragment = packet->CreateFragment(offset, fragmentSize);
+    fragment->AddHeader(LpFragmentHeader(sequence + fragIndex, fragIndex, fragCount, fragmentSize));
+
+    m_netDevice->Send(fragment, m_destination, L3Protocol::ETHERNET_FRAME_TYPE);
+  }
+}
+
+void
+NetDeviceFace::pack(Ptr<Packet> packet, int32_t hopCount)
+{
+  uint32_t mtu = m_netDevice->GetMtu();
+  if (packet->GetSize() > mtu) {
+    send(packet, hopCount);
+    return;
+  }
+
+  if (m_packedSize + packet->GetSize() > mtu)
+    flushPacked();
+
+  // packed Interests may have different hop counts, a byte tag stays with the Interest's bytes
+  packet->AddByteTag(FwHopCountTag(std::max(hopCount, 0) + 1));
 
-  m_netDevice->Send(packet, m_netDevice->GetBroadcast(), L3Protocol::ETHERNET_FRAME_TYPE);
+  m_packed.push_back(packet);
+  m_packedSize += packet->GetSize();
+
+  if (!m_packingEvent.IsRunning()) {
+    m_packingEvent =
+      Simulator::Schedule(m_interestPackingInterval, &NetDeviceFace::flushPacked, this);
+  }
+}
+
+void
+NetDeviceFace::flushPacked()
+{
+  Simulator::Cancel(m_packingEvent);
+  if (m_packed.empty())
+    return;
+
+  NS_LOG_DEBUG("Packing " << m_packed.size() << " Interests (" << m_packedSize << " bytes)");
+
+  Ptr<Packet> frame = m_packed.front();
+  for (size_t i = 1; i < m_packed.size(); ++i) {
+    frame->AddAtEnd(m_packed[i]);
+  }
+  m_packed.clear();
+  m_packedSize = 0;
+
+  m_netDevice->Send(frame, m_destination, L3Protocol::ETHERNET_FRAME_TYPE);
 }
 
 void
@@ -97,7 +303,10 @@ NetDeviceFace::sendInterest(const Interest& interest)
   this->emitSignal(onSendInterest, interest);
 
   Ptr<Packet> packet = Convert::ToPacket(interest);
-  send(packet);
+  if (m_isInterestPackingEnabled)
+    pack(packet, Ns3PacketTag::hopCountOf(interest));
+  else
+    send(packet, Ns3PacketTag::hopCountOf(interest));
 }
 
 void
@@ -108,7 +317,7 @@ NetDeviceFace::sendData(const Data& data)
   this->emitSignal(onSendData, data);
 
   Ptr<Packet> packet = Convert::ToPacket(data);
-  send(packet);
+  send(packet, Ns3PacketTag::hopCountOf(data));
 }
 
 // callback
@@ -119,25 +328,148 @@ NetDeviceFace::receiveFromNetDevice(Ptr<NetDevice> device, Ptr<const Packet> p,
 {
   NS_LOG_FUNCTION(device << p << protocol << from << to << packetType);
 
+  // unicast frames from a neighbor with an adjacency face belong to that face
+  if (packetType == NetDevice::PACKET_HOST && !m_adjacencies.empty()) {
+    auto adjacency = m_adjacencies.find(from);
+    if (adjacency != m_adjacencies.end()) {
+      adjacency->second->receive(p, from);
+      return;
+    }
+  }
+
+  receive(p, from);
+}
+
+void
+NetDeviceFace::receive(Ptr<const Packet> p, const Address& from)
+{
+  // packets for local applications are delivered after the forwarder is done with this one
+  AppFaceDispatcher::Guard guard(m_appFaceDispatcher);
+
   Ptr<Packet> packet = p->Copy();
   try {
-    uint32_t type = Convert::getPacketType(p);
-    if (type == ::ndn::tlv::Interest) {
-      shared_ptr<const Interest> i = Convert::FromPacket<Interest>(packet);
-      this->emitSignal(onReceiveInterest, *i);
-    }
-    else if (type == ::ndn::tlv::Data) {
-      shared_ptr<const Data> d = Convert::FromPacket<Data>(packet);
-      this->emitSignal(onReceiveData, *d);
+    if (Convert::getPacketType(p) == LpFragmentHeader::TLV_LP_PACKET) {
+      packet = reassemble(packet, from);
+      if (packet == 0)
+        return;
     }
-    else {
-      NS_LOG_ERROR("Unsupported TLV packet");
+
+    // packed Interests follow each other in one frame
+    uint32_t size = getPacketSize(packet);
+    while (size != 0 && size < packet->GetSize()) {
+      Ptr<Packet> element = packet->CreateFragment(0, size);
+      packet->RemoveAtStart(size);
+      decode(element);
+
+      size = getPacketSize(packet);
+      if (size == 0)
+        return; // trailing bytes are not an NDN packet (e.g., link-layer padding)
     }
+
+    decode(packet);
   }
   catch (::ndn::tlv::Error&) {
     NS_LOG_ERROR("Unrecognized TLV packet");
   }
 }
 
+void
+NetDeviceFace::decode(Ptr<Packet> packet)
+{
+  // hop count of a packed Interest
+  FwHopCountTag hopCountTag;
+  if (packet->FindFirstMatchingByteTag(hopCountTag)) {
+    packet->RemoveAllByteTags();
+    packet->ReplacePacketTag(hopCountTag);
+  }
+
+  uint32_t type = Convert::getPacketType(packet);
+  if (type == ::ndn::tlv::Interest) {
+    shared_ptr<const Interest> i = Convert::FromPacket<Interest>(packet);
+    this->emitSignal(onReceiveInterest, *i);
+  }
+  else if (type == ::ndn::tlv::Data) {
+    shared_ptr<const Data> d = Convert::FromPacket<Data>(packet);
+    this->emitSignal(onReceiveData, *d);
+  }
+  else {
+    NS_LOG_ERROR("Unsupported TLV packet");
+  }
+}
+
+Ptr<Packet>
+NetDeviceFace::reassemble(Ptr<Packet> fragment, const Address& from)
+{
+  LpFragmentHeader header;
+  fragment->RemoveHeader(header);
+
+  // anything after the declared fragment (e.g., link-layer padding) is not part of the packet
+  if (fragment->GetSize() > header.getFragmentSize())
+    fragment->RemoveAtEnd(fragment->GetSize() - header.getFragmentSize());
+
+  if (header.getFragCount() == 1)
+    return fragment;
+
+  // FragCount sizes the reassembly buffer, do not trust arbitrary values
+  if (header.getFragCount() > m_maxFragments) {
+    NS_LOG_ERROR("FragCount exceeds the limit of " << m_maxFragments << " in " << header);
+    return 0;
+  }
+
+  PartialPacketKey key(from, header.getSequence() - header.getFragIndex());
+  auto entry = m_partialPackets.find(key);
+  if (entry == m_partialPackets.end()) {
+    entry = m_partialPackets.insert(std::make_pair(key, PartialPacket())).first;
+    entry->second.fragments.resize(header.getFragCount());
+    entry->second.nReceived = 0;
+    m_partialPacketExpiry.push_back(std::make_pair(Simulator::Now() + m_reassemblyTimeout, key));
+
+    if (!m_reassemblyExpiryEvent.IsRunning())
+      m_reassemblyExpiryEvent = Simulator::Schedule(m_reassemblyTimeout,
+                                                    &NetDeviceFace::expirePartialPackets, this);
+  }
+
+  PartialPacket& partial = entry->second;
+  if (partial.fragments.size() != header.getFragCount()) {
+    NS_LOG_ERROR("FragCount mismatch in " << header);
+    return 0;
+  }
+
+  if (partial.fragments[header.getFragIndex()] == 0) {
+    partial.fragments[header.getFragIndex()] = fragment;
+    ++partial.nReceived;
+  }
+
+  if (partial.nReceived < partial.fragments.size())
+    return 0;
+
+  // the first fragment keeps the packet tags
+  Ptr<Packet> packet = partial.fragments[0];
+  for (size_t i = 1; i < partial.fragments.size(); ++i) {
+    packet->AddAtEnd(partial.fragments[i]);
+  }
+  m_partialPackets.erase(entry);
+
+  return packet;
+}
+
+void
+NetDeviceFace::expirePartialPackets()
+{
+  // drop packets that did not complete in time, oldest first (entries of completed packets
+  // are skipped)
+  Time now = Simulator::Now();
+  while (!m_partialPacketExpiry.empty() && m_partialPacketExpiry.front().first <= now) {
+    if (m_partialPackets.erase(m_partialPacketExpiry.front().second) != 0)
+      NS_LOG_DEBUG("Incomplete packet from " << m_partialPacketExpiry.front().second.first
+                   << " expired");
+    m_partialPacketExpiry.pop_front();
+  }
+
+  if (!m_partialPacketExpiry.empty())
+    m_reassemblyExpiryEvent = Simulator::Schedule(m_partialPacketExpiry.front().first - now,
+                                                  &NetDeviceFace::expirePartialPackets, this);
+}
+
 } // namespace ndn
 } // namespace ns3
@@ -24,10 +24,19 @@
 #include "ns3/ndnSIM/model/ndn-face.hpp"
 
 #include "ns3/net-device.h"
+#include "ns3/address.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+
+#include <map>
+#include <deque>
+#include <vector>
 
 namespace ns3 {
 namespace ndn {
 
+class AppFaceDispatcher;
+
 /**
  * \ingroup ndn-face
  * \brief Implementation of layer-2 (Ethernet) Ndn face
@@ -40,6 +49,23 @@ namespace ndn {
  * object and this object cannot be changed for the lifetime of the
  * face
  *
+ * On multi-access media (CSMA, Wi-Fi) the face created for the
+ * NetDevice is a multicast face that transmits to the broadcast
+ * address.  Unicast adjacency faces can be created on top of it, one
+ * per neighbor: they transmit to the neighbor's L2 address and receive
+ * only frames that the neighbor unicasts to this node.  All faces on
+ * the NetDevice share a single non-promiscuous protocol handler, so
+ * frames addressed to other nodes are dropped by the NetDevice before
+ * they are copied or decoded.
+ *
+ * If fragmentation is enabled on L3Protocol, packets larger than the
+ * NetDevice MTU are split into NDNLP fragments (see LpFragmentHeader)
+ * and reassembled hop-by-hop by the receiving face.
+ *
+ * If Interest packing is enabled, Interests sent within a short
+ * interval are transmitted back-to-back in one frame, like on NDN
+ * stream transports.  Receiving faces always unpack such frames.
+ *
  * \see NdnAppFace, NdnNetDeviceFace, NdnIpv4Face, NdnUdpFace
  */
 class NetDeviceFace : public Face {
@@ -53,6 +79,15 @@ public:
    */
   NetDeviceFace(Ptr<Node> node, const Ptr<NetDevice>& netDevice);
 
+  /**
+   * \brief Constructor of a unicast adjacency face
+   *
+   * @param multicastFace face of the multi-access NetDevice, which
+   * receives frames on behalf of the new face
+   * @param remoteAddress L2 address of the neighbor
+   */
+  NetDeviceFace(const shared_ptr<NetDeviceFace>& multicastFace, const Address& remoteAddress);
+
   virtual ~NetDeviceFace();
 
 public: // from nfd::Face
@@ -74,9 +109,70 @@ public:
   Ptr<NetDevice>
   GetNetDevice() const;
 
+  /**
+   * \brief Get L2 address of the neighbor
+   *
+   * \returns neighbor address for unicast adjacency faces, invalid
+   * Address for the face that transmits to the broadcast address
+   */
+  const Address&
+  GetRemoteAddress() const;
+
+  /**
+   * \brief Get number of packets of which only some NDNLP fragments have been received
+   */
+  size_t
+  GetNPartialPackets() const;
+
+  /**
+   * \brief Pack Interests into shared frames
+   *
+   * @param interval maximum time an Interest waits for other Interests;
+   * zero packs Interests sent at the same simulation time
+   */
+  void
+  EnableInterestPacking(Time interval);
+
+  /**
+   * \brief Send queued Interests and stop packing
+   */
+  void
+  DisableInterestPacking();
+
 private:
   void
-  send(Ptr<Packet> packet);
+  send(Ptr<Packet> packet, int32_t hopCount);
+
+  /// \brief queue Interest until the packed frame is full or the packing interval expires
+  void
+  pack(Ptr<Packet> packet, int32_t hopCount);
+
+  /// \brief send queued Interests in one frame
+  void
+  flushPacked();
+
+  /// \brief split packet into NDNLP fragments that fit the MTU and send them
+  void
+  sendFragments(Ptr<Packet> packet);
+
+  /// \brief decode frame and pass it to the forwarder
+  void
+  receive(Ptr<const Packet> p, const Address& from);
+
+  /// \brief decode single Interest or Data and pass it to the forwarder
+  void
+  decode(Ptr<Packet> packet);
+
+  /**
+   * \brief store NDNLP fragment
+   * \returns reassembled packet, or 0 while fragments are missing
+   */
+  Ptr<Packet>
+  reassemble(Ptr<Packet> fragment, const Address& from);
+
+  /// \brief drop partially received packets that are older than the reassembly timeout
+  void
+  expirePartialPackets();
 
   /// \brief callback from lower layers
   void
@@ -86,6 +182,36 @@ private:
 private:
   Ptr<Node> m_node;
   Ptr<NetDevice> m_netDevice; ///< \brief Smart pointer to NetDevice
+  AppFaceDispatcher* m_appFaceDispatcher; ///< \brief nullptr, unless direct dispatch is enabled
+
+  Address m_remoteAddress; ///< \brief L2 address of the neighbor (invalid for multicast face)
+  Address m_destination;   ///< \brief L2 destination of all transmitted frames
+
+  std::weak_ptr<NetDeviceFace> m_multicastFace; ///< \brief owner of the protocol handler
+  std::map<Address, NetDeviceFace*> m_adjacencies; ///< \brief unicast faces, by neighbor address
+
+  bool m_isFragmentationEnabled;
+  uint64_t m_nextFragmentSequence;
+  Time m_reassemblyTimeout;
+  uint32_t m_maxFragments; ///< \brief packets announcing more fragments are dropped
+
+  /// \brief sender and sequence number of the first fragment
+  typedef std::pair<Address, uint64_t> PartialPacketKey;
+
+  struct PartialPacket {
+    std::vector<Ptr<Packet>> fragments;
+    uint64_t nReceived;
+  };
+
+  std::map<PartialPacketKey, PartialPacket> m_partialPackets;
+  std::deque<std::pair<Time, PartialPacketKey>> m_partialPacketExpiry; ///< \brief in arrival order
+  EventId m_reassemblyExpiryEvent; ///< \brief pending while partially received packets exist
+
+  bool m_isInterestPackingEnabled;
+  Time m_interestPackingInterval;
+  std::vector<Ptr<Packet>> m_packed; ///< \brief Interests waiting for the packed frame
+  uint32_t m_packedSize;
+  EventId m_packingEvent;
 };
 
 } // namespace ndn
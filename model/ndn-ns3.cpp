@@ -25,6 +25,7 @@
 
 #include "ndn-header.hpp"
 #include "../utils/ndn-ns3-packet-tag.hpp"
+#include "../utils/ndn-fw-hop-count-tag.hpp"
 
 namespace ns3 {
 namespace ndn {
@@ -36,8 +37,18 @@ Convert::FromPacket(Ptr<Packet> packet)
   PacketHeader<T> header;
   packet->RemoveHeader(header);
 
+  // Move ndnSIM metadata from the ns-3 packet tag list into the fixed slots of Ns3PacketTag.
+  // Dropping the whole tag list is cheap (no copy-on-write) and leaves the stored packet
+  // without stale per-link tags, so the sending face only needs to add a fresh hop count tag.
+  Ns3PacketTag::Metadata metadata;
+  FwHopCountTag hopCountTag;
+  if (packet->PeekPacketTag(hopCountTag)) {
+    metadata.hopCount = hopCountTag.Get();
+  }
+  packet->RemoveAllPacketTags();
+
   auto pkt = header.getPacket();
-  pkt->setTag(make_shared<Ns3PacketTag>(packet));
+  pkt->setTag(make_shared<Ns3PacketTag>(packet, metadata));
 
   return pkt;
 }
@@ -83,7 +94,8 @@ Convert::getPacketType(Ptr<const Packet> packet)
     throw ::ndn::tlv::Error("Unknown header");
   }
 
-  if (type == ::ndn::tlv::Interest || type == ::ndn::tlv::Data) {
+  if (type == ::ndn::tlv::Interest || type == ::ndn::tlv::Data
+      || type == LpFragmentHeader::TLV_LP_PACKET) {
     return type;
   }
   else {
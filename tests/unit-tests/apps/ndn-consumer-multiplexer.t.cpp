@@ -0,0 +1,195 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/ndn-consumer-multiplexer.hpp"
+#include "helper/ndn-app-helper.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class ConsumerMultiplexerFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  void
+  OnData(shared_ptr<const Data> data, Ptr<App> app, shared_ptr<Face> face)
+  {
+    receivedData[app].push_back(data->getName());
+  }
+
+  void
+  OnAggregated(shared_ptr<const Interest> interest, Ptr<App> app)
+  {
+    nAggregated++;
+  }
+
+  static void
+  expressInterest(Ptr<ConsumerMultiplexer> multiplexer, Ptr<App> app, shared_ptr<Interest> interest)
+  {
+    multiplexer->ExpressInterest(app, *interest);
+  }
+
+public:
+  std::map<Ptr<App>, std::vector<Name>> receivedData;
+  uint32_t nAggregated = 0;
+};
+
+BOOST_FIXTURE_TEST_SUITE(AppsNdnConsumerMultiplexer, ConsumerMultiplexerFixture)
+
+BOOST_AUTO_TEST_CASE(TwoClientsOneFace)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+  createTopology({
+      {"1", "2"},
+    });
+
+  addRoutes({
+      {"1", "2", "/a", 1},
+      {"1", "2", "/b", 1},
+    });
+
+  addApps({
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/a"}, {"PayloadSize", "1024"}},
+          "0s", "100s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/b"}, {"PayloadSize", "1024"}},
+          "0s", "100s"}
+    });
+
+  // the multiplexer has to start before the consumers
+  Ptr<ConsumerMultiplexer> multiplexer =
+    DynamicCast<ConsumerMultiplexer>(AppHelper("ns3::ndn::ConsumerMultiplexer")
+                                       .Install(getNode("1")).Get(0));
+  BOOST_REQUIRE(multiplexer != nullptr);
+
+  AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetAttribute("Frequency", StringValue("10"));
+  consumerHelper.SetAttribute("MaxSeq", StringValue("10"));
+
+  consumerHelper.SetPrefix("/a");
+  ApplicationContainer a = consumerHelper.Install(getNode("1"));
+  consumerHelper.SetPrefix("/b");
+  ApplicationContainer b = consumerHelper.Install(getNode("1"));
+
+  multiplexer->Multiplex(a);
+  multiplexer->Multiplex(b);
+
+  ApplicationContainer consumers(a, b);
+  consumers.Start(Seconds(0.1));
+  consumers.Stop(Seconds(5.0));
+
+  Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/ReceivedDatas",
+                                MakeCallback(&ConsumerMultiplexerFixture::OnData, this));
+
+  Simulator::Stop(Seconds(10.0));
+  Simulator::Run();
+
+  // both clients share the multiplexer's face
+  BOOST_CHECK_EQUAL(getFace("1", "2")->getFaceStatus().getNOutInterests(), 20);
+  BOOST_CHECK_EQUAL(getFace("2", "1")->getFaceStatus().getNOutDatas(), 20);
+
+  Ptr<App> appA = DynamicCast<App>(a.Get(0));
+  Ptr<App> appB = DynamicCast<App>(b.Get(0));
+
+  // every client got its own Data, and only that
+  BOOST_REQUIRE_EQUAL(receivedData[appA].size(), 10);
+  for (const Name& name : receivedData[appA]) {
+    BOOST_CHECK(Name("/a").isPrefixOf(name));
+  }
+
+  BOOST_REQUIRE_EQUAL(receivedData[appB].size(), 10);
+  for (const Name& name : receivedData[appB]) {
+    BOOST_CHECK(Name("/b").isPrefixOf(name));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(SelectorsAreNotAggregated)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+  createTopology({
+      {"1", "2"},
+    });
+
+  addRoutes({
+      {"1", "2", "/a", 1},
+    });
+
+  addApps({
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/a"}, {"PayloadSize", "1024"}},
+          "0s", "100s"}
+    });
+
+  Ptr<ConsumerMultiplexer> multiplexer =
+    DynamicCast<ConsumerMultiplexer>(AppHelper("ns3::ndn::ConsumerMultiplexer")
+                                       .Install(getNode("1")).Get(0));
+  BOOST_REQUIRE(multiplexer != nullptr);
+  multiplexer->TraceConnectWithoutContext("AggregatedInterests",
+                                          MakeCallback(&ConsumerMultiplexerFixture::OnAggregated,
+                                                       this));
+
+  // clients that do not send anything by themselves
+  AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix("/a");
+  consumerHelper.SetAttribute("MaxSeq", StringValue("0"));
+  ApplicationContainer consumers = consumerHelper.Install(getNode("1"));
+  consumers.Add(consumerHelper.Install(getNode("1")));
+  multiplexer->Multiplex(consumers);
+  consumers.Start(Seconds(0.1));
+
+  Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/ReceivedDatas",
+                                MakeCallback(&ConsumerMultiplexerFixture::OnData, this));
+
+  Ptr<App> appA = DynamicCast<App>(consumers.Get(0));
+  Ptr<App> appB = DynamicCast<App>(consumers.Get(1));
+
+  auto interest = make_shared<Interest>(Name("/a/1"));
+  interest->setInterestLifetime(time::seconds(2));
+  auto freshInterest = make_shared<Interest>(Name("/a/1"));
+  freshInterest->setInterestLifetime(time::seconds(2));
+  freshInterest->setMustBeFresh(true);
+
+  Simulator::Schedule(Seconds(1.0), &expressInterest, multiplexer, appA, interest);
+  Simulator::Schedule(Seconds(1.0), &expressInterest, multiplexer, appB, freshInterest);
+  Simulator::Schedule(Seconds(1.0), &expressInterest, multiplexer, appB, interest);
+
+  Simulator::Stop(Seconds(5.0));
+  Simulator::Run();
+
+  // the MustBeFresh Interest is sent on its own, the second plain one is aggregated
+  BOOST_CHECK_EQUAL(getFace("1", "2")->getFaceStatus().getNOutInterests(), 2);
+  BOOST_CHECK_EQUAL(nAggregated, 1);
+
+  BOOST_CHECK_EQUAL(receivedData[appA].size(), 1);
+  BOOST_CHECK_EQUAL(receivedData[appB].size(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,147 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/ndn-file-consumer-cbr.hpp"
+
+#include "ns3/simulator.h"
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_FILELIST =
+  boost::filesystem::path(TEST_CONFIG_PATH) / "filelist.csv";
+
+class FileConsumerCbrFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  FileConsumerCbrFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+    boost::filesystem::ofstream os(TEST_FILELIST);
+    os << "file.bin,30000" << std::endl;
+  }
+
+  ~FileConsumerCbrFixture()
+  {
+    boost::filesystem::remove(TEST_FILELIST);
+  }
+
+  void
+  OnInterest(shared_ptr<const Interest> interest, Ptr<App> app, shared_ptr<Face> face)
+  {
+    if (sendEvents.empty() || sendEvents.back().first != Simulator::Now())
+      sendEvents.push_back(std::make_pair(Simulator::Now(), 0));
+    sendEvents.back().second++;
+  }
+
+  void
+  OnManifest(Ptr<App> app, shared_ptr<const Name> name, long fileSize)
+  {
+    manifestTime = Simulator::Now();
+
+    // the chunk Interests are in flight for a while, only the consumer runs events
+    Simulator::Schedule(MilliSeconds(50), &FileConsumerCbrFixture::CountEvents, this,
+                        &eventsBefore);
+    Simulator::Schedule(MilliSeconds(450), &FileConsumerCbrFixture::CountEvents, this,
+                        &eventsAfter);
+  }
+
+  void
+  CountEvents(uint64_t* count)
+  {
+    *count = Simulator::GetEventCount();
+  }
+
+public:
+  std::vector<std::pair<Time, uint32_t>> sendEvents; ///< @brief time and number of Interests
+  Time manifestTime;
+  uint64_t eventsBefore = 0;
+  uint64_t eventsAfter = 0;
+};
+
+BOOST_FIXTURE_TEST_SUITE(AppsNdnFileConsumerCbr, FileConsumerCbrFixture)
+
+BOOST_AUTO_TEST_CASE(BurstPacing)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("500ms"));
+
+  createTopology({
+      {"1", "2"},
+    });
+
+  addRoutes({
+      {"1", "2", "/prefix", 1},
+    });
+
+  // 1000 Interests/s in bursts of 10 every 10ms
+  addApps({
+      {"2", "ns3::ndn::FakeFileServer",
+          {{"Prefix", "/prefix"}, {"MetaDataFile", TEST_FILELIST.string()}},
+          "0s", "100s"},
+      {"1", "ns3::ndn::FileConsumerCbr",
+          {{"FileToRequest", "/prefix/file.bin"}, {"WindowSize", "1000"},
+           {"PacingGranularity", "10ms"}, {"InitialRTT", "2000"}, {"MaxEstimatedRTT", "4000"}},
+          "0s", "100s"}
+    });
+
+  Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/TransmittedInterests",
+                                MakeCallback(&FileConsumerCbrFixture::OnInterest, this));
+  Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/ManifestReceived",
+                                MakeCallback(&FileConsumerCbrFixture::OnManifest, this));
+
+  Simulator::Stop(Seconds(1.5));
+  Simulator::Run();
+
+  // manifest Interest, then bursts of 10 chunk Interests and a last, smaller one
+  BOOST_REQUIRE_GE(sendEvents.size(), 3);
+  BOOST_CHECK_EQUAL(sendEvents[0].second, 1);
+  BOOST_CHECK_EQUAL(sendEvents[1].first, manifestTime);
+
+  for (size_t i = 1; i < sendEvents.size(); i++) {
+    if (i + 1 < sendEvents.size()) {
+      BOOST_CHECK_EQUAL(sendEvents[i].second, 10);
+
+      // one interval per Interest sent, +/-0.25% randomization
+      double gap = (sendEvents[i + 1].first - sendEvents[i].first).GetSeconds() * 1000.0;
+      BOOST_CHECK_CLOSE(gap, sendEvents[i].second * 1.0, 0.3);
+    }
+    else {
+      BOOST_CHECK_LE(sendEvents[i].second, 10);
+      BOOST_CHECK_GT(sendEvents[i].second, 0);
+    }
+  }
+
+  // while waiting for the chunks, nothing can be sent: one send event per pacing interval
+  // (plus the two counting events), not one per Interest interval
+  BOOST_REQUIRE_GT(eventsAfter, eventsBefore);
+  BOOST_CHECK_GE(eventsAfter - eventsBefore, 38);
+  BOOST_CHECK_LE(eventsAfter - eventsBefore, 48);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
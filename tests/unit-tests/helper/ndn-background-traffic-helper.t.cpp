@@ -0,0 +1,155 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "helper/ndn-background-traffic-helper.hpp"
+#include "model/ndn-net-device-face.hpp"
+
+#include "ns3/point-to-point-net-device.h"
+#include "ns3/point-to-point-channel.h"
+#include "ns3/queue.h"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class BackgroundTrafficFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  Ptr<PointToPointNetDevice>
+  getDevice(const std::string& from, const std::string& to)
+  {
+    shared_ptr<NetDeviceFace> face = std::dynamic_pointer_cast<NetDeviceFace>(getFace(from, to));
+    BOOST_REQUIRE(face != nullptr);
+    return DynamicCast<PointToPointNetDevice>(face->GetNetDevice());
+  }
+
+  uint64_t
+  getRate(const std::string& from, const std::string& to)
+  {
+    return BackgroundTrafficHelper::GetResidualRate(getNode(from), getNode(to)).GetBitRate();
+  }
+
+  uint32_t
+  getMaxPackets(const std::string& from, const std::string& to)
+  {
+    UintegerValue maxPackets;
+    getDevice(from, to)->GetQueue()->GetAttribute("MaxPackets", maxPackets);
+    return maxPackets.Get();
+  }
+
+  double
+  getDelay(const std::string& from, const std::string& to)
+  {
+    TimeValue delay;
+    getDevice(from, to)->GetChannel()->GetAttribute("Delay", delay);
+    return delay.Get().GetSeconds() * 1000.0;
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(HelperNdnBackgroundTrafficHelper, BackgroundTrafficFixture)
+
+BOOST_AUTO_TEST_CASE(ReservationAndOccupancy)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+  createTopology({
+      {"1", "2"},
+      {"2", "3"},
+    });
+
+  NodeContainer path;
+  path.Add(getNode("3"));
+  path.Add(getNode("2"));
+  path.Add(getNode("1"));
+
+  uint32_t flow = BackgroundTrafficHelper::AddFlow(path, DataRate("5Mbps"));
+  BOOST_CHECK_EQUAL(getRate("3", "2"), 5000000);
+  BOOST_CHECK_EQUAL(getRate("2", "1"), 5000000);
+  BOOST_CHECK_EQUAL(getRate("1", "2"), 10000000); // other direction is not loaded
+  BOOST_CHECK_EQUAL(getMaxPackets("3", "2"), 19); // 0.5 / 0.5 = 1 packet
+  BOOST_CHECK_EQUAL(getMaxPackets("1", "2"), 20);
+
+  BackgroundTrafficHelper::SetFlowRate(flow, DataRate("8Mbps"));
+  BOOST_CHECK_EQUAL(getRate("3", "2"), 2000000);
+  BOOST_CHECK_EQUAL(getMaxPackets("3", "2"), 16); // 0.8 / 0.2 = 4 packets
+
+  // links are never fully reserved
+  NodeContainer hop;
+  hop.Add(getNode("2"));
+  hop.Add(getNode("1"));
+  uint32_t other = BackgroundTrafficHelper::AddFlow(hop, DataRate("4Mbps"));
+  BOOST_CHECK_EQUAL(getRate("2", "1"), 100000);
+  BOOST_CHECK_EQUAL(getMaxPackets("2", "1"), 1);
+  BOOST_CHECK_EQUAL(getRate("3", "2"), 2000000);
+
+  BackgroundTrafficHelper::RemoveFlow(flow);
+  BOOST_CHECK_EQUAL(getRate("2", "1"), 6000000);
+  BOOST_CHECK_EQUAL(getMaxPackets("2", "1"), 19);
+  BOOST_CHECK_EQUAL(getRate("3", "2"), 10000000);
+  BOOST_CHECK_EQUAL(getMaxPackets("3", "2"), 20);
+
+  BackgroundTrafficHelper::RemoveFlow(other);
+  BOOST_CHECK_EQUAL(getRate("2", "1"), 10000000);
+  BOOST_CHECK_EQUAL(getMaxPackets("2", "1"), 20);
+}
+
+BOOST_AUTO_TEST_CASE(PerDirection)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+  createTopology({
+      {"1", "2"},
+    });
+
+  NodeContainer forward;
+  forward.Add(getNode("2"));
+  forward.Add(getNode("1"));
+
+  NodeContainer reverse;
+  reverse.Add(getNode("1"));
+  reverse.Add(getNode("2"));
+
+  // asymmetric load: each direction keeps its own residual rate and queue, the shared channel
+  // delay is left alone
+  uint32_t flow = BackgroundTrafficHelper::AddFlow(forward, DataRate("8Mbps"));
+  uint32_t other = BackgroundTrafficHelper::AddFlow(reverse, DataRate("2Mbps"));
+  BOOST_CHECK_EQUAL(getRate("2", "1"), 2000000);
+  BOOST_CHECK_EQUAL(getMaxPackets("2", "1"), 16); // 0.8 / 0.2 = 4 packets
+  BOOST_CHECK_EQUAL(getRate("1", "2"), 8000000);
+  BOOST_CHECK_EQUAL(getMaxPackets("1", "2"), 20); // 0.2 / 0.8 is rounded to 0
+  BOOST_CHECK_CLOSE(getDelay("2", "1"), 10.0, 0.01);
+  BOOST_CHECK_CLOSE(getDelay("1", "2"), 10.0, 0.01);
+
+  BackgroundTrafficHelper::RemoveFlow(flow);
+  BackgroundTrafficHelper::RemoveFlow(other);
+  BOOST_CHECK_EQUAL(getRate("2", "1"), 10000000);
+  BOOST_CHECK_EQUAL(getRate("1", "2"), 10000000);
+  BOOST_CHECK_CLOSE(getDelay("2", "1"), 10.0, 0.01);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,91 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/cs/ndn-content-store.hpp"
+#include "helper/ndn-stack-helper.hpp"
+
+#include <ndn-cxx/data.hpp>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(ModelCsContentStoreWithFreshness, CleanupFixture)
+
+static void
+addData(Ptr<ContentStore> cs, std::string name, int freshnessMs)
+{
+  auto data = std::make_shared<ndn::Data>(Name(name));
+  data->setFreshnessPeriod(ndn::time::milliseconds(freshnessMs));
+  data->setContent(std::make_shared< ::ndn::Buffer>(100));
+  ndn::StackHelper::getKeyChain().sign(*data);
+
+  BOOST_CHECK(cs->Add(data));
+}
+
+static void
+checkSize(Ptr<ContentStore> cs, uint32_t expected)
+{
+  BOOST_CHECK_MESSAGE(cs->GetSize() == expected,
+                      "At " << Simulator::Now().GetSeconds() << "s: " << cs->GetSize()
+                            << " entries, expected " << expected);
+}
+
+BOOST_AUTO_TEST_CASE(WheelLevelsAndOverflow)
+{
+  ObjectFactory factory;
+  factory.SetTypeId("ns3::ndn::cs::Freshness::Lru");
+  factory.Set("MaxSize", StringValue("100"));
+  factory.Set("ExpiryGranularity", StringValue("10ms"));
+  Ptr<ContentStore> cs = factory.Create<ContentStore>();
+
+  // with 10ms ticks: 5 ticks (level 0), 500 ticks (level 1, cascaded at tick 256), and
+  // 30000 ticks (overflow, cascaded at tick 16384 into level 1 and at tick 29952 into level 0)
+  addData(cs, "/level0", 50);
+  addData(cs, "/level1", 5000);
+  addData(cs, "/overflow", 300000);
+
+  // expires before anything else still in the wheel (next advance is the cascade at 2.56s)
+  Simulator::Schedule(Seconds(1.0), &addData, cs, "/inserted-later", 100);
+  // expires after /level1
+  Simulator::Schedule(Seconds(1.0), &addData, cs, "/inserted-later-2", 10000);
+
+  Simulator::Schedule(Seconds(0.049), &checkSize, cs, 3);
+  Simulator::Schedule(Seconds(0.061), &checkSize, cs, 2);
+  Simulator::Schedule(Seconds(1.099), &checkSize, cs, 4);
+  Simulator::Schedule(Seconds(1.111), &checkSize, cs, 3);
+  Simulator::Schedule(Seconds(4.999), &checkSize, cs, 3);
+  Simulator::Schedule(Seconds(5.011), &checkSize, cs, 2);
+  Simulator::Schedule(Seconds(10.999), &checkSize, cs, 2);
+  Simulator::Schedule(Seconds(11.011), &checkSize, cs, 1);
+  Simulator::Schedule(Seconds(299.999), &checkSize, cs, 1);
+  Simulator::Schedule(Seconds(300.011), &checkSize, cs, 0);
+
+  Simulator::Run();
+
+  // the wheel stops once it is empty
+  BOOST_CHECK_EQUAL(Simulator::Now(), Seconds(300.011));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,198 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/ndn-app-face.hpp"
+#include "model/ndn-l3-protocol.hpp"
+#include "apps/ndn-app.hpp"
+
+#include "ns3/simulator.h"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class DirectAppFaceDispatchFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  DirectAppFaceDispatchFixture()
+    : nReceivedData(0)
+  {
+    Config::SetDefault("ns3::ndn::L3Protocol::DirectAppFaceDispatch", BooleanValue(true));
+  }
+
+  ~DirectAppFaceDispatchFixture()
+  {
+    Config::SetDefault("ns3::ndn::L3Protocol::DirectAppFaceDispatch", BooleanValue(false));
+  }
+
+  void
+  OnData(shared_ptr<const Data> data, Ptr<App> app, shared_ptr<Face> face)
+  {
+    nReceivedData++;
+  }
+
+public:
+  size_t nReceivedData;
+};
+
+// requests the next Data from within OnData, like window-based consumers do
+class ChainedConsumer : public App
+{
+public:
+  ChainedConsumer()
+    : nData(0)
+    , nReentrantData(0)
+    , m_isSending(false)
+  {
+  }
+
+  virtual void
+  OnData(shared_ptr<const Data> data)
+  {
+    App::OnData(data);
+
+    nData++;
+    if (m_isSending)
+      nReentrantData++;
+
+    if (nData < 100)
+      Send(nData);
+  }
+
+protected:
+  virtual void
+  StartApplication()
+  {
+    App::StartApplication();
+    Send(0);
+  }
+
+private:
+  void
+  Send(uint32_t seq)
+  {
+    shared_ptr<Interest> interest = make_shared<Interest>(Name("/local").appendSequenceNumber(seq));
+    interest->setInterestLifetime(::ndn::time::seconds(1));
+
+    m_isSending = true;
+    m_face->onReceiveInterest(*interest);
+    m_isSending = false;
+  }
+
+public:
+  uint32_t nData;
+  uint32_t nReentrantData;
+
+private:
+  bool m_isSending;
+};
+
+static void
+countEvents(uint64_t* count)
+{
+  *count = Simulator::GetEventCount();
+}
+
+BOOST_FIXTURE_TEST_SUITE(ModelNdnAppFace, DirectAppFaceDispatchFixture)
+
+BOOST_AUTO_TEST_CASE(DirectDispatch)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+  createTopology({
+      {"1", "2"},
+    });
+
+  addRoutes({
+      {"1", "2", "/remote", 1},
+    });
+
+  // the local producer is reached from within the consumer's call into the forwarder
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/remote"}, {"Frequency", "10"}},
+          "0s", "9.99s"},
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/local"}, {"Frequency", "10"}},
+          "0s", "9.99s"},
+      {"1", "ns3::ndn::Producer",
+          {{"Prefix", "/local"}, {"PayloadSize", "1024"}},
+          "0s", "100s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/remote"}, {"PayloadSize", "1024"}},
+          "0s", "100s"}
+    });
+
+  BOOST_REQUIRE(getNode("1")->GetObject<L3Protocol>()->getAppFaceDispatcher() != nullptr);
+
+  Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/ReceivedDatas",
+                                MakeCallback(&DirectAppFaceDispatchFixture::OnData, this));
+
+  Simulator::Stop(Seconds(20.001));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(getFace("1", "2")->getFaceStatus().getNOutInterests(), 100);
+  BOOST_CHECK_EQUAL(getFace("2", "1")->getFaceStatus().getNOutDatas(), 100);
+  BOOST_CHECK_EQUAL(nReceivedData, 200);
+}
+
+BOOST_AUTO_TEST_CASE(NoReentrantDelivery)
+{
+  createTopology({
+      {"1", "2"},
+    });
+
+  addApps({
+      {"1", "ns3::ndn::Producer",
+          {{"Prefix", "/local"}, {"PayloadSize", "1024"}},
+          "0s", "100s"}
+    });
+
+  Ptr<ChainedConsumer> consumer = CreateObject<ChainedConsumer>();
+  getNode("1")->AddApplication(consumer);
+  consumer->SetStartTime(Seconds(1.0));
+  consumer->SetStopTime(Seconds(2.0));
+
+  // all 100 exchanges with the local producer happen at 1s
+  uint64_t eventsBefore = 0;
+  uint64_t eventsAfter = 0;
+  Simulator::Schedule(Seconds(0.999), &countEvents, &eventsBefore);
+  Simulator::Schedule(Seconds(1.001), &countEvents, &eventsAfter);
+
+  Simulator::Stop(Seconds(3.0));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(consumer->nData, 100);
+
+  // Data is never delivered while the consumer is still inside its call into the forwarder
+  BOOST_CHECK_EQUAL(consumer->nReentrantData, 0);
+
+  // application start, one dispatch event for the whole chain and the counting event (one
+  // event per Interest and Data without direct dispatch)
+  BOOST_CHECK_LE(eventsAfter - eventsBefore, 5);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
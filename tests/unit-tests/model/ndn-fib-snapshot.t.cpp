@@ -0,0 +1,172 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/ndn-fib-snapshot.hpp"
+#include "model/ndn-l3-protocol.hpp"
+#include "helper/ndn-fib-helper.hpp"
+#include "helper/ndn-scenario-helper.hpp"
+
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class FibSnapshotFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  FibSnapshotFixture()
+  {
+    createTopology({
+        {"1", "2"},
+        {"1", "3"}
+      });
+
+    addRoutes({
+        {"1", "2", "/a", 1},
+        {"1", "3", "/a/b", 1},
+        {"1", "2", "/a/b", 5},
+        {"1", "3", "/a/b/c/d", 1}
+      });
+
+    ndn = getNode("1")->GetObject<L3Protocol>();
+  }
+
+public:
+  Ptr<L3Protocol> ndn;
+};
+
+BOOST_FIXTURE_TEST_SUITE(ModelNdnFibSnapshot, FibSnapshotFixture)
+
+BOOST_AUTO_TEST_CASE(NotFrozen)
+{
+  BOOST_CHECK(ndn->getFibSnapshot() == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(LongestPrefixMatch)
+{
+  FibHelper::Freeze(getNode("1"));
+
+  shared_ptr<const FibSnapshot> snapshot = ndn->getFibSnapshot();
+  BOOST_REQUIRE(snapshot != nullptr);
+  BOOST_CHECK_EQUAL(snapshot->size(), ndn->getForwarder()->getFib().size());
+
+  const FibSnapshot::Entry* entry = snapshot->findLongestPrefixMatch("/a/b/c");
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_CHECK_EQUAL(entry->getPrefixLength(), 2);
+  BOOST_CHECK_EQUAL(entry->getPrefix(), Name("/a/b"));
+  BOOST_REQUIRE_EQUAL(entry->size(), 2);
+  BOOST_CHECK_EQUAL(entry->begin()[0].faceId, getFace("1", "3")->getId());
+  BOOST_CHECK_EQUAL(entry->begin()[0].cost, 1);
+  BOOST_CHECK_EQUAL(entry->begin()[1].faceId, getFace("1", "2")->getId());
+  BOOST_CHECK_EQUAL(entry->begin()[1].cost, 5);
+
+  entry = snapshot->findLongestPrefixMatch("/a/bb");
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_CHECK_EQUAL(entry->getPrefixLength(), 1);
+
+  entry = snapshot->findLongestPrefixMatch("/a/b/c/d/e/f");
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_CHECK_EQUAL(entry->getPrefixLength(), 4);
+
+  // must agree with NFD's own lookup
+  for (const Name& name : {Name("/"), Name("/a"), Name("/ab"), Name("/a/b/c/d"), Name("/b/a"),
+                           Name("/localhost/nfd/fib/list")}) {
+    shared_ptr<nfd::fib::Entry> expected =
+      ndn->getForwarder()->getFib().findLongestPrefixMatch(name);
+    entry = snapshot->findLongestPrefixMatch(name);
+    if (expected == nullptr || (expected->getPrefix().size() == 0 && !expected->hasNextHops())) {
+      BOOST_CHECK(entry == nullptr);
+    }
+    else {
+      BOOST_REQUIRE(entry != nullptr);
+      BOOST_CHECK_EQUAL(entry->getPrefixLength(), expected->getPrefix().size());
+      BOOST_CHECK_EQUAL(entry->size(), expected->getNextHops().size());
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ComponentBoundaries)
+{
+  FibHelper::AddRoute(getNode("1"), "/x/yz", getFace("1", "2"), 1);
+  FibHelper::AddRoute(getNode("1"), "/xy/z/w", getFace("1", "3"), 1);
+  FibHelper::Freeze(getNode("1"));
+
+  shared_ptr<const FibSnapshot> snapshot = ndn->getFibSnapshot();
+  for (const Name& name : {Name("/xy/z"), Name("/x/y/z/w")}) {
+    const FibSnapshot::Entry* entry = snapshot->findLongestPrefixMatch(name);
+    BOOST_CHECK(entry == nullptr || entry->getPrefixLength() == 0);
+  }
+
+  const FibSnapshot::Entry* entry = snapshot->findLongestPrefixMatch("/x/yz/w");
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_CHECK_EQUAL(entry->getPrefix(), Name("/x/yz"));
+
+  entry = snapshot->findLongestPrefixMatch("/xy/z/w/v");
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_CHECK_EQUAL(entry->getPrefix(), Name("/xy/z/w"));
+}
+
+BOOST_AUTO_TEST_CASE(RebuildOnChange)
+{
+  FibHelper::FreezeAll();
+
+  shared_ptr<const FibSnapshot> snapshot = ndn->getFibSnapshot();
+  BOOST_CHECK(snapshot == ndn->getFibSnapshot());
+  BOOST_CHECK(snapshot->findLongestPrefixMatch("/z/y") == nullptr);
+
+  FibHelper::AddRoute(getNode("1"), "/z", getFace("1", "2"), 1);
+
+  shared_ptr<const FibSnapshot> rebuilt = ndn->getFibSnapshot();
+  BOOST_CHECK(rebuilt != snapshot);
+  BOOST_REQUIRE(rebuilt->findLongestPrefixMatch("/z/y") != nullptr);
+  BOOST_CHECK_EQUAL(rebuilt->findLongestPrefixMatch("/z/y")->begin()->faceId,
+                    getFace("1", "2")->getId());
+
+  // old snapshot is still usable
+  BOOST_CHECK(snapshot->findLongestPrefixMatch("/z/y") == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(RebuildOnFaceRemoval)
+{
+  FibHelper::Freeze(getNode("1"));
+
+  shared_ptr<const FibSnapshot> snapshot = ndn->getFibSnapshot();
+  BOOST_REQUIRE_EQUAL(snapshot->findLongestPrefixMatch("/a/b")->size(), 2);
+
+  nfd::FaceId removedId = getFace("1", "3")->getId();
+  getFace("1", "3")->close();
+  BOOST_CHECK(ndn->getFaceById(removedId) == nullptr);
+
+  shared_ptr<const FibSnapshot> rebuilt = ndn->getFibSnapshot();
+  BOOST_CHECK(rebuilt != snapshot);
+
+  const FibSnapshot::Entry* entry = rebuilt->findLongestPrefixMatch("/a/b/c");
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_CHECK_EQUAL(entry->getPrefixLength(), 2);
+  BOOST_REQUIRE_EQUAL(entry->size(), 1);
+  BOOST_CHECK_EQUAL(entry->begin()->faceId, getFace("1", "2")->getId());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -47,6 +47,28 @@ BOOST_AUTO_TEST_CASE(TypeId)
  BOOST_CHECK_EQUAL(dataPktHeader.GetSerializedSize(), 1354); // 328 + 1024
 }
 
+BOOST_AUTO_TEST_CASE(TruncatedPacket)
+{
+  auto interest = make_shared<ndn::Interest>("/prefix");
+  interest->setNonce(1);
+  Ptr<Packet> packet = Create<Packet>();
+  packet->AddHeader(PacketHeader<Interest>(*interest));
+
+  PacketHeader<Interest> header;
+  Ptr<Packet> complete = packet->Copy();
+  BOOST_CHECK_NO_THROW(complete->RemoveHeader(header));
+  BOOST_CHECK_EQUAL(header.getPacket()->getName(), interest->getName());
+
+  // TLV length points past the end of the packet
+  Ptr<Packet> truncated = packet->CreateFragment(0, packet->GetSize() - 1);
+  BOOST_CHECK_THROW(truncated->RemoveHeader(header), ::ndn::tlv::Error);
+
+  // packet ends within the TLV length field
+  const uint8_t buffer[] = {::ndn::tlv::Interest, 253, 0x01};
+  Ptr<Packet> truncatedLength = Create<Packet>(buffer, sizeof(buffer));
+  BOOST_CHECK_THROW(truncatedLength->RemoveHeader(header), ::ndn::tlv::Error);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -19,6 +19,18 @@
 
 
 #include "model/ndn-net-device-face.hpp"
+#include "model/ndn-l3-protocol.hpp"
+#include "helper/ndn-stack-helper.hpp"
+#include "helper/ndn-fib-helper.hpp"
+#include "helper/ndn-app-helper.hpp"
+
+#include "ns3/simple-channel.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/mac48-address.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/error-model.h"
+#include "ns3/pointer.h"
+#include "ns3/uinteger.h"
 
 #include "../tests-common.hpp"
 
@@ -60,6 +72,254 @@ BOOST_AUTO_TEST_CASE(Basic)
   BOOST_CHECK_EQUAL(getFace("2", "1")->getFaceStatus().getNOutDatas(), 100);
 }
 
+BOOST_AUTO_TEST_CASE(UnicastAdjacency)
+{
+  NodeContainer nodes;
+  nodes.Create(3);
+
+  // one shared segment
+  Ptr<SimpleChannel> channel = CreateObject<SimpleChannel>();
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); ++node) {
+    Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice>();
+    device->SetAddress(Mac48Address::Allocate());
+    device->SetChannel(channel);
+    (*node)->AddDevice(device);
+  }
+
+  StackHelper ndnHelper;
+  ndnHelper.SetUnicastAdjacencies(true);
+  ndnHelper.Install(nodes);
+
+  FibHelper::AddRoute(nodes.Get(0), "/prefix", nodes.Get(2), 1);
+
+  AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix("/prefix");
+  consumerHelper.SetAttribute("Frequency", StringValue("10"));
+  consumerHelper.Install(nodes.Get(0)).Stop(Seconds(9.99));
+
+  AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix("/prefix");
+  producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+  producerHelper.Install(nodes.Get(2));
+
+  Simulator::Stop(Seconds(20.001));
+  Simulator::Run();
+
+  Ptr<NetDevice> consumerDevice = nodes.Get(0)->GetDevice(0);
+  Ptr<NetDevice> producerDevice = nodes.Get(2)->GetDevice(0);
+
+  shared_ptr<Face> toProducer = nodes.Get(0)->GetObject<L3Protocol>()
+    ->getFaceByNetDevice(consumerDevice, producerDevice->GetAddress());
+  BOOST_REQUIRE(toProducer != nullptr);
+  BOOST_CHECK_EQUAL(toProducer->getFaceStatus().getNOutInterests(), 100);
+  BOOST_CHECK_EQUAL(toProducer->getFaceStatus().getNInDatas(), 100);
+
+  shared_ptr<Face> toConsumer = nodes.Get(2)->GetObject<L3Protocol>()
+    ->getFaceByNetDevice(producerDevice, consumerDevice->GetAddress());
+  BOOST_REQUIRE(toConsumer != nullptr);
+  BOOST_CHECK_EQUAL(toConsumer->getFaceStatus().getNInInterests(), 100);
+  BOOST_CHECK_EQUAL(toConsumer->getFaceStatus().getNOutDatas(), 100);
+
+  // nothing was broadcast, and the bystander never decoded a frame
+  shared_ptr<Face> multicast = nodes.Get(0)->GetObject<L3Protocol>()
+    ->getFaceByNetDevice(consumerDevice);
+  BOOST_CHECK_EQUAL(multicast->getFaceStatus().getNOutInterests(), 0);
+
+  for (const auto& face : nodes.Get(1)->GetObject<L3Protocol>()->getForwarder()->getFaceTable()) {
+    BOOST_CHECK_EQUAL(face->getFaceStatus().getNInInterests(), 0);
+    BOOST_CHECK_EQUAL(face->getFaceStatus().getNInDatas(), 0);
+  }
+}
+
+class FragmentationFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  FragmentationFixture()
+  {
+    Config::SetDefault("ns3::ndn::L3Protocol::Fragmentation", BooleanValue(true));
+  }
+
+  ~FragmentationFixture()
+  {
+    Config::SetDefault("ns3::ndn::L3Protocol::Fragmentation", BooleanValue(false));
+    Config::SetDefault("ns3::ndn::L3Protocol::MaxFragments", UintegerValue(64));
+  }
+};
+
+BOOST_FIXTURE_TEST_CASE(Fragmentation, FragmentationFixture)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+  createTopology({
+      {"1", "2"},
+      {"2", "3"},
+    });
+
+  addRoutes({
+      {"1", "2", "/prefix", 1},
+      {"2", "3", "/prefix", 1},
+    });
+
+  // Data is larger than both the MTU and MAX_NDN_PACKET_SIZE
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+          "0s", "9.99s"},
+      {"3", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "16384"}},
+          "0s", "100s"}
+    });
+
+  Simulator::Stop(Seconds(20.001));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(getFace("1", "2")->getFaceStatus().getNInDatas(), 100);
+  BOOST_CHECK_EQUAL(getFace("2", "3")->getFaceStatus().getNInDatas(), 100);
+  BOOST_CHECK_EQUAL(getFace("2", "1")->getFaceStatus().getNOutDatas(), 100);
+}
+
+static void
+countPartialPackets(shared_ptr<NetDeviceFace> face, size_t* nPartialPackets)
+{
+  *nPartialPackets = face->GetNPartialPackets();
+}
+
+BOOST_FIXTURE_TEST_CASE(ReassemblyTimeout, FragmentationFixture)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+  createTopology({
+      {"1", "2"},
+    });
+
+  addRoutes({
+      {"1", "2", "/prefix", 1},
+    });
+
+  // a single Interest, no retransmission
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "1"}},
+          "0s", "0.5s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "16384"}},
+          "0s", "100s"}
+    });
+
+  // the second fragment of the Data is lost, no further fragments arrive afterwards
+  shared_ptr<NetDeviceFace> face = std::dynamic_pointer_cast<NetDeviceFace>(getFace("1", "2"));
+  BOOST_REQUIRE(face != nullptr);
+
+  Ptr<ReceiveListErrorModel> errorModel = CreateObject<ReceiveListErrorModel>();
+  errorModel->SetList({2});
+  face->GetNetDevice()->SetAttribute("ReceiveErrorModel", PointerValue(errorModel));
+
+  size_t nPartialBefore = 0;
+  size_t nPartialAfter = 0;
+  Simulator::Schedule(Seconds(0.3), &countPartialPackets, face, &nPartialBefore);
+  Simulator::Schedule(Seconds(1.0), &countPartialPackets, face, &nPartialAfter);
+
+  Simulator::Stop(Seconds(2.0));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(face->getFaceStatus().getNInDatas(), 0);
+  BOOST_CHECK_EQUAL(nPartialBefore, 1);
+  BOOST_CHECK_EQUAL(nPartialAfter, 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(MaxFragments, FragmentationFixture)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+  Config::SetDefault("ns3::ndn::L3Protocol::MaxFragments", UintegerValue(4));
+
+  createTopology({
+      {"1", "2"},
+    });
+
+  addRoutes({
+      {"1", "2", "/large", 1},
+      {"1", "2", "/small", 1},
+    });
+
+  // Data in 12 fragments is not reassembled, smaller Data is
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/large"}, {"Frequency", "1"}},
+          "0s", "0.5s"},
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/small"}, {"Frequency", "1"}},
+          "0s", "0.5s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/large"}, {"PayloadSize", "16384"}},
+          "0s", "100s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/small"}, {"PayloadSize", "4096"}},
+          "0s", "100s"}
+    });
+
+  shared_ptr<NetDeviceFace> face = std::dynamic_pointer_cast<NetDeviceFace>(getFace("1", "2"));
+  BOOST_REQUIRE(face != nullptr);
+
+  Simulator::Stop(Seconds(2.0));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(face->getFaceStatus().getNInDatas(), 1);
+  BOOST_CHECK_EQUAL(face->GetNPartialPackets(), 0);
+}
+
+static void
+countFrame(uint32_t* nFrames, Ptr<const Packet>)
+{
+  ++*nFrames;
+}
+
+BOOST_AUTO_TEST_CASE(InterestPacking)
+{
+  NodeContainer nodes;
+  nodes.Create(2);
+
+  PointToPointHelper p2p;
+  p2p.Install(nodes.Get(0), nodes.Get(1));
+
+  StackHelper ndnHelper;
+  ndnHelper.EnableInterestPacking(PointToPointNetDevice::GetTypeId(), MilliSeconds(1));
+  ndnHelper.Install(nodes);
+
+  FibHelper::AddRoute(nodes.Get(0), "/", nodes.Get(1), 1);
+
+  // three consumers send Interests at the same time
+  for (int i = 0; i < 3; ++i) {
+    AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+    consumerHelper.SetPrefix("/prefix/" + std::to_string(i));
+    consumerHelper.SetAttribute("Frequency", StringValue("10"));
+    consumerHelper.Install(nodes.Get(0)).Stop(Seconds(9.99));
+  }
+
+  AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix("/prefix");
+  producerHelper.SetAttribute("PayloadSize", StringValue("100"));
+  producerHelper.Install(nodes.Get(1));
+
+  uint32_t nFrames = 0;
+  nodes.Get(0)->GetDevice(0)->TraceConnectWithoutContext("MacTx",
+                                                         MakeBoundCallback(&countFrame, &nFrames));
+
+  Simulator::Stop(Seconds(20.001));
+  Simulator::Run();
+
+  shared_ptr<Face> producerFace =
+    nodes.Get(1)->GetObject<L3Protocol>()->getFaceByNetDevice(nodes.Get(1)->GetDevice(0));
+  BOOST_CHECK_EQUAL(producerFace->getFaceStatus().getNInInterests(), 300);
+  BOOST_CHECK_EQUAL(producerFace->getFaceStatus().getNOutDatas(), 300);
+  BOOST_CHECK_EQUAL(nFrames, 100);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -21,6 +21,7 @@
 #include "helper/ndn-stack-helper.hpp"
 #include "model/ndn-header.hpp"
 #include "utils/ndn-ns3-packet-tag.hpp"
+#include "utils/ndn-fw-hop-count-tag.hpp"
 
 #include <ndn-cxx/encoding/block.hpp>
 #include <ndn-cxx/interest.hpp>
@@ -54,6 +55,24 @@ BOOST_AUTO_TEST_CASE(ToPacket)
   BOOST_CHECK_EQUAL(type2, ::ndn::tlv::Data);
 }
 
+BOOST_AUTO_TEST_CASE(FromPacketMetadata)
+{
+  auto interest = make_shared<ndn::Interest>("/prefix");
+  BOOST_CHECK_EQUAL(Ns3PacketTag::hopCountOf(*interest), -1);
+
+  Ptr<Packet> packet = Convert::ToPacket(*interest);
+  packet->AddPacketTag(FwHopCountTag(3));
+
+  shared_ptr<const Interest> received = Convert::FromPacket<Interest>(packet);
+  BOOST_CHECK_EQUAL(received->getName(), interest->getName());
+  BOOST_CHECK_EQUAL(Ns3PacketTag::hopCountOf(*received), 3);
+
+  // hop count lives in the metadata slot only, stored packet has no stale tags
+  FwHopCountTag tag;
+  BOOST_CHECK(!received->getTag<Ns3PacketTag>()->getPacket()->PeekPacketTag(tag));
+  BOOST_CHECK(!Convert::ToPacket(*received)->PeekPacketTag(tag));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
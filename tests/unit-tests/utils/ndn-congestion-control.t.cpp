@@ -0,0 +1,138 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-congestion-control-aimd.hpp"
+#include "utils/ndn-congestion-control-cubic.hpp"
+#include "utils/ndn-congestion-control-rtt-gradient.hpp"
+
+#include "ns3/simulator.h"
+
+#include <vector>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnCongestionControl, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(Aimd)
+{
+  Ptr<CongestionControl> cc = CreateObject<CongestionControlAimd>();
+  cc->Reset();
+  BOOST_CHECK_EQUAL(cc->GetWindow(), 1.0);
+
+  // slow start: one Interest per Data
+  for (int i = 0; i < 15; i++) {
+    cc->OnData(MilliSeconds(100));
+  }
+  BOOST_CHECK_EQUAL(cc->GetWindow(), 16.0);
+  BOOST_CHECK_EQUAL(cc->GetSmoothedRtt(), MilliSeconds(100));
+
+  cc->OnTimeout();
+  BOOST_CHECK_EQUAL(cc->GetWindow(), 8.0);
+
+  // further timeouts within the same RTT belong to the same congestion event
+  cc->OnTimeout();
+  BOOST_CHECK_EQUAL(cc->GetWindow(), 8.0);
+
+  // congestion avoidance: one Interest per window of Data
+  for (int i = 0; i < 8; i++) {
+    cc->OnData(MilliSeconds(100));
+  }
+  BOOST_CHECK_CLOSE(cc->GetWindow(), 9.0, 5.0);
+}
+
+static void
+receiveData(Ptr<CongestionControl> cc)
+{
+  cc->OnData(MilliSeconds(100));
+}
+
+static void
+sampleWindow(Ptr<CongestionControl> cc, std::vector<double>* window)
+{
+  window->push_back(cc->GetWindow());
+}
+
+BOOST_AUTO_TEST_CASE(Cubic)
+{
+  Ptr<CongestionControl> cc = CreateObject<CongestionControlCubic>();
+  cc->Reset();
+  for (int i = 0; i < 99; i++) {
+    cc->OnData(MilliSeconds(100));
+  }
+  BOOST_CHECK_EQUAL(cc->GetWindow(), 100.0);
+
+  cc->OnTimeout();
+  BOOST_CHECK_CLOSE(cc->GetWindow(), 70.0, 0.001);
+
+  // one Data per millisecond (about one window per RTT), window sampled every second
+  for (int ms = 1; ms <= 7000; ms++) {
+    Simulator::Schedule(MilliSeconds(ms), &receiveData, cc);
+  }
+  std::vector<double> window;
+  for (int s = 1; s <= 7; s++) {
+    Simulator::Schedule(Seconds(s) + MicroSeconds(500), &sampleWindow, cc, &window);
+  }
+
+  Simulator::Run();
+  BOOST_REQUIRE_EQUAL(window.size(), 7);
+
+  for (size_t i = 1; i < window.size(); i++) {
+    BOOST_CHECK_GE(window[i], window[i - 1]);
+  }
+
+  // W(t) = Wmax + C (t - K)^3 with K = cbrt(Wmax (1 - beta) / C) = 4.2s: concave growth
+  // towards Wmax = 100 ...
+  BOOST_CHECK_GT(window[0], 80.0);
+  BOOST_CHECK_LT(window[0], 92.0);
+  BOOST_CHECK_GT(window[1] - window[0], window[2] - window[1]);
+  BOOST_CHECK_GT(window[2] - window[1], window[3] - window[2]);
+
+  // ... a plateau around Wmax ...
+  BOOST_CHECK_CLOSE(window[3], 100.0, 1.0);
+  BOOST_CHECK_CLOSE(window[4], 100.0, 1.5);
+
+  // ... and convex growth beyond it
+  BOOST_CHECK_GT(window[6] - window[5], window[5] - window[4]);
+  BOOST_CHECK_GT(window[6], 105.0);
+}
+
+BOOST_AUTO_TEST_CASE(RttGradient)
+{
+  Ptr<CongestionControl> cc = CreateObject<CongestionControlRttGradient>();
+  cc->Reset();
+
+  // constant RTT: the window grows
+  for (int i = 0; i < 9; i++) {
+    cc->OnData(MilliSeconds(100));
+  }
+  BOOST_CHECK_EQUAL(cc->GetWindow(), 10.0);
+
+  // increasing RTT: the window is reduced without any timeout
+  cc->OnData(MilliSeconds(150));
+  BOOST_CHECK_LT(cc->GetWindow(), 10.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
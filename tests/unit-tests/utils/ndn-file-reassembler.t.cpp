@@ -0,0 +1,125 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-file-reassembler.hpp"
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_OUTFILE =
+  boost::filesystem::path(TEST_CONFIG_PATH) / "reassembled.bin";
+
+class FileReassemblerFixture : public CleanupFixture
+{
+public:
+  FileReassemblerFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+
+    // 10 chunks of 100 bytes and a last chunk of 50 bytes
+    for (size_t i = 0; i < 1050; i++) {
+      content.push_back(static_cast<char>('a' + (i * 7 + i / 100) % 26));
+    }
+  }
+
+  ~FileReassemblerFixture()
+  {
+    boost::filesystem::remove(TEST_OUTFILE);
+  }
+
+  void
+  write(FileReassembler& reassembler, uint32_t index)
+  {
+    // the last chunk is padded like a Data packet payload of full size
+    std::string chunk = content.substr(index * 100, 100);
+    chunk.resize(100, '\0');
+    reassembler.Write(index, reinterpret_cast<const uint8_t*>(chunk.data()), chunk.size());
+  }
+
+  std::string
+  readOutfile()
+  {
+    boost::filesystem::ifstream is(TEST_OUTFILE, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+  }
+
+public:
+  std::string content;
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnFileReassembler, FileReassemblerFixture)
+
+BOOST_AUTO_TEST_CASE(OutOfOrderChunks)
+{
+  FileReassembler reassembler;
+  BOOST_REQUIRE(reassembler.Open(TEST_OUTFILE.string(), content.size(), 100, 3, false));
+
+  // 2 and 1 are buffered, 6 and 10 are too far ahead and written directly, 0 flushes 1 and 2,
+  // 4 is buffered and stays behind the hole at 3 until it is filled
+  for (uint32_t index : {2, 1, 6, 10, 0, 4, 2, 3, 5, 8, 7, 9, 6}) {
+    write(reassembler, index);
+  }
+  BOOST_CHECK_EQUAL(reassembler.GetPeakBufferedBytes(), 200);
+
+  reassembler.Close();
+  BOOST_CHECK(readOutfile() == content);
+}
+
+BOOST_AUTO_TEST_CASE(CloseWithBufferedChunks)
+{
+  FileReassembler reassembler;
+  BOOST_REQUIRE(reassembler.Open(TEST_OUTFILE.string(), content.size(), 100, 10, false));
+
+  // chunk 0 never arrives, so all other chunks are still buffered when the file is closed
+  for (uint32_t index : {1, 2, 3, 5, 6, 10, 9, 8, 7, 4}) {
+    write(reassembler, index);
+  }
+  BOOST_CHECK_EQUAL(reassembler.GetPeakBufferedBytes(), 950);
+
+  reassembler.Close();
+  std::string written = readOutfile();
+  BOOST_REQUIRE_EQUAL(written.size(), content.size());
+  BOOST_CHECK(written.substr(0, 100) == std::string(100, '\0'));
+  BOOST_CHECK(written.substr(100) == content.substr(100));
+}
+
+BOOST_AUTO_TEST_CASE(OutOfOrderChunksMmap)
+{
+  FileReassembler reassembler;
+  BOOST_REQUIRE(reassembler.Open(TEST_OUTFILE.string(), content.size(), 100, 3, true));
+
+  for (uint32_t index : {10, 3, 0, 9, 1, 2, 8, 4, 7, 5, 6, 0}) {
+    write(reassembler, index);
+  }
+  BOOST_CHECK_EQUAL(reassembler.GetPeakBufferedBytes(), 0);
+
+  reassembler.Close();
+  BOOST_CHECK(readOutfile() == content);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
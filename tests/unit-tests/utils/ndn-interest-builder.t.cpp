@@ -0,0 +1,90 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-interest-builder.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnInterestBuilder, CleanupFixture)
+
+static void
+checkEncoding(const Interest& built, const Name& name, const Time& lifetime)
+{
+  BOOST_CHECK_EQUAL(built.getName(), name);
+
+  // reference Interest encoded by ndn-cxx, with the same nonce
+  Interest expected(name);
+  expected.setNonce(built.getNonce());
+  expected.setInterestLifetime(::ndn::time::milliseconds(lifetime.GetMilliSeconds()));
+
+  const Block& expectedWire = expected.wireEncode();
+  const Block& builtWire = built.wireEncode();
+  BOOST_CHECK_EQUAL_COLLECTIONS(builtWire.begin(), builtWire.end(),
+                                expectedWire.begin(), expectedWire.end());
+}
+
+BOOST_AUTO_TEST_CASE(SequenceNumbers)
+{
+  InterestBuilder builder;
+
+  for (const Name& prefix : {Name("/prefix"), Name("/a/longer/prefix/%FD%01")}) {
+    for (uint64_t seq : {0ull, 252ull, 253ull, 65535ull, 65536ull, 4294967296ull}) {
+      for (const Time& lifetime : {MilliSeconds(0), MilliSeconds(1), Seconds(2), Seconds(4),
+                                   Seconds(100)}) {
+        shared_ptr<Interest> interest = builder.Build(prefix, seq, lifetime);
+        checkEncoding(*interest, Name(prefix).appendSequenceNumber(seq), lifetime);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Names)
+{
+  InterestBuilder builder;
+
+  for (const Name& name : {Name("/"), Name("/manifest"), Name("/file/video.mp4/manifest")}) {
+    for (const Time& lifetime : {MilliSeconds(500), Seconds(4)}) {
+      shared_ptr<Interest> interest = builder.Build(name, lifetime);
+      checkEncoding(*interest, name, lifetime);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(LargeName)
+{
+  InterestBuilder builder;
+
+  // name longer than 253 bytes needs a 3-byte TLV length
+  Name prefix;
+  for (int i = 0; i < 30; i++) {
+    prefix.append("component-" + std::to_string(i));
+  }
+
+  shared_ptr<Interest> interest = builder.Build(prefix, 42, Seconds(1));
+  checkEncoding(*interest, Name(prefix).appendSequenceNumber(42), Seconds(1));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
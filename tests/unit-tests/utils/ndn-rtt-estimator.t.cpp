@@ -0,0 +1,169 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-rtt-min-filter.hpp"
+#include "utils/ndn-rtt-windowed-percentile.hpp"
+
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+#include "ns3/double.h"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnRttEstimator, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(MinFilterWindowExpiry)
+{
+  Ptr<RttEstimator> rtt = CreateObject<RttMinFilter>();
+  rtt->SetAttribute("WindowSize", UintegerValue(4));
+
+  rtt->Measurement(MilliSeconds(100));
+  BOOST_CHECK_EQUAL(rtt->GetCurrentEstimate(), MilliSeconds(100));
+
+  rtt->Measurement(MilliSeconds(50));
+  rtt->Measurement(MilliSeconds(80));
+  rtt->Measurement(MilliSeconds(90));
+  BOOST_CHECK_EQUAL(rtt->GetCurrentEstimate(), MilliSeconds(50));
+
+  // 120ms replaces the oldest sample (100ms), the minimum is still in the window
+  rtt->Measurement(MilliSeconds(120));
+  BOOST_CHECK_EQUAL(rtt->GetCurrentEstimate(), MilliSeconds(50));
+
+  // 130ms replaces 50ms, the next smallest sample becomes the minimum
+  rtt->Measurement(MilliSeconds(130));
+  BOOST_CHECK_EQUAL(rtt->GetCurrentEstimate(), MilliSeconds(80));
+
+  rtt->Measurement(MilliSeconds(140));
+  rtt->Measurement(MilliSeconds(150));
+  BOOST_CHECK_EQUAL(rtt->GetCurrentEstimate(), MilliSeconds(120));
+
+  // the RTO never goes below the minimum
+  BOOST_CHECK_GE(rtt->RetransmitTimeout(), rtt->GetCurrentEstimate());
+
+  rtt->Reset();
+  rtt->Measurement(MilliSeconds(200));
+  BOOST_CHECK_EQUAL(rtt->GetCurrentEstimate(), MilliSeconds(200));
+}
+
+BOOST_AUTO_TEST_CASE(WindowedPercentileSelection)
+{
+  Ptr<RttEstimator> rtt = CreateObject<RttWindowedPercentile>();
+  rtt->SetAttribute("WindowSize", UintegerValue(10));
+  rtt->SetAttribute("Percentile", DoubleValue(0.9));
+  rtt->SetMinRto(Seconds(0));
+
+  // 10ms .. 100ms in arbitrary order
+  const int samples[] = {100, 10, 90, 20, 80, 30, 70, 40, 60, 50};
+  for (int sample : samples) {
+    rtt->Measurement(MilliSeconds(sample));
+  }
+
+  // estimate is the median, RTO is the 90th percentile of the window
+  BOOST_CHECK_EQUAL(rtt->GetCurrentEstimate(), MilliSeconds(60));
+  BOOST_CHECK_EQUAL(rtt->RetransmitTimeout(), MilliSeconds(100));
+  BOOST_CHECK_EQUAL(rtt->GetVariation(), MilliSeconds(40));
+
+  // five 10ms samples push 100, 10, 90, 20 and 80ms out of the window
+  for (int i = 0; i < 5; i++) {
+    rtt->Measurement(MilliSeconds(10));
+  }
+  BOOST_CHECK_EQUAL(rtt->GetCurrentEstimate(), MilliSeconds(30));
+  BOOST_CHECK_EQUAL(rtt->RetransmitTimeout(), MilliSeconds(70));
+
+  // MinRTO still bounds the timeout
+  rtt->SetMinRto(MilliSeconds(200));
+  BOOST_CHECK_EQUAL(rtt->RetransmitTimeout(), MilliSeconds(200));
+}
+
+static void
+send(Ptr<RttEstimator> rtt, uint32_t first, uint32_t last)
+{
+  for (uint32_t seq = first; seq <= last; seq++)
+    rtt->SentSeq(SequenceNumber32(seq), 1);
+}
+
+static void
+ack(Ptr<RttEstimator> rtt, uint32_t seq, Time* sample)
+{
+  *sample = rtt->AckSeq(SequenceNumber32(seq));
+}
+
+BOOST_AUTO_TEST_CASE(KarnAndReordering)
+{
+  Ptr<RttEstimator> rtt = CreateObject<RttMinFilter>();
+
+  Time sample1, sample2, sample2Dup, sample3, unsolicited;
+  Simulator::Schedule(MilliSeconds(0), &send, rtt, 1, 3);
+  Simulator::Schedule(MilliSeconds(100), &send, rtt, 2, 2); // retransmission
+  Simulator::Schedule(MilliSeconds(150), &ack, rtt, 3, &sample3);
+  Simulator::Schedule(MilliSeconds(200), &ack, rtt, 1, &sample1);
+  Simulator::Schedule(MilliSeconds(250), &ack, rtt, 2, &sample2);
+  Simulator::Schedule(MilliSeconds(260), &ack, rtt, 2, &sample2Dup);
+  Simulator::Schedule(MilliSeconds(270), &ack, rtt, 7, &unsolicited);
+
+  Simulator::Run();
+
+  // Data arriving out of order still yields samples for the other sequences
+  BOOST_CHECK_EQUAL(sample3, MilliSeconds(150));
+  BOOST_CHECK_EQUAL(sample1, MilliSeconds(200));
+
+  // retransmitted, duplicate and unsolicited sequences yield no sample
+  BOOST_CHECK_EQUAL(sample2, Seconds(0));
+  BOOST_CHECK_EQUAL(sample2Dup, Seconds(0));
+  BOOST_CHECK_EQUAL(unsolicited, Seconds(0));
+
+  BOOST_CHECK_EQUAL(rtt->GetCurrentEstimate(), MilliSeconds(150));
+}
+
+BOOST_AUTO_TEST_CASE(HistoryRing)
+{
+  Ptr<RttEstimator> rtt = CreateObject<RttMinFilter>();
+  rtt->SetMaxRto(Seconds(1));
+
+  // more outstanding sequences than the initial ring size, acknowledged in reverse order
+  std::vector<Time> samples(200);
+  Simulator::Schedule(MilliSeconds(0), &send, rtt, 0, 199);
+  for (uint32_t seq = 0; seq < 200; seq++)
+    Simulator::Schedule(MilliSeconds(10) + MicroSeconds(199 - seq), &ack, rtt, seq, &samples[seq]);
+
+  // the ring has grown to 256 slots: 1256 maps to the slot of 1000, which has been outstanding
+  // for more than MaxRTO and is replaced
+  Time abandoned, replacing;
+  Simulator::Schedule(Seconds(2), &send, rtt, 1000, 1000);
+  Simulator::Schedule(Seconds(5), &send, rtt, 1000 + 256, 1000 + 256);
+  Simulator::Schedule(Seconds(5.1), &ack, rtt, 1000 + 256, &replacing);
+  Simulator::Schedule(Seconds(5.2), &ack, rtt, 1000, &abandoned);
+
+  Simulator::Run();
+
+  for (uint32_t seq = 0; seq < 200; seq++)
+    BOOST_CHECK_EQUAL(samples[seq], MilliSeconds(10) + MicroSeconds(199 - seq));
+
+  BOOST_CHECK_EQUAL(replacing, MilliSeconds(100));
+  BOOST_CHECK_EQUAL(abandoned, Seconds(0));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,294 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-segment-transfer-model.hpp"
+#include "apps/ndn-app.hpp"
+
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class SegmentTransferModelFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  SegmentTransferModelFixture()
+  {
+    Config::SetDefault("ns3::ndn::SegmentTransferModel::CacheSize", UintegerValue(10000000));
+  }
+
+  ~SegmentTransferModelFixture()
+  {
+    Config::SetDefault("ns3::ndn::SegmentTransferModel::CacheSize", UintegerValue(0));
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnSegmentTransferModel, SegmentTransferModelFixture)
+
+static void
+recordCompletion(Time* completion, uint64_t size)
+{
+  BOOST_CHECK_EQUAL(size, 1000000);
+  *completion = Simulator::Now();
+}
+
+static void
+recordFailure(Time* failure)
+{
+  *failure = Simulator::Now();
+}
+
+static void
+requestOrFail(Ptr<Node> node, std::string name, Time* completion, Time* failure)
+{
+  SegmentTransferModel::Get()->Request(node, name, 1000000,
+                                       MakeBoundCallback(&recordCompletion, completion),
+                                       MakeBoundCallback(&recordFailure, failure));
+}
+
+static void
+request(Ptr<Node> node, std::string name, Time* completion)
+{
+  static Time failure;
+  requestOrFail(node, name, completion, &failure);
+}
+
+BOOST_AUTO_TEST_CASE(FairSharingCachingAggregation)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+
+  createTopology({
+      {"1", "2"},
+      {"2", "3"},
+      {"4", "2"},
+    });
+
+  addRoutes({
+      {"1", "2", "/prefix", 1},
+      {"4", "2", "/prefix", 1},
+      {"2", "3", "/prefix", 1},
+    });
+
+  addApps({
+      {"3", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}},
+          "0s", "100s"}
+    });
+
+  // /prefix/a and /prefix/b share the 3 -> 2 link: 1MB at 5Mbps each
+  Time a, b;
+  Simulator::Schedule(Seconds(1), &request, getNode("1"), "/prefix/a", &a);
+  Simulator::Schedule(Seconds(1), &request, getNode("4"), "/prefix/b", &b);
+
+  // /prefix/a is in the caches of nodes 1 and 2
+  Time aLocal, aCached;
+  Simulator::Schedule(Seconds(5), &request, getNode("1"), "/prefix/a", &aLocal);
+  Simulator::Schedule(Seconds(5), &request, getNode("4"), "/prefix/a", &aCached);
+
+  // the request of node 4 is aggregated on node 2
+  Time c, cAggregated;
+  Simulator::Schedule(Seconds(10), &request, getNode("1"), "/prefix/c", &c);
+  Simulator::Schedule(Seconds(10), &request, getNode("4"), "/prefix/c", &cAggregated);
+
+  Simulator::Stop(Seconds(20));
+  Simulator::Run();
+
+  BOOST_CHECK_CLOSE(a.GetSeconds(), 1.0 + 0.02 + 1.6 + 0.02, 0.001);
+  BOOST_CHECK_CLOSE(b.GetSeconds(), 1.0 + 0.02 + 1.6 + 0.02, 0.001);
+
+  BOOST_CHECK_CLOSE(aLocal.GetSeconds(), 5.0, 0.001);
+  BOOST_CHECK_CLOSE(aCached.GetSeconds(), 5.0 + 0.01 + 0.8 + 0.01, 0.001);
+
+  BOOST_CHECK_CLOSE(c.GetSeconds(), 10.0 + 0.02 + 0.8 + 0.02, 0.001);
+  BOOST_CHECK_CLOSE(cAggregated.GetSeconds(), c.GetSeconds() + 0.01, 0.001);
+
+  BOOST_CHECK_EQUAL(SegmentTransferModel::Get()->GetNTransfers(), 0);
+}
+
+static void
+setDataRate(Ptr<Node> node, std::string rate)
+{
+  for (uint32_t i = 0; i < node->GetNDevices(); i++)
+    node->GetDevice(i)->SetAttribute("DataRate", StringValue(rate));
+}
+
+BOOST_AUTO_TEST_CASE(DataRateChange)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+
+  createTopology({
+      {"1", "2"},
+    });
+
+  addRoutes({
+      {"1", "2", "/prefix", 1},
+    });
+
+  addApps({
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}},
+          "0s", "100s"}
+    });
+
+  Time a, b;
+  Simulator::Schedule(Seconds(1), &request, getNode("1"), "/prefix/a", &a);
+  Simulator::Schedule(Seconds(3), &setDataRate, getNode("2"), "20Mbps");
+  Simulator::Schedule(Seconds(4), &request, getNode("1"), "/prefix/b", &b);
+
+  Simulator::Stop(Seconds(10));
+  Simulator::Run();
+
+  BOOST_CHECK_CLOSE(a.GetSeconds(), 1.0 + 0.01 + 0.8 + 0.01, 0.001);
+  BOOST_CHECK_CLOSE(b.GetSeconds(), 4.0 + 0.01 + 0.4 + 0.01, 0.001);
+}
+
+BOOST_AUTO_TEST_CASE(Failures)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+
+  createTopology({
+      {"1", "2"},
+      {"2", "3"},
+    });
+
+  // /loop bounces between nodes 1 and 2, /none has no route on node 2
+  addRoutes({
+      {"1", "2", "/prefix", 1},
+      {"2", "3", "/prefix", 1},
+      {"1", "2", "/loop", 1},
+      {"2", "1", "/loop", 1},
+      {"1", "2", "/none", 1},
+    });
+
+  addApps({
+      {"3", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}},
+          "0s", "100s"}
+    });
+
+  Time loop, loopFailure;
+  Simulator::Schedule(Seconds(1), &requestOrFail, getNode("1"), "/loop/a", &loop, &loopFailure);
+
+  Time none, noneFailure;
+  Simulator::Schedule(Seconds(1), &requestOrFail, getNode("1"), "/none/a", &none, &noneFailure);
+
+  // the link 3 -> 2 stops while /prefix/a is draining (2.02s to 2.82s), the request
+  // aggregated on node 2 fails with it
+  Time a, aFailure, aAggregated, aAggregatedFailure;
+  Simulator::Schedule(Seconds(2), &requestOrFail, getNode("1"), "/prefix/a", &a, &aFailure);
+  Simulator::Schedule(Seconds(2), &requestOrFail, getNode("2"), "/prefix/a", &aAggregated,
+                      &aAggregatedFailure);
+  Simulator::Schedule(Seconds(2.1), &setDataRate, getNode("3"), "0bps");
+
+  // the DataRate applies once /prefix/b starts to flow at 2.22s, which fails both flows
+  Time b, bFailure;
+  Simulator::Schedule(Seconds(2.2), &requestOrFail, getNode("1"), "/prefix/b", &b, &bFailure);
+
+  Simulator::Stop(Seconds(10));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(loop, Seconds(0));
+  BOOST_CHECK_EQUAL(loopFailure, Seconds(1));
+  BOOST_CHECK_EQUAL(none, Seconds(0));
+  BOOST_CHECK_EQUAL(noneFailure, Seconds(1));
+
+  BOOST_CHECK_EQUAL(a, Seconds(0));
+  BOOST_CHECK_EQUAL(aAggregated, Seconds(0));
+  BOOST_CHECK_EQUAL(b, Seconds(0));
+  BOOST_CHECK_CLOSE(aFailure.GetSeconds(), 2.22, 0.001);
+  BOOST_CHECK_CLOSE(aAggregatedFailure.GetSeconds(), 2.22, 0.001);
+  BOOST_CHECK_CLOSE(bFailure.GetSeconds(), 2.22, 0.001);
+
+  BOOST_CHECK_EQUAL(SegmentTransferModel::Get()->GetNTransfers(), 0);
+}
+
+static void
+recordDownload(Time* completion, Ptr<App> app, shared_ptr<const Name> name, double speed,
+               long milliSeconds)
+{
+  *completion = Simulator::Now();
+}
+
+BOOST_AUTO_TEST_CASE(PacketLevelComparison)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+
+  const boost::filesystem::path filelist =
+    boost::filesystem::path(TEST_CONFIG_PATH) / "filelist.csv";
+  boost::filesystem::create_directories(TEST_CONFIG_PATH);
+  boost::filesystem::ofstream(filelist) << "file.bin,1000000" << std::endl;
+
+  createTopology({
+      {"1", "2"},
+    });
+
+  addRoutes({
+      {"1", "2", "/prefix", 1},
+    });
+
+  // 800 chunks/s of at most 1500 bytes keep the 10Mbps link just below saturation
+  addApps({
+      {"2", "ns3::ndn::FakeFileServer",
+          {{"Prefix", "/prefix"}, {"MetaDataFile", filelist.string()}},
+          "0s", "100s"},
+      {"1", "ns3::ndn::FileConsumerCbr",
+          {{"FileToRequest", "/prefix/file.bin"}, {"WindowSize", "800"}},
+          "5s", "100s"}
+    });
+
+  // the fast-mode transfer is over before the packet-level download starts
+  Time fast;
+  Simulator::Schedule(Seconds(1), &request, getNode("1"), "/prefix/file.bin", &fast);
+
+  Time packetLevel;
+  Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/FileDownloadFinished",
+                                MakeBoundCallback(&recordDownload, &packetLevel));
+
+  Simulator::Stop(Seconds(10));
+  Simulator::Run();
+
+  boost::filesystem::remove(filelist);
+
+  double fastTime = (fast - Seconds(1)).GetSeconds();
+  double packetLevelTime = (packetLevel - Seconds(5)).GetSeconds();
+  BOOST_TEST_MESSAGE("fast mode: " << fastTime << "s, packet level: " << packetLevelTime << "s");
+
+  // one RTT less (no manifest), no header overhead and no pacing: fast mode is a lower bound,
+  // but stays within 20% of the packet-level download
+  BOOST_CHECK_CLOSE(fastTime, 0.01 + 0.8 + 0.01, 0.001);
+  BOOST_REQUIRE_GT(packetLevel, Seconds(5));
+  BOOST_CHECK_GT(packetLevelTime, fastTime);
+  BOOST_CHECK_LT(packetLevelTime, fastTime * 1.2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,101 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/l2-queue-tracer.hpp"
+
+#include "ns3/point-to-point-net-device.h"
+#include "ns3/data-rate.h"
+
+#include <iterator>
+#include <sstream>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersL2QueueTracer, ScenarioHelperWithCleanupFixture)
+
+static void
+setDataRate(Ptr<NetDevice> device, std::string rate)
+{
+  device->SetAttribute("DataRate", StringValue(rate));
+}
+
+BOOST_AUTO_TEST_CASE(UtilizationOfLoadedLink)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("1Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+  createTopology({
+      {"1", "2"},
+    });
+
+  addRoutes({
+      {"1", "2", "/prefix", 1},
+    });
+
+  // ~100 Data packets of ~1100 bytes per second load the 1Mbps link 2 -> 1 to ~88%
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "100"}},
+          "0s", "100s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+          "0s", "100s"}
+    });
+
+  auto output = make_shared<std::stringstream>();
+  Ptr<L2QueueTracer> tracer = Create<L2QueueTracer>(output, getNode("2"));
+
+  // utilization has to follow the rate of the link (node 2 has a single device)
+  Simulator::Schedule(Seconds(5.5), &setDataRate, getNode("2")->GetDevice(0), "2Mbps");
+
+  Simulator::Stop(Seconds(10.001));
+  Simulator::Run();
+
+  tracer = nullptr;
+
+  std::map<int, double> utilization;
+  std::string line;
+  while (std::getline(*output, line)) {
+    std::istringstream row(line);
+    std::vector<std::string> fields{std::istream_iterator<std::string>(row),
+                                    std::istream_iterator<std::string>()};
+    BOOST_REQUIRE_EQUAL(fields.size(), 14);
+    utilization[std::stoi(fields[0])] = std::stod(fields[13]);
+  }
+
+  BOOST_REQUIRE_EQUAL(utilization.size(), 10);
+  for (int time = 2; time <= 5; time++) {
+    BOOST_CHECK_GT(utilization[time], 0.8);
+    BOOST_CHECK_LT(utilization[time], 0.95);
+  }
+  for (int time = 7; time <= 10; time++) {
+    BOOST_CHECK_GT(utilization[time], 0.4);
+    BOOST_CHECK_LT(utilization[time], 0.475);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
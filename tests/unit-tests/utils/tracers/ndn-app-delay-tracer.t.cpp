@@ -140,6 +140,128 @@ BOOST_AUTO_TEST_CASE(InstallNode)
     "3.02087	2	0	1	FullDelay	0.0208712	20871.2	1	1\n");
 }
 
+BOOST_AUTO_TEST_CASE(AppInstalledAfterTracer)
+{
+  AppDelayTracer::Install(getNode("2"), TEST_TRACE.string());
+
+  // tracer has to pick up applications installed after it
+  addApps({
+      {"2", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "1"}},
+          "2s", "3.5s"}
+    });
+
+  Simulator::Stop(Seconds(4));
+  Simulator::Run();
+
+  AppDelayTracer::Destroy(); // to force log to be written
+
+  std::ifstream t(TEST_TRACE.string().c_str());
+  std::stringstream buffer;
+  buffer << t.rdbuf();
+
+  BOOST_CHECK_EQUAL(buffer.str(),
+    "Time	Node	AppId	SeqNo	Type	DelayS	DelayUS	RetxCount	HopCount\n"
+    "2	2	0	0	LastDelay	0	0	1	0\n"
+    "2	2	0	0	FullDelay	0	0	1	0\n"
+    "2	2	1	0	LastDelay	0	0	1	0\n"
+    "2	2	1	0	FullDelay	0	0	1	0\n"
+    "3.02087	2	0	1	LastDelay	0.0208712	20871.2	1	1\n"
+    "3.02087	2	0	1	FullDelay	0.0208712	20871.2	1	1\n"
+    "3.02087	2	1	1	LastDelay	0.0208712	20871.2	1	1\n"
+    "3.02087	2	1	1	FullDelay	0.0208712	20871.2	1	1\n");
+}
+
+BOOST_AUTO_TEST_CASE(InstallAllAggregated)
+{
+  AppDelayTracer::InstallAllAggregated(TEST_TRACE.string(), Seconds(0.7));
+
+  Simulator::Stop(Seconds(4));
+  Simulator::Run();
+
+  AppDelayTracer::Destroy(); // to force log (and summaries for the whole run) to be written
+
+  std::ifstream t(TEST_TRACE.string().c_str());
+  std::stringstream buffer;
+  buffer << t.rdbuf();
+
+  BOOST_CHECK_EQUAL(buffer.str(),
+    "Time	Node	AppId	Interval	Metric	Count	Min	Mean	P50	P90	P99	Max\n"
+    "0.7	1	0	Period	LastDelayUS	1	41742	41742	41742	41742	41742	41742\n"
+    "0.7	1	0	Period	FullDelayUS	1	41742	41742	41742	41742	41742	41742\n"
+    "0.7	1	0	Period	RetxCount	1	1	1	1	1	1	1\n"
+    "0.7	1	0	Period	HopCount	1	2	2	2	2	2	2\n"
+    "2.1	2	0	Period	LastDelayUS	1	0	0	0	0	0	0\n"
+    "2.1	2	0	Period	FullDelayUS	1	0	0	0	0	0	0\n"
+    "2.1	2	0	Period	RetxCount	1	1	1	1	1	1	1\n"
+    "2.1	2	0	Period	HopCount	1	0	0	0	0	0	0\n"
+    "3.5	2	0	Period	LastDelayUS	1	20871	20871	20871	20871	20871	20871\n"
+    "3.5	2	0	Period	FullDelayUS	1	20871	20871	20871	20871	20871	20871\n"
+    "3.5	2	0	Period	RetxCount	1	1	1	1	1	1	1\n"
+    "3.5	2	0	Period	HopCount	1	1	1	1	1	1	1\n"
+    "4	1	0	Total	LastDelayUS	1	41742	41742	41742	41742	41742	41742\n"
+    "4	1	0	Total	FullDelayUS	1	41742	41742	41742	41742	41742	41742\n"
+    "4	1	0	Total	RetxCount	1	1	1	1	1	1	1\n"
+    "4	1	0	Total	HopCount	1	2	2	2	2	2	2\n"
+    "4	2	0	Total	LastDelayUS	2	0	10435.5	0	20871	20871	20871\n"
+    "4	2	0	Total	FullDelayUS	2	0	10435.5	0	20871	20871	20871\n"
+    "4	2	0	Total	RetxCount	2	1	1	1	1	1	1\n"
+    "4	2	0	Total	HopCount	2	0	0.5	0	1	1	1\n");
+}
+
+static void
+readTrace(std::string* content)
+{
+  std::ifstream t(TEST_TRACE.string().c_str());
+  std::stringstream buffer;
+  buffer << t.rdbuf();
+  *content = buffer.str();
+}
+
+BOOST_AUTO_TEST_CASE(InstallAllAggregatedTotalsBeforeMerge)
+{
+  AppDelayTracer::InstallAllAggregated(TEST_TRACE.string(), Seconds(0.7));
+
+  // in a distributed run, the sink gathers the buffered rows from a destroy hook registered when
+  // the trace is opened; whatever has been written when that hook runs ends up in the merged trace
+  std::string merged;
+  Simulator::ScheduleDestroy(&readTrace, &merged);
+
+  Simulator::Stop(Seconds(4));
+  Simulator::Run();
+  Simulator::Destroy(); // tracers are still alive
+
+  BOOST_CHECK_EQUAL(merged,
+    "Time	Node	AppId	Interval	Metric	Count	Min	Mean	P50	P90	P99	Max\n"
+    "0.7	1	0	Period	LastDelayUS	1	41742	41742	41742	41742	41742	41742\n"
+    "0.7	1	0	Period	FullDelayUS	1	41742	41742	41742	41742	41742	41742\n"
+    "0.7	1	0	Period	RetxCount	1	1	1	1	1	1	1\n"
+    "0.7	1	0	Period	HopCount	1	2	2	2	2	2	2\n"
+    "2.1	2	0	Period	LastDelayUS	1	0	0	0	0	0	0\n"
+    "2.1	2	0	Period	FullDelayUS	1	0	0	0	0	0	0\n"
+    "2.1	2	0	Period	RetxCount	1	1	1	1	1	1	1\n"
+    "2.1	2	0	Period	HopCount	1	0	0	0	0	0	0\n"
+    "3.5	2	0	Period	LastDelayUS	1	20871	20871	20871	20871	20871	20871\n"
+    "3.5	2	0	Period	FullDelayUS	1	20871	20871	20871	20871	20871	20871\n"
+    "3.5	2	0	Period	RetxCount	1	1	1	1	1	1	1\n"
+    "3.5	2	0	Period	HopCount	1	1	1	1	1	1	1\n"
+    "4	1	0	Total	LastDelayUS	1	41742	41742	41742	41742	41742	41742\n"
+    "4	1	0	Total	FullDelayUS	1	41742	41742	41742	41742	41742	41742\n"
+    "4	1	0	Total	RetxCount	1	1	1	1	1	1	1\n"
+    "4	1	0	Total	HopCount	1	2	2	2	2	2	2\n"
+    "4	2	0	Total	LastDelayUS	2	0	10435.5	0	20871	20871	20871\n"
+    "4	2	0	Total	FullDelayUS	2	0	10435.5	0	20871	20871	20871\n"
+    "4	2	0	Total	RetxCount	2	1	1	1	1	1	1\n"
+    "4	2	0	Total	HopCount	2	0	0.5	0	1	1	1\n");
+
+  // destroying the tracers afterwards does not repeat the totals
+  AppDelayTracer::Destroy();
+
+  std::string content;
+  readTrace(&content);
+  BOOST_CHECK_EQUAL(content, merged);
+}
+
 BOOST_AUTO_TEST_CASE(InstallNodeDumpStream)
 {
   auto output = make_shared<boost::test_tools::output_test_stream>();
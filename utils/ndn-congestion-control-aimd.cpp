@@ -0,0 +1,77 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-congestion-control-aimd.hpp"
+#include "ns3/double.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE("ndn.CongestionControlAimd");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(CongestionControlAimd);
+
+TypeId
+CongestionControlAimd::GetTypeId(void)
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::CongestionControlAimd")
+      .SetParent<CongestionControl>()
+      .AddConstructor<CongestionControlAimd>()
+      .AddAttribute("AdditiveIncrease", "Window increase per RTT in congestion avoidance",
+                    DoubleValue(1.0),
+                    MakeDoubleAccessor(&CongestionControlAimd::m_additiveIncrease),
+                    MakeDoubleChecker<double>(0))
+      .AddAttribute("MultiplicativeDecrease", "Window factor on congestion, must be 0 < x < 1",
+                    DoubleValue(0.5),
+                    MakeDoubleAccessor(&CongestionControlAimd::m_multiplicativeDecrease),
+                    MakeDoubleChecker<double>(0, 1));
+  return tid;
+}
+
+CongestionControlAimd::CongestionControlAimd()
+  : m_additiveIncrease(1.0)
+  , m_multiplicativeDecrease(0.5)
+{
+  NS_LOG_FUNCTION(this);
+}
+
+void
+CongestionControlAimd::IncreaseWindow(Time rtt)
+{
+  double cwnd = m_cwnd;
+  if (cwnd < m_ssthresh)
+    SetWindow(cwnd + 1.0); // slow start
+  else
+    SetWindow(cwnd + m_additiveIncrease / cwnd);
+}
+
+void
+CongestionControlAimd::DecreaseWindow()
+{
+  m_ssthresh = std::max(m_cwnd.Get() * m_multiplicativeDecrease, m_minWindow);
+  SetWindow(m_ssthresh);
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,61 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef NDN_CONGESTION_CONTROL_AIMD_H
+#define NDN_CONGESTION_CONTROL_AIMD_H
+
+#include "ndn-congestion-control.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \ingroup ndn-apps
+ *
+ * \brief Additive increase, multiplicative decrease (TCP Reno-style) congestion control
+ *
+ * The window grows by one Interest per Data in slow start and by AdditiveIncrease Interests per
+ * RTT afterwards; a congestion event multiplies it by MultiplicativeDecrease and ends slow
+ * start.
+ */
+class CongestionControlAimd : public CongestionControl {
+public:
+  static TypeId
+  GetTypeId(void);
+
+  CongestionControlAimd();
+
+protected:
+  virtual void
+  IncreaseWindow(Time rtt);
+
+  virtual void
+  DecreaseWindow();
+
+private:
+  double m_additiveIncrease;       // window increase per RTT
+  double m_multiplicativeDecrease; // window factor on congestion
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CONGESTION_CONTROL_AIMD_H
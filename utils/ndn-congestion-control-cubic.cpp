@@ -0,0 +1,138 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-congestion-control-cubic.hpp"
+#include "ns3/simulator.h"
+#include "ns3/double.h"
+#include "ns3/boolean.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <math.h>
+
+NS_LOG_COMPONENT_DEFINE("ndn.CongestionControlCubic");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(CongestionControlCubic);
+
+TypeId
+CongestionControlCubic::GetTypeId(void)
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::CongestionControlCubic")
+      .SetParent<CongestionControl>()
+      .AddConstructor<CongestionControlCubic>()
+      .AddAttribute("C", "Scaling constant of the cubic function", DoubleValue(0.4),
+                    MakeDoubleAccessor(&CongestionControlCubic::m_c),
+                    MakeDoubleChecker<double>(0))
+      .AddAttribute("Beta", "Window factor on congestion, must be 0 < Beta < 1", DoubleValue(0.7),
+                    MakeDoubleAccessor(&CongestionControlCubic::m_beta),
+                    MakeDoubleChecker<double>(0, 1))
+      .AddAttribute("FastConvergence", "Release bandwidth faster when Wmax keeps decreasing",
+                    BooleanValue(true),
+                    MakeBooleanAccessor(&CongestionControlCubic::m_fastConvergence),
+                    MakeBooleanChecker())
+      .AddAttribute("TcpFriendly", "Grow the window at least as fast as AIMD would",
+                    BooleanValue(true),
+                    MakeBooleanAccessor(&CongestionControlCubic::m_tcpFriendly),
+                    MakeBooleanChecker());
+  return tid;
+}
+
+CongestionControlCubic::CongestionControlCubic()
+  : m_c(0.4)
+  , m_beta(0.7)
+  , m_fastConvergence(true)
+  , m_tcpFriendly(true)
+  , m_wMax(0)
+  , m_origin(0)
+  , m_k(0)
+  , m_isEpochStarted(false)
+{
+  NS_LOG_FUNCTION(this);
+}
+
+void
+CongestionControlCubic::Reset()
+{
+  m_wMax = 0;
+  m_isEpochStarted = false;
+  CongestionControl::Reset();
+}
+
+void
+CongestionControlCubic::IncreaseWindow(Time rtt)
+{
+  double cwnd = m_cwnd;
+  if (cwnd < m_ssthresh) {
+    SetWindow(cwnd + 1.0); // slow start
+    return;
+  }
+
+  if (!m_isEpochStarted) {
+    m_isEpochStarted = true;
+    m_epochStart = Simulator::Now();
+    if (cwnd < m_wMax) {
+      m_k = cbrt((m_wMax - cwnd) / m_c);
+      m_origin = m_wMax;
+    }
+    else {
+      m_k = 0;
+      m_origin = cwnd;
+    }
+  }
+
+  // target window one RTT ahead
+  Time srtt = GetSmoothedRtt();
+  double t = (Simulator::Now() - m_epochStart + srtt).GetSeconds();
+  double target = m_origin + m_c * (t - m_k) * (t - m_k) * (t - m_k);
+
+  if (m_tcpFriendly && !srtt.IsZero()) {
+    double elapsed = (Simulator::Now() - m_epochStart).GetSeconds();
+    double aimd =
+      m_wMax * m_beta + 3.0 * (1.0 - m_beta) / (1.0 + m_beta) * elapsed / srtt.GetSeconds();
+    target = std::max(target, aimd);
+  }
+
+  if (target > cwnd)
+    SetWindow(cwnd + (target - cwnd) / cwnd);
+  else
+    SetWindow(cwnd + 0.01 / cwnd); // probe very slowly around Wmax
+}
+
+void
+CongestionControlCubic::DecreaseWindow()
+{
+  double cwnd = m_cwnd;
+  m_isEpochStarted = false;
+
+  if (m_fastConvergence && cwnd < m_wMax)
+    m_wMax = cwnd * (1.0 + m_beta) / 2.0;
+  else
+    m_wMax = cwnd;
+
+  m_ssthresh = std::max(cwnd * m_beta, m_minWindow);
+  SetWindow(m_ssthresh);
+}
+
+} // namespace ndn
+} // namespace ns3
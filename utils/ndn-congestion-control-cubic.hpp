@@ -0,0 +1,74 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef NDN_CONGESTION_CONTROL_CUBIC_H
+#define NDN_CONGESTION_CONTROL_CUBIC_H
+
+#include "ndn-congestion-control.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \ingroup ndn-apps
+ *
+ * \brief CUBIC-style congestion control (RFC 8312)
+ *
+ * After a congestion event, the window follows W(t) = C * (t - K)^3 + Wmax, where Wmax is the
+ * window before the event and K the time it takes to get back to Wmax.  The growth therefore
+ * does not depend on the RTT, which gives flows with different RTTs a fairer share of the
+ * bottleneck.  In the TCP-friendly region (short RTTs), the window grows at least as fast as
+ * with AIMD.
+ */
+class CongestionControlCubic : public CongestionControl {
+public:
+  static TypeId
+  GetTypeId(void);
+
+  CongestionControlCubic();
+
+  virtual void
+  Reset();
+
+protected:
+  virtual void
+  IncreaseWindow(Time rtt);
+
+  virtual void
+  DecreaseWindow();
+
+private:
+  double m_c;             // scaling constant C
+  double m_beta;          // window factor on congestion
+  bool m_fastConvergence; // release bandwidth faster if Wmax is decreasing
+  bool m_tcpFriendly;     // grow at least as fast as AIMD
+
+  double m_wMax;          // window before the last congestion event
+  double m_origin;        // window the cubic function is centered at
+  double m_k;             // time (in seconds) to reach m_origin
+  Time m_epochStart;      // start of the current growth epoch
+  bool m_isEpochStarted;  // whether m_epochStart is valid
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CONGESTION_CONTROL_CUBIC_H
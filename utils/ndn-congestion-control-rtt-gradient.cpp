@@ -0,0 +1,106 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-congestion-control-rtt-gradient.hpp"
+#include "ns3/double.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE("ndn.CongestionControlRttGradient");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(CongestionControlRttGradient);
+
+TypeId
+CongestionControlRttGradient::GetTypeId(void)
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::CongestionControlRttGradient")
+      .SetParent<CongestionControl>()
+      .AddConstructor<CongestionControlRttGradient>()
+      .AddAttribute("AdditiveIncrease", "Window increase per RTT while the RTT is not increasing",
+                    DoubleValue(1.0),
+                    MakeDoubleAccessor(&CongestionControlRttGradient::m_additiveIncrease),
+                    MakeDoubleChecker<double>(0))
+      .AddAttribute("Beta", "Window reduction per unit of normalized RTT gradient, 0 < Beta < 1",
+                    DoubleValue(0.8), MakeDoubleAccessor(&CongestionControlRttGradient::m_beta),
+                    MakeDoubleChecker<double>(0, 1))
+      .AddAttribute("Gain", "Gain of the smoothed RTT gradient, must be 0 < Gain < 1",
+                    DoubleValue(0.125), MakeDoubleAccessor(&CongestionControlRttGradient::m_gain),
+                    MakeDoubleChecker<double>(0, 1));
+  return tid;
+}
+
+CongestionControlRttGradient::CongestionControlRttGradient()
+  : m_additiveIncrease(1.0)
+  , m_beta(0.8)
+  , m_gain(0.125)
+  , m_gradient(0)
+{
+  NS_LOG_FUNCTION(this);
+}
+
+void
+CongestionControlRttGradient::Reset()
+{
+  m_lastRtt = Seconds(0);
+  m_gradient = 0;
+  CongestionControl::Reset();
+}
+
+void
+CongestionControlRttGradient::IncreaseWindow(Time rtt)
+{
+  double cwnd = m_cwnd;
+
+  if (!rtt.IsZero()) {
+    if (!m_lastRtt.IsZero())
+      m_gradient += m_gain * ((rtt - m_lastRtt).GetSeconds() - m_gradient);
+    m_lastRtt = rtt;
+  }
+
+  double normalized = m_gradient / std::max(GetMinRtt().GetSeconds(), 1e-6);
+  if (normalized <= 0) {
+    if (cwnd < m_ssthresh)
+      SetWindow(cwnd + 1.0); // slow start
+    else
+      SetWindow(cwnd + m_additiveIncrease / cwnd);
+  }
+  else if (!IsInRecovery()) {
+    // queues are building up
+    EnterRecovery();
+    m_ssthresh = std::max(cwnd * (1.0 - m_beta * std::min(normalized, 1.0)), m_minWindow);
+    SetWindow(m_ssthresh);
+    NS_LOG_DEBUG("RTT gradient " << normalized << ", window decreased to " << m_cwnd.Get());
+  }
+}
+
+void
+CongestionControlRttGradient::DecreaseWindow()
+{
+  m_ssthresh = std::max(m_cwnd.Get() / 2.0, m_minWindow);
+  SetWindow(m_ssthresh);
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,69 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef NDN_CONGESTION_CONTROL_RTT_GRADIENT_H
+#define NDN_CONGESTION_CONTROL_RTT_GRADIENT_H
+
+#include "ndn-congestion-control.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \ingroup ndn-apps
+ *
+ * \brief Delay-based congestion control following the RTT gradient (TIMELY-style)
+ *
+ * Growing queues show up as increasing RTTs before any Interest times out.  The controller
+ * keeps a smoothed difference of consecutive RTT samples, normalized by the minimum RTT; while
+ * it is not positive, the window grows like AIMD, otherwise it is reduced by
+ * Beta * gradient (at most once per RTT).  Timeouts halve the window.
+ */
+class CongestionControlRttGradient : public CongestionControl {
+public:
+  static TypeId
+  GetTypeId(void);
+
+  CongestionControlRttGradient();
+
+  virtual void
+  Reset();
+
+protected:
+  virtual void
+  IncreaseWindow(Time rtt);
+
+  virtual void
+  DecreaseWindow();
+
+private:
+  double m_additiveIncrease; // window increase per RTT
+  double m_beta;             // window reduction per unit of normalized gradient
+  double m_gain;             // gain of the smoothed gradient
+
+  Time m_lastRtt;   // previous RTT sample
+  double m_gradient; // smoothed RTT difference (in seconds)
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CONGESTION_CONTROL_RTT_GRADIENT_H
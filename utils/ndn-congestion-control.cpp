@@ -0,0 +1,154 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-congestion-control.hpp"
+#include "ns3/simulator.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <limits>
+
+NS_LOG_COMPONENT_DEFINE("ndn.CongestionControl");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(CongestionControl);
+
+TypeId
+CongestionControl::GetTypeId(void)
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::CongestionControl")
+      .SetParent<Object>()
+      .AddAttribute("InitialWindow", "Congestion window after reset (in Interests)",
+                    DoubleValue(1.0), MakeDoubleAccessor(&CongestionControl::m_initialWindow),
+                    MakeDoubleChecker<double>(0))
+      .AddAttribute("MinWindow", "Lower bound of the congestion window (in Interests)",
+                    DoubleValue(1.0), MakeDoubleAccessor(&CongestionControl::m_minWindow),
+                    MakeDoubleChecker<double>(0))
+      .AddAttribute("MaxWindow", "Upper bound of the congestion window (in Interests)",
+                    DoubleValue(std::numeric_limits<double>::max()),
+                    MakeDoubleAccessor(&CongestionControl::m_maxWindow),
+                    MakeDoubleChecker<double>(0))
+      .AddAttribute("RttGain", "Gain of the smoothed RTT, must be 0 < RttGain < 1",
+                    DoubleValue(0.125), MakeDoubleAccessor(&CongestionControl::m_rttGain),
+                    MakeDoubleChecker<double>(0, 1))
+      .AddTraceSource("CongestionWindow", "Current congestion window (in Interests)",
+                      MakeTraceSourceAccessor(&CongestionControl::m_cwnd),
+                      "ns3::TracedValue::DoubleCallback");
+  return tid;
+}
+
+CongestionControl::CongestionControl()
+  : m_initialWindow(1.0)
+  , m_minWindow(1.0)
+  , m_maxWindow(std::numeric_limits<double>::max())
+  , m_ssthresh(std::numeric_limits<double>::max())
+  , m_cwnd(1.0)
+  , m_rttGain(0.125)
+  , m_inRecovery(false)
+{
+  NS_LOG_FUNCTION(this);
+}
+
+void
+CongestionControl::Reset()
+{
+  NS_LOG_FUNCTION(this);
+
+  m_ssthresh = std::numeric_limits<double>::max();
+  m_srtt = Seconds(0);
+  m_minRtt = Seconds(0);
+  m_inRecovery = false;
+  SetWindow(m_initialWindow);
+}
+
+void
+CongestionControl::OnData(Time rtt)
+{
+  NS_LOG_FUNCTION(this << rtt);
+
+  if (!rtt.IsZero()) {
+    if (m_srtt.IsZero())
+      m_srtt = rtt;
+    else
+      m_srtt += Time::FromDouble((rtt - m_srtt).ToDouble(Time::S) * m_rttGain, Time::S);
+
+    if (m_minRtt.IsZero() || rtt < m_minRtt)
+      m_minRtt = rtt;
+  }
+
+  IncreaseWindow(rtt);
+}
+
+void
+CongestionControl::OnTimeout()
+{
+  NS_LOG_FUNCTION(this);
+
+  if (IsInRecovery())
+    return; // already reacted to this congestion event
+
+  EnterRecovery();
+  DecreaseWindow();
+  NS_LOG_DEBUG("Window decreased to " << m_cwnd.Get());
+}
+
+double
+CongestionControl::GetWindow() const
+{
+  return m_cwnd;
+}
+
+Time
+CongestionControl::GetSmoothedRtt() const
+{
+  return m_srtt;
+}
+
+Time
+CongestionControl::GetMinRtt() const
+{
+  return m_minRtt;
+}
+
+void
+CongestionControl::SetWindow(double window)
+{
+  m_cwnd = std::min(std::max(window, m_minWindow), m_maxWindow);
+}
+
+void
+CongestionControl::EnterRecovery()
+{
+  m_inRecovery = true;
+  m_recoveryStart = Simulator::Now();
+}
+
+bool
+CongestionControl::IsInRecovery() const
+{
+  return m_inRecovery && Simulator::Now() - m_recoveryStart < m_srtt;
+}
+
+} // namespace ndn
+} // namespace ns3
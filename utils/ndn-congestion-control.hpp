@@ -0,0 +1,141 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef NDN_CONGESTION_CONTROL_H
+#define NDN_CONGESTION_CONTROL_H
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/traced-value.h"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \ingroup ndn-apps
+ *
+ * \brief Base class for congestion controllers of window-based consumers
+ *
+ * A controller maintains the congestion window (number of Interests that may be outstanding)
+ * of one flow.  Consumers report received Data (with the RTT sample, if any) and Interest
+ * timeouts; window-based consumers use the window directly, rate-based consumers pace
+ * Interests at window / RTT.
+ *
+ * Timeouts reduce the window at most once per smoothed RTT, as a burst of losses usually is
+ * caused by a single congestion event.
+ *
+ * Subclasses implement only the window update (IncreaseWindow and DecreaseWindow).
+ */
+class CongestionControl : public Object {
+public:
+  static TypeId
+  GetTypeId(void);
+
+  CongestionControl();
+
+  /**
+   * \brief Reset the window to InitialWindow and clear RTT state (e.g., for a new download)
+   */
+  virtual void
+  Reset();
+
+  /**
+   * \brief Data received
+   * \param rtt RTT sample of the Data (zero, if no valid sample was taken)
+   */
+  void
+  OnData(Time rtt);
+
+  /**
+   * \brief Interest timed out
+   */
+  void
+  OnTimeout();
+
+  /**
+   * \brief Get the current congestion window (in Interests)
+   */
+  double
+  GetWindow() const;
+
+  /**
+   * \brief Get the smoothed RTT (zero, if no sample has been taken yet)
+   */
+  Time
+  GetSmoothedRtt() const;
+
+  /**
+   * \brief Get the minimum RTT observed since the last reset (zero, if none)
+   */
+  Time
+  GetMinRtt() const;
+
+protected:
+  /**
+   * \brief Update the window after Data has been received
+   */
+  virtual void
+  IncreaseWindow(Time rtt) = 0;
+
+  /**
+   * \brief Update the window after a congestion event (at most once per RTT)
+   */
+  virtual void
+  DecreaseWindow() = 0;
+
+  /**
+   * \brief Set the window (clamped to [MinWindow, MaxWindow])
+   */
+  void
+  SetWindow(double window);
+
+  /**
+   * \brief Mark the start of a congestion event; timeouts within the next RTT are ignored
+   */
+  void
+  EnterRecovery();
+
+  /**
+   * \brief Whether a congestion event has been handled within the last RTT
+   */
+  bool
+  IsInRecovery() const;
+
+protected:
+  double m_initialWindow; ///< @brief window after Reset
+  double m_minWindow;     ///< @brief lower bound of the window
+  double m_maxWindow;     ///< @brief upper bound of the window
+  double m_ssthresh;      ///< @brief slow start threshold
+
+  TracedValue<double> m_cwnd; ///< @brief current congestion window
+
+private:
+  double m_rttGain;     // gain of the smoothed RTT
+  Time m_srtt;          // smoothed RTT
+  Time m_minRtt;        // minimum RTT since last reset
+  Time m_recoveryStart; // time of the last congestion event
+  bool m_inRecovery;    // whether a congestion event has been handled
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CONGESTION_CONTROL_H
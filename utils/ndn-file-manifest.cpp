@@ -0,0 +1,101 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-file-manifest.hpp"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
+#include <ndn-cxx/meta-info.hpp>
+
+#include <math.h>
+
+namespace ns3 {
+namespace ndn {
+
+Block
+FileManifest::Encode(long fileSize, uint32_t maxPayloadSize)
+{
+  return Encode(::ndn::tlv::Content, fileSize, maxPayloadSize);
+}
+
+Block
+FileManifest::Encode(uint32_t type, long fileSize, uint32_t maxPayloadSize)
+{
+  Block manifest(type);
+
+  if (fileSize >= 0)
+    manifest.push_back(::ndn::nonNegativeIntegerBlock(FileSize, fileSize));
+  manifest.push_back(::ndn::nonNegativeIntegerBlock(MaxPayloadSize, maxPayloadSize));
+
+  manifest.encode();
+  return manifest;
+}
+
+bool
+FileManifest::Decode(const Block& block, long& fileSize, uint32_t& maxPayloadSize)
+{
+  try {
+    block.parse();
+
+    Block::element_const_iterator payload = block.find(MaxPayloadSize);
+    if (payload == block.elements_end())
+      return false;
+    maxPayloadSize = ::ndn::readNonNegativeInteger(*payload);
+
+    Block::element_const_iterator size = block.find(FileSize);
+    fileSize = (size == block.elements_end()) ? -1 : ::ndn::readNonNegativeInteger(*size);
+  }
+  catch (const ::ndn::tlv::Error&) {
+    return false;
+  }
+
+  return true;
+}
+
+void
+FileManifest::SetInBand(Data& data, long fileSize, uint32_t maxPayloadSize)
+{
+  data.setFinalBlockId(name::Component::fromSequenceNumber(GetLastSeqNo(fileSize, maxPayloadSize)));
+
+  ::ndn::MetaInfo metaInfo = data.getMetaInfo();
+  metaInfo.addAppMetaInfo(Encode(InBandManifest, fileSize, maxPayloadSize));
+  data.setMetaInfo(metaInfo);
+}
+
+bool
+FileManifest::GetInBand(const Data& data, long& fileSize, uint32_t& maxPayloadSize)
+{
+  const Block* manifest = data.getMetaInfo().findAppMetaInfo(InBandManifest);
+  if (manifest == nullptr)
+    return false;
+
+  return Decode(*manifest, fileSize, maxPayloadSize);
+}
+
+uint64_t
+FileManifest::GetLastSeqNo(long fileSize, uint32_t maxPayloadSize)
+{
+  if (fileSize <= 0 || maxPayloadSize == 0)
+    return 0;
+
+  return ceil((double)fileSize / (double)maxPayloadSize);
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,86 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_FILE_MANIFEST_H
+#define NDN_FILE_MANIFEST_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Encoding of the file manifest (file size and maximum payload per chunk)
+ *
+ * The manifest is encoded as TLV non-negative integers, so it does not depend on the size or
+ * byte order of native integer types. It is either sent as the content of the manifest Data
+ * packet (<file>/manifest), or carried in-band in the MetaInfo of every chunk, together with
+ * the FinalBlockId of the file. A missing FileSize element means that the file does not exist.
+ */
+class FileManifest {
+public:
+  enum {
+    FileSize = 128,
+    MaxPayloadSize = 129,
+    InBandManifest = 130 ///< AppMetaInfo element that wraps the in-band manifest
+  };
+
+  /**
+   * @brief Encode the manifest as Content block (fileSize == -1 means file not found)
+   */
+  static Block
+  Encode(long fileSize, uint32_t maxPayloadSize);
+
+  /**
+   * @brief Decode the manifest from a Content block
+   * @returns false if the block does not contain a manifest
+   */
+  static bool
+  Decode(const Block& block, long& fileSize, uint32_t& maxPayloadSize);
+
+  /**
+   * @brief Add FinalBlockId and the in-band manifest to the MetaInfo of a chunk
+   */
+  static void
+  SetInBand(Data& data, long fileSize, uint32_t maxPayloadSize);
+
+  /**
+   * @brief Extract the in-band manifest from the MetaInfo of a chunk
+   * @returns false if the chunk does not carry one
+   */
+  static bool
+  GetInBand(const Data& data, long& fileSize, uint32_t& maxPayloadSize);
+
+  /**
+   * @brief Sequence number of the last chunk of a file (chunks are numbered starting at 1)
+   */
+  static uint64_t
+  GetLastSeqNo(long fileSize, uint32_t maxPayloadSize);
+
+private:
+  static Block
+  Encode(uint32_t type, long fileSize, uint32_t maxPayloadSize);
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_FILE_MANIFEST_H
@@ -0,0 +1,211 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-file-reassembler.hpp"
+
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+NS_LOG_COMPONENT_DEFINE("ndn.FileReassembler");
+
+namespace ns3 {
+namespace ndn {
+
+FileReassembler::FileReassembler()
+  : m_fd(-1)
+  , m_map(NULL)
+  , m_fileSize(0)
+  , m_chunkSize(0)
+  , m_window(0)
+  , m_nextIndex(0)
+  , m_bufferedBytes(0)
+  , m_peakBufferedBytes(0)
+{
+}
+
+FileReassembler::~FileReassembler()
+{
+  Close();
+}
+
+bool
+FileReassembler::Open(const std::string& path, long fileSize, uint32_t chunkSize,
+                      uint32_t window, bool useMmap)
+{
+  Close();
+
+  m_fd = open(path.c_str(), (useMmap ? O_RDWR : O_WRONLY) | O_CREAT | O_TRUNC, 0644);
+  if (m_fd < 0) {
+    NS_LOG_ERROR("Cannot create " << path << ": " << strerror(errno));
+    return false;
+  }
+
+  m_fileSize = std::max(fileSize, 0L);
+  m_chunkSize = std::max(chunkSize, 1u);
+  m_window = window;
+  m_nextIndex = 0;
+  m_stored.assign((m_fileSize + m_chunkSize - 1) / m_chunkSize, false);
+  m_bufferedBytes = 0;
+  m_peakBufferedBytes = 0;
+
+  if (useMmap && m_fileSize > 0) {
+    // sparse file of the final size, pages are only allocated when chunks are copied in
+    void* map = MAP_FAILED;
+    if (ftruncate(m_fd, m_fileSize) == 0) {
+      map = mmap(NULL, m_fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    }
+
+    if (map == MAP_FAILED) {
+      NS_LOG_WARN("Cannot map " << path << " (" << strerror(errno) << "), writing it instead");
+    }
+    else {
+      m_map = static_cast<uint8_t*>(map);
+    }
+  }
+
+  return true;
+}
+
+void
+FileReassembler::Write(uint32_t index, const uint8_t* data, size_t length)
+{
+  if (!IsOpen() || index >= m_stored.size() || m_stored[index])
+    return;
+
+  m_stored[index] = true;
+  length = std::min<size_t>(length, m_fileSize - static_cast<long>(index) * m_chunkSize);
+
+  if (m_map != NULL) {
+    memcpy(m_map + static_cast<size_t>(index) * m_chunkSize, data, length);
+    return;
+  }
+
+  if (index != m_nextIndex) {
+    if (index - m_nextIndex <= m_window) {
+      m_pending[index].assign(data, data + length);
+      m_bufferedBytes += length;
+      m_peakBufferedBytes = std::max(m_peakBufferedBytes, m_bufferedBytes);
+    }
+    else {
+      // too far ahead for the reorder window
+      std::vector<iovec> buffers{{const_cast<uint8_t*>(data), length}};
+      WriteAt(index, buffers);
+    }
+    return;
+  }
+
+  // write the chunk together with the buffered chunks that now follow it in order; a chunk
+  // that has been written directly ends the run
+  uint32_t runStart = index;
+  std::vector<iovec> run{{const_cast<uint8_t*>(data), length}};
+
+  m_nextIndex++;
+  while (m_nextIndex < m_stored.size() && m_stored[m_nextIndex]) {
+    auto pending = m_pending.find(m_nextIndex);
+    if (pending != m_pending.end()) {
+      run.push_back({pending->second.data(), pending->second.size()});
+      m_bufferedBytes -= pending->second.size();
+    }
+    else {
+      WriteAt(runStart, run);
+      run.clear();
+      runStart = m_nextIndex + 1;
+    }
+    m_nextIndex++;
+  }
+  WriteAt(runStart, run);
+
+  m_pending.erase(m_pending.begin(), m_pending.lower_bound(m_nextIndex));
+}
+
+void
+FileReassembler::Close()
+{
+  if (!IsOpen())
+    return;
+
+  // buffered chunks are behind a hole, write them out in contiguous runs
+  uint32_t runStart = 0;
+  std::vector<iovec> run;
+  for (auto& pending : m_pending) {
+    if (!run.empty() && pending.first != runStart + run.size()) {
+      WriteAt(runStart, run);
+      run.clear();
+    }
+    if (run.empty())
+      runStart = pending.first;
+    run.push_back({pending.second.data(), pending.second.size()});
+  }
+  WriteAt(runStart, run);
+  m_pending.clear();
+  m_bufferedBytes = 0;
+
+  if (m_map != NULL) {
+    munmap(m_map, m_fileSize);
+    m_map = NULL;
+  }
+
+  close(m_fd);
+  m_fd = -1;
+}
+
+void
+FileReassembler::WriteAt(uint32_t index, std::vector<iovec>& buffers)
+{
+  off_t offset = static_cast<off_t>(index) * m_chunkSize;
+  size_t first = 0;
+  while (first < buffers.size()) {
+#ifdef HAVE_PWRITEV
+    int count = static_cast<int>(std::min<size_t>(buffers.size() - first, IOV_MAX));
+    ssize_t written = pwritev(m_fd, &buffers[first], count, offset);
+#else
+    ssize_t written = pwrite(m_fd, buffers[first].iov_base, buffers[first].iov_len, offset);
+#endif // HAVE_PWRITEV
+    if (written < 0) {
+      if (errno == EINTR)
+        continue;
+      NS_LOG_ERROR("Cannot write chunks " << index << ".." << index + buffers.size() - 1
+                   << ": " << strerror(errno));
+      return;
+    }
+    offset += written;
+
+    // skip buffers that have been written completely, continue within a partial one
+    while (first < buffers.size() && static_cast<size_t>(written) >= buffers[first].iov_len) {
+      written -= buffers[first].iov_len;
+      first++;
+    }
+    if (written > 0) {
+      buffers[first].iov_base = static_cast<uint8_t*>(buffers[first].iov_base) + written;
+      buffers[first].iov_len -= written;
+    }
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
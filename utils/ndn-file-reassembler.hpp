@@ -0,0 +1,121 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_FILE_REASSEMBLER_H
+#define NDN_FILE_REASSEMBLER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <map>
+#include <vector>
+
+#include <sys/uio.h>
+
+#include <boost/noncopyable.hpp>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Streaming reassembly of a downloaded file from its chunks
+ *
+ * Chunks that arrive in order are written to the output file right away, together with the
+ * buffered chunks that directly follow them, in a single vectored write per contiguous run.
+ * Chunks that arrive out of order are held in memory if they are at most `window` chunks ahead
+ * of the next expected one, and are written directly at their offset otherwise, so memory held
+ * per download is bounded by the window size (plus one bit per chunk to skip duplicates) rather
+ * than by the file size.
+ *
+ * Alternatively, the output file can be sized up front and mapped into memory, in which case
+ * every chunk is copied to its place in the (sparse) file and the kernel writes it back.
+ */
+class FileReassembler : boost::noncopyable {
+public:
+  FileReassembler();
+
+  ~FileReassembler();
+
+  /**
+   * @brief Create (or truncate) @p path for a file of @p fileSize bytes
+   * @param chunkSize size of every chunk except possibly the last one
+   * @param window maximum number of out-of-order chunks held in memory
+   * @param useMmap map the output file into memory instead of writing chunks to it
+   * @returns false if the output file cannot be created
+   */
+  bool
+  Open(const std::string& path, long fileSize, uint32_t chunkSize, uint32_t window,
+       bool useMmap);
+
+  /**
+   * @brief Store chunk @p index (chunks are numbered starting at 0), duplicates are ignored
+   */
+  void
+  Write(uint32_t index, const uint8_t* data, size_t length);
+
+  /**
+   * @brief Write out buffered chunks and close the output file
+   */
+  void
+  Close();
+
+  bool
+  IsOpen() const
+  {
+    return m_fd >= 0;
+  }
+
+  /**
+   * @brief Largest number of bytes held in the reorder window so far
+   */
+  size_t
+  GetPeakBufferedBytes() const
+  {
+    return m_peakBufferedBytes;
+  }
+
+private:
+  /**
+   * @brief Write @p buffers back to back, starting at the offset of chunk @p index
+   *
+   * Uses a single pwritev per IOV_MAX buffers if configure found it, one pwrite per buffer
+   * otherwise.
+   */
+  void
+  WriteAt(uint32_t index, std::vector<iovec>& buffers);
+
+private:
+  int m_fd;
+  uint8_t* m_map;
+  long m_fileSize;
+  uint32_t m_chunkSize;
+  uint32_t m_window;
+
+  uint32_t m_nextIndex;       ///< @brief lowest chunk index not yet written
+  std::vector<bool> m_stored; ///< @brief chunks written or buffered
+  std::map<uint32_t, std::vector<uint8_t>> m_pending;
+  size_t m_bufferedBytes;
+  size_t m_peakBufferedBytes;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_FILE_REASSEMBLER_H
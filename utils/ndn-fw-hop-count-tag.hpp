@@ -40,6 +40,14 @@ public:
   FwHopCountTag()
     : m_hopCount(0){};
 
+  /**
+   * @brief Create tag with the specified hop count
+   */
+  explicit FwHopCountTag(uint32_t hopCount)
+    : m_hopCount(hopCount)
+  {
+  }
+
   /**
    * @brief Destructor
    */
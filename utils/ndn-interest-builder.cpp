@@ -0,0 +1,127 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-interest-builder.hpp"
+
+#include "ns3/random-variable-stream.h"
+
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
+#include <ndn-cxx/encoding/block-helpers.hpp>
+
+#include <algorithm>
+#include <limits>
+
+namespace ns3 {
+namespace ndn {
+
+// first byte of the sequence number component, as produced by Name::appendSequenceNumber
+static uint8_t
+GetSequenceNumberMarker()
+{
+  static const uint8_t marker = Name().appendSequenceNumber(0).at(0).value()[0];
+  return marker;
+}
+
+InterestBuilder::InterestBuilder()
+  : m_hasPrefix(false)
+  , m_state(0)
+{
+}
+
+shared_ptr<Interest>
+InterestBuilder::Build(const Name& prefix, uint64_t seq, const Time& lifetime)
+{
+  if (!m_hasPrefix || prefix != m_prefix) {
+    const Block& wire = prefix.wireEncode();
+    m_prefix = prefix;
+    m_prefixComponents.assign(wire.value_begin(), wire.value_end());
+    m_hasPrefix = true;
+  }
+
+  return Build(m_prefixComponents.data(), m_prefixComponents.size(), &seq, lifetime);
+}
+
+shared_ptr<Interest>
+InterestBuilder::Build(const Name& name, const Time& lifetime)
+{
+  const Block& wire = name.wireEncode();
+  return Build(wire.value(), wire.value_size(), nullptr, lifetime);
+}
+
+shared_ptr<Interest>
+InterestBuilder::Build(const uint8_t* components, size_t componentsSize, const uint64_t* seq,
+                       const Time& lifetime)
+{
+  ::ndn::EncodingBuffer encoder(componentsSize + 64, 0);
+
+  // elements are prepended, i.e., in reverse order: InterestLifetime, Nonce, Name
+  // (like Interest::wireEncode, the default lifetime is not encoded)
+  size_t length = 0;
+  uint64_t lifetimeMs = std::max<int64_t>(lifetime.GetMilliSeconds(), 0);
+  if (lifetimeMs != static_cast<uint64_t>(::ndn::DEFAULT_INTEREST_LIFETIME.count())) {
+    length += ::ndn::prependNonNegativeIntegerBlock(encoder, ::ndn::tlv::InterestLifetime,
+                                                    lifetimeMs);
+  }
+
+  uint32_t nonce = NextNonce();
+  length += ::ndn::prependByteArrayBlock(encoder, ::ndn::tlv::Nonce,
+                                         reinterpret_cast<const uint8_t*>(&nonce), sizeof(nonce));
+
+  size_t nameLength = 0;
+  if (seq != nullptr) {
+    size_t componentLength = encoder.prependNonNegativeInteger(*seq);
+    componentLength += encoder.prependByte(GetSequenceNumberMarker());
+
+    nameLength += componentLength;
+    nameLength += encoder.prependVarNumber(componentLength);
+    nameLength += encoder.prependVarNumber(::ndn::tlv::NameComponent);
+  }
+  nameLength += encoder.prependByteArray(components, componentsSize);
+
+  length += nameLength;
+  length += encoder.prependVarNumber(nameLength);
+  length += encoder.prependVarNumber(::ndn::tlv::Name);
+
+  encoder.prependVarNumber(length);
+  encoder.prependVarNumber(::ndn::tlv::Interest);
+
+  return make_shared<Interest>(encoder.block());
+}
+
+uint32_t
+InterestBuilder::NextNonce()
+{
+  if (m_state == 0) {
+    Ptr<UniformRandomVariable> rand = CreateObject<UniformRandomVariable>();
+    while (m_state == 0) {
+      m_state = (static_cast<uint64_t>(rand->GetInteger(0, std::numeric_limits<uint32_t>::max()))
+                 << 32) | rand->GetInteger(0, std::numeric_limits<uint32_t>::max());
+    }
+  }
+
+  // xorshift64*
+  m_state ^= m_state >> 12;
+  m_state ^= m_state << 25;
+  m_state ^= m_state >> 27;
+  return static_cast<uint32_t>((m_state * 2685821657736338717ULL) >> 32);
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,83 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_INTEREST_BUILDER_H
+#define NDN_INTEREST_BUILDER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Builds the Interests of consumer applications directly in wire format
+ *
+ * The name prefix of the application is encoded once and reused for every Interest, so that
+ * per Interest only the sequence number component, nonce and lifetime are encoded.  The
+ * resulting Interests carry their wire encoding, which is then reused when the Interest is
+ * sent out to the network.
+ *
+ * Nonces are drawn from a small per-builder xorshift generator, seeded from an ns-3 random
+ * stream on first use (so simulation runs stay reproducible).
+ */
+class InterestBuilder {
+public:
+  InterestBuilder();
+
+  /**
+   * @brief Build Interest for @p prefix followed by sequence number @p seq
+   *
+   * Encoding of @p prefix is cached until a different prefix is passed
+   */
+  shared_ptr<Interest>
+  Build(const Name& prefix, uint64_t seq, const Time& lifetime);
+
+  /**
+   * @brief Build Interest for @p name (no prefix caching, e.g., for manifests)
+   */
+  shared_ptr<Interest>
+  Build(const Name& name, const Time& lifetime);
+
+  /**
+   * @brief Get next nonce (uniformly distributed over the full 32-bit range)
+   */
+  uint32_t
+  NextNonce();
+
+private:
+  shared_ptr<Interest>
+  Build(const uint8_t* components, size_t componentsSize, const uint64_t* seq,
+        const Time& lifetime);
+
+private:
+  Name m_prefix;
+  std::vector<uint8_t> m_prefixComponents; ///< @brief encoded components of m_prefix
+  bool m_hasPrefix;
+
+  uint64_t m_state; ///< @brief xorshift64* state, 0 until seeded
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_INTEREST_BUILDER_H
@@ -27,6 +27,13 @@
 namespace ns3 {
 namespace ndn {
 
+/**
+ * @brief ndn-cxx tag that links an Interest or Data to the ns-3 packet it was received in
+ *
+ * The tag also holds a fixed-slot metadata area for ndnSIM per-packet information (e.g., hop
+ * count).  Slots are filled once, when the packet is received from a NetDeviceFace, and then
+ * read in place, without lookups in the ns-3 packet tag list.
+ */
 class Ns3PacketTag : public ::ndn::Tag {
 public:
   static size_t
@@ -35,19 +42,67 @@ public:
     return 0xaee87802; // md5("Ns3PacketTag")[0:8]
   }
 
+  /**
+   * @brief Fixed-slot metadata carried along with NDN packets
+   */
+  struct Metadata {
+    Metadata()
+      : hopCount(-1)
+    {
+    }
+
+    int32_t hopCount; ///< @brief Number of links the packet traversed, -1 if unknown
+  };
+
   Ns3PacketTag(Ptr<const Packet> packet)
     : m_packet(packet)
   {
   }
 
+  Ns3PacketTag(Ptr<const Packet> packet, const Metadata& metadata)
+    : m_packet(packet)
+    , m_metadata(metadata)
+  {
+  }
+
   Ptr<const Packet>
   getPacket() const
   {
     return m_packet;
   }
 
+  const Metadata&
+  getMetadata() const
+  {
+    return m_metadata;
+  }
+
+  /**
+   * @brief Get hop count of the packet, or -1 if unknown
+   */
+  int32_t
+  getHopCount() const
+  {
+    return m_metadata.hopCount;
+  }
+
+  /**
+   * @brief Get hop count of Interest or Data @p pkt
+   *
+   * @returns -1 if the packet has not been received from a network (e.g., it was created by
+   *          a local application or content store)
+   */
+  template<class Pkt>
+  static int32_t
+  hopCountOf(const Pkt& pkt)
+  {
+    auto tag = pkt.template getTag<Ns3PacketTag>();
+    return tag != nullptr ? tag->getHopCount() : -1;
+  }
+
 private:
   Ptr<const Packet> m_packet;
+  Metadata m_metadata;
 };
 
 } // namespace ndn
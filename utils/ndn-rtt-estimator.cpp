@@ -41,6 +41,9 @@ namespace ns3 {
 
 namespace ndn {
 
+// initial number of slots of the history ring (power of two)
+static const size_t INITIAL_HISTORY_SIZE = 64;
+
 NS_OBJECT_ENSURE_REGISTERED(RttEstimator);
 
 TypeId
@@ -102,12 +105,26 @@ RttEstimator::GetCurrentEstimate(void) const
   return m_currentEstimatedRtt;
 }
 
+Time
+RttEstimator::GetVariation(void) const
+{
+  return Seconds(0);
+}
+
 // RttHistory methods
+RttHistory::RttHistory()
+  : count(0)
+  , retx(false)
+  , outstanding(false)
+{
+}
+
 RttHistory::RttHistory(SequenceNumber32 s, uint32_t c, Time t)
   : seq(s)
   , count(c)
   , time(t)
   , retx(false)
+  , outstanding(true)
 {
   NS_LOG_FUNCTION(this);
 }
@@ -117,6 +134,7 @@ RttHistory::RttHistory(const RttHistory& h)
   , count(h.count)
   , time(h.time)
   , retx(h.retx)
+  , outstanding(h.outstanding)
 {
   NS_LOG_FUNCTION(this);
 }
@@ -124,13 +142,11 @@ RttHistory::RttHistory(const RttHistory& h)
 // Base class methods
 
 RttEstimator::RttEstimator()
-  : m_next(1)
-  , m_nSamples(0)
+  : m_nSamples(0)
   , m_multiplier(1)
   , m_history()
 {
   NS_LOG_FUNCTION(this);
-  // note next=1 everywhere since first segment will have sequence 1
 
   // We need attributes initialized here, not later, so use the
   // ConstructSelf() technique documented in the manual
@@ -142,7 +158,6 @@ RttEstimator::RttEstimator()
 
 RttEstimator::RttEstimator(const RttEstimator& c)
   : Object(c)
-  , m_next(c.m_next)
   , m_maxMultiplier(c.m_maxMultiplier)
   , m_initialEstimatedRtt(c.m_initialEstimatedRtt)
   , m_currentEstimatedRtt(c.m_currentEstimatedRtt)
@@ -170,49 +185,57 @@ void
 RttEstimator::SentSeq(SequenceNumber32 seq, uint32_t size)
 {
   NS_LOG_FUNCTION(this << seq << size);
-  // Note that a particular sequence has been sent
-  if (seq == m_next) { // This is the next expected one, just log at end
-    m_history.push_back(RttHistory(seq, size, Simulator::Now()));
-    m_next = seq + SequenceNumber32(size); // Update next expected
-  }
-  else { // This is a retransmit, find in list and mark as re-tx
-    for (RttHistory_t::iterator i = m_history.begin(); i != m_history.end(); ++i) {
-      if ((seq >= i->seq) && (seq < (i->seq + SequenceNumber32(i->count)))) { // Found it
-        i->retx = true;
-        // One final test..be sure this re-tx does not extend "next"
-        if ((seq + SequenceNumber32(size)) > m_next) {
-          m_next = seq + SequenceNumber32(size);
-          i->count = ((seq + SequenceNumber32(size)) - i->seq); // And update count in hist
-        }
-        break;
-      }
+
+  if (m_history.empty())
+    m_history.resize(INITIAL_HISTORY_SIZE);
+
+  for (;;) {
+    RttHistory& slot = m_history[seq.GetValue() & (m_history.size() - 1)];
+    if (!slot.outstanding || Simulator::Now() - slot.time > m_maxRto) {
+      slot = RttHistory(seq, size, Simulator::Now());
+      return;
     }
+    if (slot.seq == seq) {
+      slot.retx = true; // retransmission, don't take sample for this sequence
+      return;
+    }
+    GrowHistory();
+  }
+}
+
+void
+RttEstimator::GrowHistory()
+{
+  RttHistory_t history(m_history.size() * 2);
+  for (const auto& entry : m_history) {
+    if (entry.outstanding)
+      history[entry.seq.GetValue() & (history.size() - 1)] = entry;
   }
+  m_history.swap(history);
+  NS_LOG_DEBUG("History ring grown to " << m_history.size() << " slots");
 }
 
 Time
 RttEstimator::AckSeq(SequenceNumber32 ackSeq)
 {
   NS_LOG_FUNCTION(this << ackSeq);
-  // An ack has been received, calculate rtt and log this measurement
-  // Note we use a linear search (O(n)) for this since for the common
-  // case the ack'ed packet will be at the head of the list
+
   Time m = Seconds(0.0);
-  if (m_history.size() == 0)
-    return (m); // No pending history, just exit
-  RttHistory& h = m_history.front();
-  if (!h.retx && ackSeq >= (h.seq + SequenceNumber32(h.count))) { // Ok to use this sample
-    m = Simulator::Now() - h.time;                                // Elapsed time
-    Measurement(m);                                               // Log the measurement
-    ResetMultiplier(); // Reset multiplier on valid measurement
-  }
-  // Now delete all ack history with seq <= ack
-  while (m_history.size() > 0) {
-    RttHistory& h = m_history.front();
-    if ((h.seq + SequenceNumber32(h.count)) > ackSeq)
-      break;               // Done removing
-    m_history.pop_front(); // Remove
+
+  if (m_history.empty())
+    return m;
+
+  RttHistory& slot = m_history[ackSeq.GetValue() & (m_history.size() - 1)];
+  if (!slot.outstanding || slot.seq != ackSeq)
+    return m; // unsolicited or duplicate
+
+  if (!slot.retx) {
+    m = Simulator::Now() - slot.time; // Elapsed time
+    Measurement(m);                   // Log the measurement
+    ResetMultiplier();                // Reset multiplier on valid measurement
   }
+  slot.outstanding = false;
+
   return m;
 }
 
@@ -221,7 +244,6 @@ RttEstimator::ClearSent()
 {
   NS_LOG_FUNCTION(this);
   // Clear all history entries
-  m_next = 1;
   m_history.clear();
 }
 
@@ -245,7 +267,6 @@ RttEstimator::Reset()
 {
   NS_LOG_FUNCTION(this);
   // Reset to initial state
-  m_next = 1;
   m_currentEstimatedRtt = m_initialEstimatedRtt;
   m_history.clear(); // Remove all info from the history
   m_nSamples = 0;
@@ -26,7 +26,7 @@
 #ifndef NDN_RTT_ESTIMATOR_H
 #define NDN_RTT_ESTIMATOR_H
 
-#include <deque>
+#include <vector>
 #include "ns3/sequence-number.h"
 #include "ns3/nstime.h"
 #include "ns3/object.h"
@@ -42,6 +42,7 @@ namespace ndn {
  */
 class RttHistory {
 public:
+  RttHistory();
   RttHistory(SequenceNumber32 s, uint32_t c, Time t);
   RttHistory(const RttHistory& h); // Copy constructor
 public:
@@ -49,14 +50,29 @@ public:
   uint32_t count;       // Number of bytes sent
   Time time;            // Time this one was sent
   bool retx;            // True if this has been retransmitted
+  bool outstanding;     // True if the slot holds a sequence that has not been acknowledged
 };
 
-typedef std::deque<RttHistory> RttHistory_t;
+/**
+ * \brief Outstanding samples, in a ring indexed by sequence number modulo its (power of two)
+ *        size (one NDN Interest per sequence number)
+ */
+typedef std::vector<RttHistory> RttHistory_t;
 
 /**
- * \ingroup tcp
+ * \ingroup ndn-apps
  *
  * \brief Base class for all RTT Estimators
+ *
+ * Unlike the TCP version, the sampler does not assume cumulative acknowledgements: every
+ * sequence number is tracked and acknowledged individually, and Karn's rule is applied per
+ * sequence number (samples for retransmitted Interests are ignored).  Outstanding sequences are
+ * kept in a flat ring indexed by sequence number modulo the ring size, so both SentSeq and
+ * AckSeq cost O(1) and out-of-order Data does not discard history of other outstanding
+ * Interests.  The ring doubles when a sequence maps to a slot that is still in use; an
+ * occupant that has been outstanding for more than MaxRTO is considered abandoned and replaced.
+ *
+ * Subclasses implement only the estimation part (Measurement and RetransmitTimeout).
  */
 class RttEstimator : public Object {
 public:
@@ -73,6 +89,10 @@ public:
 
   /**
    * \brief Note that a particular sequence has been sent
+   *
+   * If the sequence is already outstanding, it is marked as retransmitted and will not
+   * produce an RTT sample (Karn's rule)
+   *
    * \param seq the packet sequence number.
    * \param size the packet size.
    */
@@ -80,9 +100,9 @@ public:
   SentSeq(SequenceNumber32 seq, uint32_t size);
 
   /**
-   * \brief Note that a particular ack sequence has been received
-   * \param ackSeq the ack sequence number.
-   * \return The measured RTT for this ack.
+   * \brief Note that a particular sequence has been acknowledged (Data received)
+   * \param ackSeq the acknowledged sequence number.
+   * \return The measured RTT for this ack (zero, if no valid sample has been taken).
    */
   virtual Time
   AckSeq(SequenceNumber32 ackSeq);
@@ -170,8 +190,21 @@ public:
   Time
   GetCurrentEstimate(void) const;
 
+  /**
+   * \brief gets the current RTT variation estimate (zero if the estimator does not track it).
+   * \return The current RTT variation estimate.
+   */
+  virtual Time
+  GetVariation(void) const;
+
+private:
+  /**
+   * \brief Double the size of the history ring, keeping all outstanding sequences
+   */
+  void
+  GrowHistory();
+
 private:
-  SequenceNumber32 m_next; // Next expected sequence to be sent
   uint16_t m_maxMultiplier;
   Time m_initialEstimatedRtt;
 
@@ -142,48 +142,10 @@ RttMeanDeviation::Gain(double g)
   m_gain = g;
 }
 
-void
-RttMeanDeviation::SentSeq(SequenceNumber32 seq, uint32_t size)
-{
-  NS_LOG_FUNCTION(this << seq << size);
-
-  RttHistory_t::iterator i;
-  for (i = m_history.begin(); i != m_history.end(); ++i) {
-    if (seq == i->seq) { // Found it
-      i->retx = true;
-      break;
-    }
-  }
-
-  // Note that a particular sequence has been sent
-  if (i == m_history.end())
-    m_history.push_back(RttHistory(seq, size, Simulator::Now()));
-}
-
 Time
-RttMeanDeviation::AckSeq(SequenceNumber32 ackSeq)
+RttMeanDeviation::GetVariation() const
 {
-  NS_LOG_FUNCTION(this << ackSeq);
-  // An ack has been received, calculate rtt and log this measurement
-  // Note we use a linear search (O(n)) for this since for the common
-  // case the ack'ed packet will be at the head of the list
-  Time m = Seconds(0.0);
-  if (m_history.size() == 0)
-    return (m); // No pending history, just exit
-
-  for (RttHistory_t::iterator i = m_history.begin(); i != m_history.end(); ++i) {
-    if (ackSeq == i->seq) { // Found it
-      if (!i->retx) {
-        m = Simulator::Now() - i->time; // Elapsed time
-        Measurement(m);                 // Log the measurement
-        ResetMultiplier();              // Reset multiplier on valid measurement
-      }
-      m_history.erase(i);
-      break;
-    }
-  }
-
-  return m;
+  return m_variance;
 }
 
 } // namespace ndn
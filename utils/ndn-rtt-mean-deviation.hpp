@@ -55,10 +55,6 @@ public:
   virtual TypeId
   GetInstanceTypeId(void) const;
 
-  void
-  SentSeq(SequenceNumber32 seq, uint32_t size);
-  Time
-  AckSeq(SequenceNumber32 ackSeq);
   void
   Measurement(Time measure);
   Time
@@ -69,6 +65,8 @@ public:
   Reset();
   void
   Gain(double g);
+  Time
+  GetVariation() const;
 
 private:
   double m_gain;   // Filter gain
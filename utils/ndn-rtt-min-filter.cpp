@@ -0,0 +1,141 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-rtt-min-filter.hpp"
+#include "ns3/simulator.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE("ndn.RttMinFilter");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(RttMinFilter);
+
+TypeId
+RttMinFilter::GetTypeId(void)
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::RttMinFilter")
+      .SetParent<RttEstimator>()
+      .AddConstructor<RttMinFilter>()
+      .AddAttribute("WindowSize", "Number of recent samples the minimum is taken over",
+                    UintegerValue(16), MakeUintegerAccessor(&RttMinFilter::m_windowSize),
+                    MakeUintegerChecker<uint32_t>(1))
+      .AddAttribute("Gain", "Gain used in estimating the variation, must be 0 < Gain < 1",
+                    DoubleValue(0.25), MakeDoubleAccessor(&RttMinFilter::m_gain),
+                    MakeDoubleChecker<double>(0, 1));
+  return tid;
+}
+
+RttMinFilter::RttMinFilter()
+  : m_next(0)
+  , m_variance(0)
+{
+  NS_LOG_FUNCTION(this);
+}
+
+RttMinFilter::RttMinFilter(const RttMinFilter& c)
+  : RttEstimator(c)
+  , m_windowSize(c.m_windowSize)
+  , m_gain(c.m_gain)
+  , m_window(c.m_window)
+  , m_next(c.m_next)
+  , m_variance(c.m_variance)
+{
+  NS_LOG_FUNCTION(this);
+}
+
+TypeId
+RttMinFilter::GetInstanceTypeId(void) const
+{
+  return GetTypeId();
+}
+
+void
+RttMinFilter::Measurement(Time m)
+{
+  NS_LOG_FUNCTION(this << m);
+
+  if (m_window.size() < m_windowSize) {
+    m_window.push_back(m);
+  }
+  else {
+    m_window[m_next] = m;
+  }
+  m_next = (m_next + 1) % m_windowSize;
+
+  // window size is a small constant, so the scan does not depend on the number of samples
+  m_currentEstimatedRtt = *std::min_element(m_window.begin(), m_window.end());
+
+  if (m_nSamples) {
+    Time difference = (m - m_currentEstimatedRtt) - m_variance;
+    m_variance += Time::FromDouble(difference.ToDouble(Time::S) * m_gain, Time::S);
+  }
+  else {
+    m_variance = Seconds(m.ToDouble(Time::S) / 2);
+  }
+  m_nSamples++;
+}
+
+Time
+RttMinFilter::RetransmitTimeout()
+{
+  NS_LOG_FUNCTION(this);
+
+  double retval = std::min(m_maxRto.ToDouble(Time::S),
+                           std::max(m_multiplier * m_minRto.ToDouble(Time::S),
+                                    m_multiplier * (m_currentEstimatedRtt.ToDouble(Time::S)
+                                                    + 4 * m_variance.ToDouble(Time::S))));
+
+  NS_LOG_DEBUG("RetransmitTimeout:  return " << retval);
+
+  return Seconds(retval);
+}
+
+Ptr<RttEstimator>
+RttMinFilter::Copy() const
+{
+  NS_LOG_FUNCTION(this);
+  return CopyObject<RttMinFilter>(this);
+}
+
+void
+RttMinFilter::Reset()
+{
+  NS_LOG_FUNCTION(this);
+  m_window.clear();
+  m_next = 0;
+  m_variance = Seconds(0);
+  RttEstimator::Reset();
+}
+
+Time
+RttMinFilter::GetVariation() const
+{
+  return m_variance;
+}
+
+} // namespace ndn
+} // namespace ns3
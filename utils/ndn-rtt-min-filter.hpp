@@ -0,0 +1,72 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_RTT_MIN_FILTER_H
+#define NDN_RTT_MIN_FILTER_H
+
+#include "ndn-rtt-estimator.hpp"
+
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \ingroup ndn-apps
+ *
+ * \brief RTT estimator that follows the minimum RTT observed over the last WindowSize samples
+ *
+ * The minimum filters out queueing delay and in-network caching jitter; the RTO is computed as
+ * min + 4 * variation, where variation is a smoothed mean deviation of samples from the minimum.
+ */
+class RttMinFilter : public RttEstimator {
+public:
+  static TypeId
+  GetTypeId(void);
+
+  RttMinFilter();
+  RttMinFilter(const RttMinFilter&);
+
+  virtual TypeId
+  GetInstanceTypeId(void) const;
+
+  void
+  Measurement(Time measure);
+  Time
+  RetransmitTimeout();
+  Ptr<RttEstimator>
+  Copy() const;
+  void
+  Reset();
+  Time
+  GetVariation() const;
+
+private:
+  uint32_t m_windowSize;      // Number of samples in the min filter
+  double m_gain;              // Filter gain for variation
+  std::vector<Time> m_window; // Ring buffer of the last samples
+  uint32_t m_next;            // Next position in the ring buffer
+  Time m_variance;            // Current variation
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_RTT_MIN_FILTER_H
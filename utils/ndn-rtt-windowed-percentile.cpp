@@ -0,0 +1,149 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-rtt-windowed-percentile.hpp"
+#include "ns3/simulator.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE("ndn.RttWindowedPercentile");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(RttWindowedPercentile);
+
+TypeId
+RttWindowedPercentile::GetTypeId(void)
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::RttWindowedPercentile")
+      .SetParent<RttEstimator>()
+      .AddConstructor<RttWindowedPercentile>()
+      .AddAttribute("WindowSize", "Number of recent samples the percentile is taken over",
+                    UintegerValue(32), MakeUintegerAccessor(&RttWindowedPercentile::m_windowSize),
+                    MakeUintegerChecker<uint32_t>(1))
+      .AddAttribute("Percentile", "Percentile of the window used as a retransmission timeout",
+                    DoubleValue(0.95), MakeDoubleAccessor(&RttWindowedPercentile::m_percentile),
+                    MakeDoubleChecker<double>(0, 1));
+  return tid;
+}
+
+RttWindowedPercentile::RttWindowedPercentile()
+  : m_next(0)
+  , m_percentileRtt(0)
+{
+  NS_LOG_FUNCTION(this);
+}
+
+RttWindowedPercentile::RttWindowedPercentile(const RttWindowedPercentile& c)
+  : RttEstimator(c)
+  , m_windowSize(c.m_windowSize)
+  , m_percentile(c.m_percentile)
+  , m_window(c.m_window)
+  , m_next(c.m_next)
+  , m_sorted(c.m_sorted)
+  , m_percentileRtt(c.m_percentileRtt)
+{
+  NS_LOG_FUNCTION(this);
+}
+
+TypeId
+RttWindowedPercentile::GetInstanceTypeId(void) const
+{
+  return GetTypeId();
+}
+
+void
+RttWindowedPercentile::Measurement(Time m)
+{
+  NS_LOG_FUNCTION(this << m);
+
+  if (m_window.size() < m_windowSize) {
+    m_window.push_back(m);
+  }
+  else {
+    // the oldest sample leaves the window
+    m_sorted.erase(std::lower_bound(m_sorted.begin(), m_sorted.end(), m_window[m_next]));
+    m_window[m_next] = m;
+  }
+  m_next = (m_next + 1) % m_windowSize;
+
+  m_sorted.insert(std::upper_bound(m_sorted.begin(), m_sorted.end(), m), m);
+
+  m_currentEstimatedRtt = m_sorted[m_sorted.size() / 2];
+  m_percentileRtt = m_sorted[std::min<size_t>(m_sorted.size() - 1,
+                                              static_cast<size_t>(m_percentile * m_sorted.size()))];
+  m_nSamples++;
+}
+
+Time
+RttWindowedPercentile::RetransmitTimeout()
+{
+  NS_LOG_FUNCTION(this);
+
+  if (m_window.empty()) {
+    // no samples yet, use the initial estimation
+    return Seconds(std::min(m_maxRto.ToDouble(Time::S),
+                            std::max(m_multiplier * m_minRto.ToDouble(Time::S),
+                                     m_multiplier * m_currentEstimatedRtt.ToDouble(Time::S))));
+  }
+
+  double retval = std::min(m_maxRto.ToDouble(Time::S),
+                           std::max(m_multiplier * m_minRto.ToDouble(Time::S),
+                                    m_multiplier * m_percentileRtt.ToDouble(Time::S)));
+
+  NS_LOG_DEBUG("RetransmitTimeout:  return " << retval);
+
+  return Seconds(retval);
+}
+
+Ptr<RttEstimator>
+RttWindowedPercentile::Copy() const
+{
+  NS_LOG_FUNCTION(this);
+  return CopyObject<RttWindowedPercentile>(this);
+}
+
+void
+RttWindowedPercentile::Reset()
+{
+  NS_LOG_FUNCTION(this);
+  m_window.clear();
+  m_sorted.clear();
+  m_next = 0;
+  m_percentileRtt = Seconds(0);
+  RttEstimator::Reset();
+}
+
+Time
+RttWindowedPercentile::GetVariation() const
+{
+  if (m_window.empty())
+    return Seconds(0);
+
+  return m_percentileRtt - m_currentEstimatedRtt;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,77 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_RTT_WINDOWED_PERCENTILE_H
+#define NDN_RTT_WINDOWED_PERCENTILE_H
+
+#include "ndn-rtt-estimator.hpp"
+
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \ingroup ndn-apps
+ *
+ * \brief RTT estimator based on a percentile of the last WindowSize samples
+ *
+ * The current estimate is the median of the window, and the RTO is the configured percentile
+ * (e.g., 95th) of the window.  This is robust against the heavy-tailed RTT distributions caused
+ * by a mix of cache hits and producer responses.  The samples are kept both in arrival order
+ * (ring buffer) and in a sorted flat array that is updated incrementally: a measurement removes
+ * the evicted sample and inserts the new one (binary search and a short move of at most
+ * WindowSize entries), and the median and the percentile are read by index.
+ */
+class RttWindowedPercentile : public RttEstimator {
+public:
+  static TypeId
+  GetTypeId(void);
+
+  RttWindowedPercentile();
+  RttWindowedPercentile(const RttWindowedPercentile&);
+
+  virtual TypeId
+  GetInstanceTypeId(void) const;
+
+  void
+  Measurement(Time measure);
+  Time
+  RetransmitTimeout();
+  Ptr<RttEstimator>
+  Copy() const;
+  void
+  Reset();
+  Time
+  GetVariation() const;
+
+private:
+  uint32_t m_windowSize;      // Number of samples in the window
+  double m_percentile;        // Percentile used as a timeout
+  std::vector<Time> m_window; // Ring buffer of the last samples
+  uint32_t m_next;            // Next position in the ring buffer
+  std::vector<Time> m_sorted; // Samples of the window in ascending order
+  Time m_percentileRtt;       // Current percentile of the window
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_RTT_WINDOWED_PERCENTILE_H
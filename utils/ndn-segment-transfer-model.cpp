@@ -0,0 +1,549 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-segment-transfer-model.hpp"
+
+#include "model/ndn-l3-protocol.hpp"
+#include "model/ndn-fib-snapshot.hpp"
+#include "model/ndn-app-face.hpp"
+#include "model/ndn-net-device-face.hpp"
+#include "apps/ndn-fake-multimedia-server.hpp"
+
+#include "daemon/table/fib.hpp"
+#include "daemon/fw/forwarder.hpp"
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/abort.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+#include "ns3/node-list.h"
+#include "ns3/data-rate.h"
+#include "ns3/point-to-point-net-device.h"
+#include "ns3/point-to-point-channel.h"
+
+#include <algorithm>
+#include <limits>
+
+NS_LOG_COMPONENT_DEFINE("ndn.SegmentTransferModel");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(SegmentTransferModel);
+
+Ptr<SegmentTransferModel> SegmentTransferModel::s_model;
+
+TypeId
+SegmentTransferModel::GetTypeId(void)
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::SegmentTransferModel")
+      .SetGroupName("Ndn")
+      .SetParent<Object>()
+      .AddConstructor<SegmentTransferModel>()
+
+      .AddAttribute("CacheSize",
+                    "Size of the object cache of each node in bytes "
+                    "(0 = number of Content Store entries times ChunkSize)",
+                    UintegerValue(0), MakeUintegerAccessor(&SegmentTransferModel::m_cacheSize),
+                    MakeUintegerChecker<uint64_t>())
+      .AddAttribute("ChunkSize", "Bytes per Content Store entry, used to derive the cache size",
+                    UintegerValue(1400), MakeUintegerAccessor(&SegmentTransferModel::m_chunkSize),
+                    MakeUintegerChecker<uint32_t>());
+
+  return tid;
+}
+
+Ptr<SegmentTransferModel>
+SegmentTransferModel::Get()
+{
+  if (s_model == 0) {
+    s_model = CreateObject<SegmentTransferModel>();
+    Simulator::ScheduleDestroy(&SegmentTransferModel::destroy);
+  }
+  return s_model;
+}
+
+void
+SegmentTransferModel::destroy()
+{
+  if (s_model != 0) {
+    s_model->Dispose();
+    s_model = 0;
+  }
+}
+
+SegmentTransferModel::SegmentTransferModel()
+  : m_lastHandle(0)
+{
+}
+
+void
+SegmentTransferModel::DoDispose()
+{
+  Simulator::Cancel(m_drainEvent);
+  for (auto& transfer : m_transfers) {
+    Simulator::Cancel(transfer.second.event);
+  }
+
+  m_transfers.clear();
+  m_pit.clear();
+  m_caches.clear();
+  m_flows.clear();
+
+  Object::DoDispose();
+}
+
+uint64_t
+SegmentTransferModel::Request(Ptr<Node> node, const Name& name, uint64_t size,
+                              const TransferCallback& onComplete, const FailureCallback& onFailure)
+{
+  uint64_t handle = ++m_lastHandle;
+
+  Transfer& transfer = m_transfers[handle];
+  transfer.name = name;
+  transfer.size = size;
+  transfer.delay = Seconds(0);
+  transfer.parent = 0;
+  transfer.state = REQUESTING;
+  transfer.rate = 0;
+  transfer.onComplete = onComplete;
+  transfer.onFailure = onFailure;
+
+  // follow the Interest until it is satisfied from a cache, aggregated or reaches the producer
+  std::set<uint32_t> visited;
+  bool isRoutable = true;
+  while (true) {
+    uint32_t nodeId = node->GetId();
+    if (!visited.insert(nodeId).second) {
+      NS_LOG_WARN("Forwarding loop for " << name << " at node " << nodeId);
+      isRoutable = false;
+      break;
+    }
+
+    uint64_t cachedSize = 0;
+    if (lookupCache(nodeId, name, cachedSize)) {
+      NS_LOG_DEBUG(name << " found in the cache of node " << nodeId);
+      transfer.size = cachedSize;
+      break;
+    }
+
+    auto pending = m_pit.find(std::make_pair(nodeId, name));
+    if (pending != m_pit.end()) {
+      NS_LOG_DEBUG(name << " aggregated on node " << nodeId);
+      transfer.parent = pending->second;
+      transfer.size = m_transfers[pending->second].size;
+      break;
+    }
+
+    Ptr<L3Protocol> ndn = node->GetObject<L3Protocol>();
+    NS_ASSERT_MSG(ndn != 0, "Ndn stack should be installed on node " << nodeId);
+
+    // nexthops are ordered by cost
+    shared_ptr<Face> face;
+    shared_ptr<const FibSnapshot> snapshot = ndn->getFibSnapshot();
+    if (snapshot != nullptr) {
+      const FibSnapshot::Entry* entry = snapshot->findLongestPrefixMatch(name);
+      if (entry != nullptr && entry->size() != 0)
+        face = ndn->getFaceById(entry->begin()->faceId);
+    }
+    else {
+      shared_ptr<nfd::fib::Entry> fibEntry =
+        ndn->getForwarder()->getFib().findLongestPrefixMatch(name);
+      if (fibEntry->hasNextHops())
+        face = fibEntry->getNextHops().front().getFace();
+    }
+
+    if (face == nullptr) {
+      NS_LOG_WARN("No route for " << name << " on node " << nodeId);
+      isRoutable = false;
+      break;
+    }
+
+    shared_ptr<AppFace> appFace = std::dynamic_pointer_cast<AppFace>(face);
+    if (appFace != nullptr) {
+      NS_LOG_DEBUG(name << " served by the producer on node " << nodeId);
+      transfer.size = getProducerSize(appFace, name, size);
+      break;
+    }
+
+    Ptr<PointToPointNetDevice> device;
+    shared_ptr<NetDeviceFace> netDeviceFace = std::dynamic_pointer_cast<NetDeviceFace>(face);
+    if (netDeviceFace != nullptr)
+      device = DynamicCast<PointToPointNetDevice>(netDeviceFace->GetNetDevice());
+    NS_ABORT_MSG_IF(device == 0, "Only point-to-point links are supported (node " << nodeId
+                                  << ", face " << face->getId() << ")");
+
+    Ptr<PointToPointChannel> channel = DynamicCast<PointToPointChannel>(device->GetChannel());
+    Ptr<NetDevice> upstream = channel->GetDevice(channel->GetDevice(0) == device ? 1 : 0);
+
+    TimeValue delay;
+    channel->GetAttribute("Delay", delay);
+
+    transfer.pitNodes.push_back(nodeId);
+    transfer.links.push_back(upstream);
+    transfer.delay += delay.Get();
+
+    node = upstream->GetNode();
+  }
+
+  if (!isRoutable) {
+    // the request holds no PIT entries, the failure is reported once the caller has the handle
+    transfer.pitNodes.clear();
+    transfer.links.clear();
+    transfer.event = Simulator::ScheduleNow(&SegmentTransferModel::fail, this, handle);
+    return handle;
+  }
+
+  transfer.servingNode = node->GetId();
+  transfer.remaining = 8.0 * transfer.size;
+
+  for (uint32_t pitNode : transfer.pitNodes) {
+    m_pit[std::make_pair(pitNode, name)] = handle;
+  }
+
+  // the object starts flowing once the Interest reached the serving node
+  transfer.event = Simulator::Schedule(transfer.delay, &SegmentTransferModel::activate, this, handle);
+  return handle;
+}
+
+void
+SegmentTransferModel::Cancel(uint64_t handle)
+{
+  auto transfer = m_transfers.find(handle);
+  if (transfer == m_transfers.end())
+    return;
+
+  for (const auto& other : m_transfers) {
+    if (other.second.parent == handle) {
+      // Data keeps flowing for the aggregated requests
+      transfer->second.onComplete = TransferCallback();
+      transfer->second.onFailure = FailureCallback();
+      return;
+    }
+  }
+
+  NS_LOG_DEBUG("Cancel transfer of " << transfer->second.name);
+
+  Simulator::Cancel(transfer->second.event);
+  if (m_flows.find(handle) != m_flows.end()) {
+    advanceFlows();
+    m_flows.erase(handle);
+    updateRates();
+  }
+
+  for (uint32_t pitNode : transfer->second.pitNodes) {
+    auto entry = m_pit.find(std::make_pair(pitNode, transfer->second.name));
+    if (entry != m_pit.end() && entry->second == handle)
+      m_pit.erase(entry);
+  }
+
+  m_transfers.erase(transfer);
+}
+
+size_t
+SegmentTransferModel::GetNTransfers() const
+{
+  return m_transfers.size();
+}
+
+void
+SegmentTransferModel::activate(uint64_t handle)
+{
+  Transfer& transfer = m_transfers[handle];
+  transfer.state = TRANSFERRING;
+
+  if (transfer.links.empty() || transfer.remaining <= 0) {
+    drained(handle);
+    return;
+  }
+
+  advanceFlows();
+  m_flows.insert(handle);
+  updateRates();
+}
+
+void
+SegmentTransferModel::drained(uint64_t handle)
+{
+  Transfer& transfer = m_transfers[handle];
+  transfer.state = DRAINED;
+  transfer.rate = 0;
+
+  if (transfer.parent != 0)
+    return; // waiting for the transfer this request has been aggregated with
+
+  transfer.event = Simulator::Schedule(transfer.delay, &SegmentTransferModel::complete, this, handle);
+}
+
+void
+SegmentTransferModel::complete(uint64_t handle)
+{
+  auto entry = m_transfers.find(handle);
+  NS_ASSERT(entry != m_transfers.end());
+
+  Transfer transfer = entry->second;
+  m_transfers.erase(entry);
+
+  NS_LOG_DEBUG("Completed transfer of " << transfer.name << " (" << transfer.size << " bytes)");
+
+  for (uint32_t pitNode : transfer.pitNodes) {
+    insertCache(pitNode, transfer.name, transfer.size);
+
+    auto pending = m_pit.find(std::make_pair(pitNode, transfer.name));
+    if (pending != m_pit.end() && pending->second == handle)
+      m_pit.erase(pending);
+  }
+
+  // release the requests aggregated with this transfer
+  for (auto& other : m_transfers) {
+    if (other.second.parent != handle)
+      continue;
+
+    other.second.parent = 0;
+    if (other.second.state == DRAINED) {
+      other.second.event = Simulator::Schedule(other.second.delay, &SegmentTransferModel::complete,
+                                                this, other.first);
+    }
+  }
+
+  if (!transfer.onComplete.IsNull())
+    transfer.onComplete(transfer.size);
+}
+
+void
+SegmentTransferModel::fail(uint64_t handle)
+{
+  auto entry = m_transfers.find(handle);
+  NS_ASSERT(entry != m_transfers.end());
+
+  Transfer transfer = entry->second;
+  m_transfers.erase(entry);
+  m_flows.erase(handle);
+  Simulator::Cancel(transfer.event);
+
+  NS_LOG_DEBUG("Failed transfer of " << transfer.name);
+
+  for (uint32_t pitNode : transfer.pitNodes) {
+    auto pending = m_pit.find(std::make_pair(pitNode, transfer.name));
+    if (pending != m_pit.end() && pending->second == handle)
+      m_pit.erase(pending);
+  }
+
+  // the requests aggregated with this transfer do not get the object either
+  std::vector<uint64_t> aggregated;
+  for (const auto& other : m_transfers) {
+    if (other.second.parent == handle)
+      aggregated.push_back(other.first);
+  }
+  for (uint64_t other : aggregated) {
+    if (m_transfers.find(other) != m_transfers.end())
+      fail(other);
+  }
+
+  if (!transfer.onFailure.IsNull())
+    transfer.onFailure();
+}
+
+void
+SegmentTransferModel::advanceFlows()
+{
+  double elapsed = (Simulator::Now() - m_lastUpdate).GetSeconds();
+  m_lastUpdate = Simulator::Now();
+
+  for (uint64_t handle : m_flows) {
+    Transfer& transfer = m_transfers[handle];
+    transfer.remaining = std::max(0.0, transfer.remaining - transfer.rate * elapsed);
+  }
+}
+
+void
+SegmentTransferModel::updateRates()
+{
+  // max-min fair shares by progressive filling: repeatedly fix the rate of all flows crossing
+  // the link with the smallest fair share.  The DataRate is read on every update, so that
+  // changes made during the simulation apply from the next flow start or end on
+  std::map<Ptr<NetDevice>, double> residual;
+  std::vector<uint64_t> stalled;
+  for (uint64_t handle : m_flows) {
+    for (const auto& link : m_transfers[handle].links) {
+      if (residual.find(link) == residual.end()) {
+        DataRateValue rate;
+        link->GetAttribute("DataRate", rate);
+        residual[link] = rate.Get().GetBitRate();
+      }
+      if (residual[link] == 0) {
+        stalled.push_back(handle);
+        break;
+      }
+    }
+  }
+
+  // a link without capacity would never drain the flows crossing it
+  for (uint64_t handle : stalled) {
+    if (m_transfers.find(handle) != m_transfers.end()) {
+      NS_LOG_WARN("DataRate 0 on the path of " << m_transfers[handle].name);
+      fail(handle);
+    }
+  }
+
+  std::map<Ptr<NetDevice>, uint32_t> nFlows;
+  for (uint64_t handle : m_flows) {
+    for (const auto& link : m_transfers[handle].links) {
+      nFlows[link]++;
+    }
+  }
+
+  std::set<uint64_t> unfixed(m_flows);
+  while (!unfixed.empty()) {
+    Ptr<NetDevice> bottleneck;
+    double share = std::numeric_limits<double>::infinity();
+    for (const auto& link : nFlows) {
+      if (link.second > 0 && residual[link.first] / link.second < share) {
+        bottleneck = link.first;
+        share = residual[link.first] / link.second;
+      }
+    }
+
+    for (auto handle = unfixed.begin(); handle != unfixed.end();) {
+      Transfer& transfer = m_transfers[*handle];
+      if (std::find(transfer.links.begin(), transfer.links.end(), bottleneck) == transfer.links.end()) {
+        ++handle;
+        continue;
+      }
+
+      transfer.rate = share;
+      for (const auto& link : transfer.links) {
+        residual[link] = std::max(0.0, residual[link] - share);
+        nFlows[link]--;
+      }
+      handle = unfixed.erase(handle);
+    }
+  }
+
+  // one event for the flow that drains first
+  Simulator::Cancel(m_drainEvent);
+
+  double next = std::numeric_limits<double>::infinity();
+  for (uint64_t handle : m_flows) {
+    const Transfer& transfer = m_transfers[handle];
+    if (transfer.rate > 0)
+      next = std::min(next, transfer.remaining / transfer.rate);
+  }
+
+  if (next != std::numeric_limits<double>::infinity())
+    m_drainEvent = Simulator::Schedule(Seconds(next), &SegmentTransferModel::onDrainEvent, this);
+}
+
+void
+SegmentTransferModel::onDrainEvent()
+{
+  advanceFlows();
+
+  std::vector<uint64_t> finished;
+  for (uint64_t handle : m_flows) {
+    const Transfer& transfer = m_transfers[handle];
+    // allow for the rounding of the event time to nanoseconds
+    if (transfer.remaining <= transfer.rate * 1e-9 + 1.0)
+      finished.push_back(handle);
+  }
+
+  for (uint64_t handle : finished) {
+    m_flows.erase(handle);
+  }
+  updateRates();
+
+  for (uint64_t handle : finished) {
+    // might have failed together with the transfer it was aggregated with
+    if (m_transfers.find(handle) != m_transfers.end())
+      drained(handle);
+  }
+}
+
+SegmentTransferModel::ObjectCache&
+SegmentTransferModel::getCache(uint32_t nodeId)
+{
+  auto cache = m_caches.find(nodeId);
+  if (cache != m_caches.end())
+    return cache->second;
+
+  ObjectCache& newCache = m_caches[nodeId];
+  newCache.used = 0;
+  newCache.capacity = m_cacheSize;
+  if (newCache.capacity == 0) {
+    Ptr<L3Protocol> ndn = NodeList::GetNode(nodeId)->GetObject<L3Protocol>();
+    newCache.capacity = ndn->getConfig().get<uint64_t>("tables.cs_max_packets", 0) * m_chunkSize;
+  }
+  return newCache;
+}
+
+bool
+SegmentTransferModel::lookupCache(uint32_t nodeId, const Name& name, uint64_t& size)
+{
+  ObjectCache& cache = getCache(nodeId);
+  auto entry = cache.index.find(name);
+  if (entry == cache.index.end())
+    return false;
+
+  cache.lru.splice(cache.lru.begin(), cache.lru, entry->second);
+  size = entry->second->second;
+  return true;
+}
+
+void
+SegmentTransferModel::insertCache(uint32_t nodeId, const Name& name, uint64_t size)
+{
+  ObjectCache& cache = getCache(nodeId);
+  auto entry = cache.index.find(name);
+  if (entry != cache.index.end()) {
+    cache.lru.splice(cache.lru.begin(), cache.lru, entry->second);
+    return;
+  }
+
+  if (size > cache.capacity)
+    return;
+
+  cache.lru.push_front(std::make_pair(name, size));
+  cache.index[name] = cache.lru.begin();
+  cache.used += size;
+
+  while (cache.used > cache.capacity) {
+    cache.used -= cache.lru.back().second;
+    cache.index.erase(cache.lru.back().first);
+    cache.lru.pop_back();
+  }
+}
+
+uint64_t
+SegmentTransferModel::getProducerSize(const shared_ptr<AppFace>& face, const Name& name,
+                                      uint64_t size)
+{
+  Ptr<FakeMultimediaServer> server = DynamicCast<FakeMultimediaServer>(face->GetApp());
+  if (server != 0) {
+    long producerSize = server->GetObjectSize(name);
+    if (producerSize >= 0)
+      return producerSize;
+  }
+  return size;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,217 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_SEGMENT_TRANSFER_MODEL_H
+#define NDN_SEGMENT_TRANSFER_MODEL_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+#include "ns3/callback.h"
+#include "ns3/node.h"
+#include "ns3/net-device.h"
+
+#include <list>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+class AppFace;
+
+/**
+ * \ingroup ndn-apps
+ *
+ * \brief Fluid model of whole-object transfers (segment-granularity fast mode)
+ *
+ * Instead of exchanging one Interest/Data pair per chunk, a request for an object (e.g., a
+ * DASH segment) is modeled as a single flow along the path that the Interests would take:
+ * starting at the requesting node, the lowest-cost FIB nexthop is followed over
+ * point-to-point links until the object is found in a node's cache or an application face
+ * (the producer) is reached.  Nodes with a frozen FIB are looked up in their FibSnapshot.
+ *
+ * - Bandwidth is shared max-min fairly among all flows crossing a link, using the DataRate of
+ *   the sending PointToPointNetDevice.  Rates are only recomputed when a flow starts or ends;
+ *   the DataRate is read at that time, so changes to it apply from the next start or end on.
+ * - A transfer completes one path delay (Interest) plus the time needed to drain the object at
+ *   its fair share plus one path delay (last Data) after the request.
+ * - Requests for an object that is in flight through a node are aggregated there (PIT):
+ *   they complete no earlier than the pending transfer.
+ * - Every node on the path caches completed objects in an object-level LRU cache.
+ * - A request fails if the path has a forwarding loop or ends at a node without route, and a
+ *   flow fails if a link on its path has a DataRate of 0.  Requests aggregated with a failed
+ *   transfer fail as well.
+ *
+ * Chunk-level effects (congestion control, slow start, queueing, losses) are not modeled.
+ * Flows do not share capacity with packet-level traffic: packet-level traffic is not affected
+ * by the model and vice versa.
+ */
+class SegmentTransferModel : public Object {
+public:
+  static TypeId
+  GetTypeId(void);
+
+  /**
+   * \brief Get the model of the current simulation (created on first use)
+   */
+  static Ptr<SegmentTransferModel>
+  Get();
+
+  SegmentTransferModel();
+
+  /**
+   * \brief Callback invoked when the whole object has been received (parameter: size in bytes)
+   */
+  typedef Callback<void, uint64_t> TransferCallback;
+
+  /**
+   * \brief Callback invoked when the object cannot be received
+   */
+  typedef Callback<void> FailureCallback;
+
+  /**
+   * \brief Request object \p name from \p node
+   * \param size size of the object in bytes, used if the producer cannot tell the size
+   * \return handle of the transfer (never 0)
+   *
+   * Exactly one of the callbacks is invoked, never from within this call.
+   */
+  uint64_t
+  Request(Ptr<Node> node, const Name& name, uint64_t size, const TransferCallback& onComplete,
+          const FailureCallback& onFailure);
+
+  /**
+   * \brief Abort the transfer (callbacks will not be invoked)
+   *
+   * Transfers that other requests have been aggregated with keep running without callback.
+   */
+  void
+  Cancel(uint64_t handle);
+
+  /**
+   * \brief Get the number of transfers that have not completed yet
+   */
+  size_t
+  GetNTransfers() const;
+
+protected:
+  virtual void
+  DoDispose();
+
+private:
+  enum TransferState { REQUESTING, TRANSFERRING, DRAINED };
+
+  struct Transfer {
+    Name name;
+    uint64_t size;                      ///< @brief object size in bytes
+    std::vector<uint32_t> pitNodes;     ///< @brief nodes that forwarded the request
+    std::vector<Ptr<NetDevice>> links;  ///< @brief devices sending the object towards the requester
+    uint32_t servingNode;               ///< @brief node that returned (or aggregated) the request
+    Time delay;                         ///< @brief one-way delay between serving node and requester
+    uint64_t parent;                    ///< @brief aggregated with this transfer (0 = none)
+    TransferState state;
+    double remaining;                   ///< @brief bits still to be drained
+    double rate;                        ///< @brief current max-min fair share (bits/s)
+    EventId event;
+    TransferCallback onComplete;
+    FailureCallback onFailure;
+  };
+
+  struct ObjectCache {
+    uint64_t capacity;
+    uint64_t used;
+    std::list<std::pair<Name, uint64_t>> lru; ///< @brief most recently used first
+    std::map<Name, std::list<std::pair<Name, uint64_t>>::iterator> index;
+  };
+
+  ObjectCache&
+  getCache(uint32_t nodeId);
+
+  bool
+  lookupCache(uint32_t nodeId, const Name& name, uint64_t& size);
+
+  void
+  insertCache(uint32_t nodeId, const Name& name, uint64_t size);
+
+  /**
+   * \brief Size of \p name as known by the producer (\p size, if the producer cannot tell)
+   */
+  static uint64_t
+  getProducerSize(const shared_ptr<AppFace>& face, const Name& name, uint64_t size);
+
+  void
+  activate(uint64_t handle);
+
+  void
+  drained(uint64_t handle);
+
+  void
+  complete(uint64_t handle);
+
+  /**
+   * \brief Drop the transfer and the requests aggregated with it, invoking their failure callbacks
+   *
+   * The caller has to recompute the rates if the transfer was draining.
+   */
+  void
+  fail(uint64_t handle);
+
+  /**
+   * \brief Drain all flows at their current rates up to now
+   */
+  void
+  advanceFlows();
+
+  /**
+   * \brief Recompute the max-min fair shares and schedule the next drain event
+   */
+  void
+  updateRates();
+
+  void
+  onDrainEvent();
+
+  static void
+  destroy();
+
+private:
+  uint64_t m_cacheSize;  ///< @brief per-node cache size in bytes (0 = derive from CS size)
+  uint32_t m_chunkSize;  ///< @brief bytes per CS entry, used to derive the cache size
+
+  uint64_t m_lastHandle;
+  std::map<uint64_t, Transfer> m_transfers;
+  std::map<std::pair<uint32_t, Name>, uint64_t> m_pit;
+  std::map<uint32_t, ObjectCache> m_caches;
+
+  std::set<uint64_t> m_flows; ///< @brief transfers currently draining
+  Time m_lastUpdate;
+  EventId m_drainEvent;
+
+  static Ptr<SegmentTransferModel> s_model;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_SEGMENT_TRANSFER_MODEL_H
@@ -0,0 +1,308 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "l2-queue-tracer.hpp"
+#include "ndn-distributed-trace-sink.hpp"
+#include "ndn-sampling-clock.hpp"
+
+#include "ns3/node.h"
+#include "ns3/names.h"
+#include "ns3/callback.h"
+#include "ns3/simulator.h"
+#include "ns3/node-list.h"
+#include "ns3/data-rate.h"
+#include "ns3/point-to-point-net-device.h"
+#include "ns3/queue.h"
+#include "ns3/log.h"
+
+#include <boost/lexical_cast.hpp>
+#include <fstream>
+
+NS_LOG_COMPONENT_DEFINE("L2QueueTracer");
+
+namespace ns3 {
+
+static std::list<std::tuple<std::shared_ptr<std::ostream>, std::list<Ptr<L2QueueTracer>>>>
+  g_tracers;
+
+void
+L2QueueTracer::Destroy()
+{
+  g_tracers.clear();
+}
+
+void
+L2QueueTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/)
+{
+  std::list<Ptr<L2QueueTracer>> tracers;
+  std::shared_ptr<std::ostream> outputStream = ndn::DistributedTraceSink::Open(file);
+  if (outputStream == nullptr) {
+    return;
+  }
+
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    if (!ndn::DistributedTraceSink::IsLocal(*node)) {
+      continue;
+    }
+
+    NS_LOG_DEBUG("Node: " << boost::lexical_cast<std::string>((*node)->GetId()));
+
+    Ptr<L2QueueTracer> trace = Create<L2QueueTracer>(outputStream, *node);
+    trace->SetAveragingPeriod(averagingPeriod);
+    tracers.push_back(trace);
+  }
+
+  if (tracers.size() > 0) {
+    tracers.front()->PrintHeader(*outputStream);
+    *outputStream << "\n";
+  }
+
+  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+}
+
+L2QueueTracer::L2QueueTracer(std::shared_ptr<std::ostream> os, Ptr<Node> node)
+  : m_nodePtr(node)
+  , m_os(os)
+  , m_samplingHandle(0)
+{
+  m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
+
+  Connect();
+
+  std::string name = Names::FindName(node);
+  if (!name.empty()) {
+    m_node = name;
+  }
+
+  SetAveragingPeriod(Seconds(1.0));
+}
+
+L2QueueTracer::~L2QueueTracer()
+{
+  ndn::SamplingClock::Unregister(m_samplingHandle);
+
+  for (auto& iface : m_interfaces) {
+    iface->m_queue->TraceDisconnectWithoutContext("Enqueue",
+                                                  MakeCallback(&Interface::Enqueue,
+                                                               PeekPointer(iface)));
+    iface->m_queue->TraceDisconnectWithoutContext("Dequeue",
+                                                  MakeCallback(&Interface::Dequeue,
+                                                               PeekPointer(iface)));
+    iface->m_queue->TraceDisconnectWithoutContext("Drop",
+                                                  MakeCallback(&Interface::Drop,
+                                                               PeekPointer(iface)));
+  }
+}
+
+void
+L2QueueTracer::Connect()
+{
+  for (uint32_t devId = 0; devId < m_nodePtr->GetNDevices(); devId++) {
+    Ptr<PointToPointNetDevice> p2pnd =
+      DynamicCast<PointToPointNetDevice>(m_nodePtr->GetDevice(devId));
+    if (!p2pnd) {
+      continue;
+    }
+
+    Ptr<Interface> iface = Create<Interface>(p2pnd);
+
+    iface->m_queue->TraceConnectWithoutContext("Enqueue",
+                                               MakeCallback(&Interface::Enqueue,
+                                                            PeekPointer(iface)));
+    iface->m_queue->TraceConnectWithoutContext("Dequeue",
+                                               MakeCallback(&Interface::Dequeue,
+                                                            PeekPointer(iface)));
+    iface->m_queue->TraceConnectWithoutContext("Drop",
+                                               MakeCallback(&Interface::Drop, PeekPointer(iface)));
+
+    m_interfaces.push_back(iface);
+  }
+}
+
+void
+L2QueueTracer::SetAveragingPeriod(const Time& period)
+{
+  m_period = period;
+  ndn::SamplingClock::Unregister(m_samplingHandle);
+  m_samplingHandle = ndn::SamplingClock::Register(m_period, m_os,
+                                                  std::bind(&L2QueueTracer::PeriodicPrinter, this,
+                                                            std::placeholders::_1));
+}
+
+void
+L2QueueTracer::PeriodicPrinter(std::ostream& os)
+{
+  Print(os);
+  Reset();
+}
+
+void
+L2QueueTracer::PrintHeader(std::ostream& os) const
+{
+  os << "Time"
+     << "\t"
+
+     << "Node"
+     << "\t"
+     << "Interface"
+     << "\t"
+
+     << "EnqueuedPackets"
+     << "\t"
+     << "EnqueuedKilobytes"
+     << "\t"
+     << "DequeuedPackets"
+     << "\t"
+     << "DequeuedKilobytes"
+     << "\t"
+     << "DroppedPackets"
+     << "\t"
+     << "DroppedKilobytes"
+     << "\t"
+
+     << "QueueMaxPackets"
+     << "\t"
+     << "QueueMaxKilobytes"
+     << "\t"
+
+     << "SojournAvgMs"
+     << "\t"
+     << "SojournMaxMs"
+     << "\t"
+
+     << "Utilization";
+}
+
+void
+L2QueueTracer::Reset()
+{
+  for (auto& iface : m_interfaces) {
+    iface->Reset();
+  }
+}
+
+void
+L2QueueTracer::Print(std::ostream& os) const
+{
+  Time time = Simulator::Now();
+  double period = m_period.ToDouble(Time::S);
+
+  for (const auto& iface : m_interfaces) {
+    double sojournAvg = 0;
+    if (iface->m_dequeuedPackets > 0) {
+      sojournAvg = iface->m_sojournSum.ToDouble(Time::MS) / iface->m_dequeuedPackets;
+    }
+
+    // the rate may have been changed since the last sample
+    DataRateValue rate;
+    iface->m_device->GetAttribute("DataRate", rate);
+
+    double utilization = 0;
+    if (rate.Get().GetBitRate() > 0 && period > 0) {
+      utilization = iface->m_dequeuedBytes * 8.0 / (rate.Get().GetBitRate() * period);
+    }
+
+    os << time.ToDouble(Time::S) << "\t" << m_node << "\t" << iface->m_device->GetIfIndex() << "\t"
+       << iface->m_enqueuedPackets << "\t" << iface->m_enqueuedBytes / 1024.0 << "\t"
+       << iface->m_dequeuedPackets << "\t" << iface->m_dequeuedBytes / 1024.0 << "\t"
+       << iface->m_droppedPackets << "\t" << iface->m_droppedBytes / 1024.0 << "\t"
+       << iface->m_maxPackets << "\t" << iface->m_maxBytes / 1024.0 << "\t" << sojournAvg << "\t"
+       << iface->m_sojournMax.ToDouble(Time::MS) << "\t" << utilization << "\n";
+  }
+}
+
+L2QueueTracer::Interface::Interface(Ptr<PointToPointNetDevice> device)
+  : m_device(device)
+  , m_queue(device->GetQueue())
+  , m_queuedBytes(0)
+{
+  Reset();
+}
+
+void
+L2QueueTracer::Interface::Reset()
+{
+  m_enqueuedPackets = 0;
+  m_enqueuedBytes = 0;
+  m_dequeuedPackets = 0;
+  m_dequeuedBytes = 0;
+  m_droppedPackets = 0;
+  m_droppedBytes = 0;
+
+  // high-water mark of the next period starts from the current occupancy
+  m_maxPackets = m_enqueueTimes.size();
+  m_maxBytes = m_queuedBytes;
+
+  m_sojournSum = Seconds(0);
+  m_sojournMax = Seconds(0);
+}
+
+void
+L2QueueTracer::Interface::Enqueue(Ptr<const Packet> packet)
+{
+  m_enqueuedPackets++;
+  m_enqueuedBytes += packet->GetSize();
+
+  m_enqueueTimes.push_back(Simulator::Now());
+  m_queuedBytes += packet->GetSize();
+
+  m_maxPackets = std::max<uint32_t>(m_maxPackets, m_enqueueTimes.size());
+  m_maxBytes = std::max<uint32_t>(m_maxBytes, m_queuedBytes);
+}
+
+void
+L2QueueTracer::Interface::Dequeue(Ptr<const Packet> packet)
+{
+  m_dequeuedPackets++;
+  m_dequeuedBytes += packet->GetSize();
+
+  if (m_enqueueTimes.empty()) {
+    // packet was enqueued before the tracer has been connected
+    return;
+  }
+
+  // device queues are FIFO, so the oldest enqueue time belongs to this packet
+  Time sojourn = Simulator::Now() - m_enqueueTimes.front();
+  m_enqueueTimes.pop_front();
+  m_queuedBytes -= std::min<uint64_t>(m_queuedBytes, packet->GetSize());
+
+  m_sojournSum += sojourn;
+  m_sojournMax = std::max(m_sojournMax, sojourn);
+}
+
+void
+L2QueueTracer::Interface::Drop(Ptr<const Packet> packet)
+{
+  m_droppedPackets++;
+  m_droppedBytes += packet->GetSize();
+
+  // Queue::Enqueue fires the Enqueue trace before the queue decides to drop the packet, in
+  // which case the queue itself does not account for it
+  if (m_enqueueTimes.size() > m_queue->GetNPackets()) {
+    m_enqueueTimes.pop_back();
+    m_queuedBytes -= std::min<uint64_t>(m_queuedBytes, packet->GetSize());
+
+    m_enqueuedPackets -= std::min<uint64_t>(m_enqueuedPackets, 1);
+    m_enqueuedBytes -= std::min<uint64_t>(m_enqueuedBytes, packet->GetSize());
+  }
+}
+
+} // namespace ns3
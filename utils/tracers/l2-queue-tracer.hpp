@@ -0,0 +1,145 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef L2_QUEUE_TRACER_H
+#define L2_QUEUE_TRACER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/packet.h"
+#include "ns3/nstime.h"
+
+#include <deque>
+#include <vector>
+
+namespace ns3 {
+
+class Node;
+class Queue;
+class PointToPointNetDevice;
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Tracer of per-interface queue occupancy and link utilization
+ *
+ * For every PointToPointNetDevice of the node, the tracer accumulates (from Enqueue, Dequeue
+ * and Drop trace sources of the device queue) the number of enqueued, transmitted and dropped
+ * packets and bytes, high-water mark of the queue, sojourn time of packets in the queue
+ * (assuming FIFO order), and utilization of the link.  One row per interface is written every
+ * averaging period.
+ *
+ * Utilization is relative to the DataRate of the device at the time the row is written, so that
+ * rate changes during the simulation (e.g., by BackgroundTrafficHelper) are accounted for.
+ */
+class L2QueueTracer : public SimpleRefCount<L2QueueTracer> {
+public:
+  L2QueueTracer(std::shared_ptr<std::ostream> os, Ptr<Node> node);
+  ~L2QueueTracer();
+
+  /**
+   * @brief Helper method to install tracers on all simulation nodes
+   *
+   * @param file File to which traces will be written
+   * @param averagingPeriod How often data will be written into the trace file (default, every
+   *        half second)
+   */
+  static void
+  InstallAll(const std::string& file, Time averagingPeriod = Seconds(0.5));
+
+  /**
+   * @brief Explicit request to remove all statically created tracers
+   */
+  static void
+  Destroy();
+
+  void
+  SetAveragingPeriod(const Time& period);
+
+  void
+  PrintHeader(std::ostream& os) const;
+
+  void
+  Print(std::ostream& os) const;
+
+private:
+  void
+  Connect();
+
+  void
+  PeriodicPrinter(std::ostream& os);
+
+  void
+  Reset();
+
+private:
+  class Interface : public SimpleRefCount<Interface> {
+  public:
+    Interface(Ptr<PointToPointNetDevice> device);
+
+    void
+    Enqueue(Ptr<const Packet> packet);
+
+    void
+    Dequeue(Ptr<const Packet> packet);
+
+    void
+    Drop(Ptr<const Packet> packet);
+
+    void
+    Reset();
+
+  public:
+    Ptr<PointToPointNetDevice> m_device;
+    Ptr<Queue> m_queue;
+
+    uint64_t m_enqueuedPackets;
+    uint64_t m_enqueuedBytes;
+    uint64_t m_dequeuedPackets;
+    uint64_t m_dequeuedBytes;
+    uint64_t m_droppedPackets;
+    uint64_t m_droppedBytes;
+
+    uint32_t m_maxPackets; ///< @brief high-water mark within the period
+    uint32_t m_maxBytes;
+
+    uint64_t m_queuedBytes; ///< @brief bytes currently in the queue
+
+    Time m_sojournSum;
+    Time m_sojournMax;
+
+    std::deque<Time> m_enqueueTimes; ///< @brief enqueue time of packets currently in the queue
+  };
+
+  std::string m_node;
+  Ptr<Node> m_nodePtr;
+
+  std::shared_ptr<std::ostream> m_os;
+  Time m_period;
+  uint64_t m_samplingHandle;
+
+  std::vector<Ptr<Interface>> m_interfaces;
+};
+
+} // namespace ns3
+
+#endif // L2_QUEUE_TRACER_H
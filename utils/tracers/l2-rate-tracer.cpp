@@ -18,6 +18,8 @@
  **/
 
 #include "l2-rate-tracer.hpp"
+#include "ndn-distributed-trace-sink.hpp"
+#include "ndn-sampling-clock.hpp"
 
 #include "ns3/node.h"
 #include "ns3/packet.h"
@@ -48,23 +50,16 @@ void
 L2RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/)
 {
   std::list<Ptr<L2RateTracer>> tracers;
-  std::shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    std::shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = std::shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  std::shared_ptr<std::ostream> outputStream = ndn::DistributedTraceSink::Open(file);
+  if (outputStream == nullptr) {
+    return;
   }
 
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    if (!ndn::DistributedTraceSink::IsLocal(*node)) {
+      continue;
+    }
+
     NS_LOG_DEBUG("Node: " << boost::lexical_cast<std::string>((*node)->GetId()));
 
     Ptr<L2RateTracer> trace = Create<L2RateTracer>(outputStream, *node);
@@ -84,30 +79,31 @@ L2RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seco
 L2RateTracer::L2RateTracer(std::shared_ptr<std::ostream> os, Ptr<Node> node)
   : L2Tracer(node)
   , m_os(os)
+  , m_samplingHandle(0)
 {
   SetAveragingPeriod(Seconds(1.0));
 }
 
 L2RateTracer::~L2RateTracer()
 {
-  m_printEvent.Cancel();
+  ndn::SamplingClock::Unregister(m_samplingHandle);
 }
 
 void
 L2RateTracer::SetAveragingPeriod(const Time& period)
 {
   m_period = period;
-  m_printEvent.Cancel();
-  m_printEvent = Simulator::Schedule(m_period, &L2RateTracer::PeriodicPrinter, this);
+  ndn::SamplingClock::Unregister(m_samplingHandle);
+  m_samplingHandle = ndn::SamplingClock::Register(m_period, m_os,
+                                                  std::bind(&L2RateTracer::PeriodicPrinter, this,
+                                                            std::placeholders::_1));
 }
 
 void
-L2RateTracer::PeriodicPrinter()
+L2RateTracer::PeriodicPrinter(std::ostream& os)
 {
-  Print(*m_os);
+  Print(os);
   Reset();
-
-  m_printEvent = Simulator::Schedule(m_period, &L2RateTracer::PeriodicPrinter, this);
 }
 
 void
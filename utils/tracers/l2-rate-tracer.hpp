@@ -23,7 +23,6 @@
 #include "l2-tracer.hpp"
 
 #include "ns3/nstime.h"
-#include "ns3/event-id.h"
 
 #include <tuple>
 #include <map>
@@ -83,7 +82,7 @@ public:
 
 private:
   void
-  PeriodicPrinter();
+  PeriodicPrinter(std::ostream& os);
 
   void
   Reset();
@@ -91,7 +90,7 @@ private:
 private:
   std::shared_ptr<std::ostream> m_os;
   Time m_period;
-  EventId m_printEvent;
+  uint64_t m_samplingHandle; ///< @brief registration with SamplingClock
 
   mutable std::tuple<Stats, Stats, Stats, Stats> m_stats;
 };
@@ -18,11 +18,13 @@
  **/
 
 #include "ndn-app-delay-tracer.hpp"
+#include "ndn-distributed-trace-sink.hpp"
+#include "ndn-sampling-clock.hpp"
 #include "ns3/node.h"
 #include "ns3/packet.h"
-#include "ns3/config.h"
 #include "ns3/names.h"
 #include "ns3/callback.h"
+#include "ns3/string.h"
 
 #include "apps/ndn-app.hpp"
 #include "ns3/simulator.h"
@@ -48,6 +50,17 @@ AppDelayTracer::Destroy()
   g_tracers.clear();
 }
 
+void
+AppDelayTracer::WriteAllTotals()
+{
+  for (auto& tracers : g_tracers) {
+    for (auto& tracer : std::get<1>(tracers)) {
+      tracer->WriteTotals();
+    }
+    std::get<0>(tracers)->flush();
+  }
+}
+
 void
 AppDelayTracer::InstallAll(const std::string& file)
 {
@@ -55,29 +68,55 @@ AppDelayTracer::InstallAll(const std::string& file)
   using namespace std;
 
   std::list<Ptr<AppDelayTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+  shared_ptr<std::ostream> outputStream = DistributedTraceSink::Open(file);
+  if (outputStream == nullptr) {
+    return;
+  }
 
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    if (!DistributedTraceSink::IsLocal(*node)) {
+      continue;
     }
 
-    outputStream = os;
+    Ptr<AppDelayTracer> trace = Install(*node, outputStream);
+    tracers.push_back(trace);
   }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+
+  if (tracers.size() > 0) {
+    // *m_l3RateTrace << "# "; // not necessary for R's read.table
+    tracers.front()->PrintHeader(*outputStream);
+    *outputStream << "\n";
+  }
+
+  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+}
+
+void
+AppDelayTracer::InstallAllAggregated(const std::string& file,
+                                     Time averagingPeriod /* = Seconds (1.0)*/,
+                                     bool perPrefix /* = false*/)
+{
+  // summaries for the whole run have to be written before the distributed sink (registered by
+  // Open) gathers the buffers, i.e., before tracers are destroyed
+  Simulator::ScheduleDestroy(&AppDelayTracer::WriteAllTotals);
+
+  std::list<Ptr<AppDelayTracer>> tracers;
+  shared_ptr<std::ostream> outputStream = DistributedTraceSink::Open(file);
+  if (outputStream == nullptr) {
+    return;
   }
 
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    if (!DistributedTraceSink::IsLocal(*node)) {
+      continue;
+    }
+
     Ptr<AppDelayTracer> trace = Install(*node, outputStream);
+    trace->EnableAggregation(averagingPeriod, perPrefix);
     tracers.push_back(trace);
   }
 
   if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
     tracers.front()->PrintHeader(*outputStream);
     *outputStream << "\n";
   }
@@ -174,6 +213,11 @@ AppDelayTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream)
 AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
   : m_nodePtr(node)
   , m_os(os)
+  , m_appHook(0)
+  , m_aggregate(false)
+  , m_perPrefix(false)
+  , m_samplingHandle(0)
+  , m_totalsWritten(false)
 {
   m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
 
@@ -188,27 +232,102 @@ AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
 AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, const std::string& node)
   : m_node(node)
   , m_os(os)
+  , m_appHook(0)
+  , m_aggregate(false)
+  , m_perPrefix(false)
+  , m_samplingHandle(0)
+  , m_totalsWritten(false)
 {
   Connect();
 }
 
-AppDelayTracer::~AppDelayTracer(){};
+AppDelayTracer::~AppDelayTracer()
+{
+  App::RemoveAppHook(m_appHook);
+
+  WriteTotals();
+}
+
+void
+AppDelayTracer::WriteTotals()
+{
+  if (!m_aggregate || m_totalsWritten) {
+    return;
+  }
+
+  SamplingClock::Unregister(m_samplingHandle);
+  m_samplingHandle = 0;
+
+  PrintSummaries(*m_os, true);
+  m_totalsWritten = true;
+}
+
+void
+AppDelayTracer::EnableAggregation(const Time& averagingPeriod, bool perPrefix /* = false*/)
+{
+  m_aggregate = true;
+  m_perPrefix = perPrefix;
+  m_period = averagingPeriod;
+
+  SamplingClock::Unregister(m_samplingHandle);
+  m_samplingHandle = SamplingClock::Register(m_period, m_os,
+                                             std::bind(&AppDelayTracer::PeriodicPrinter, this,
+                                                       std::placeholders::_1));
+}
 
 void
 AppDelayTracer::Connect()
 {
-  Config::ConnectWithoutContext("/NodeList/" + m_node
-                                  + "/ApplicationList/*/LastRetransmittedInterestDataDelay",
-                                MakeCallback(&AppDelayTracer::LastRetransmittedInterestDataDelay,
-                                             this));
+  if (m_nodePtr == 0) {
+    m_nodePtr = Names::Find<Node>(m_node);
+    if (m_nodePtr == 0) {
+      NS_LOG_WARN("Node " << m_node << " not found");
+      return;
+    }
+  }
 
-  Config::ConnectWithoutContext("/NodeList/" + m_node + "/ApplicationList/*/FirstInterestDataDelay",
-                                MakeCallback(&AppDelayTracer::FirstInterestDataDelay, this));
+  // connect directly to the applications of the node (and to those installed later)
+  m_appHook = App::AddAppHook(m_nodePtr, [this](Ptr<App> app) {
+    app->TraceConnectWithoutContext("LastRetransmittedInterestDataDelay",
+                                    MakeCallback(&AppDelayTracer::LastRetransmittedInterestDataDelay,
+                                                 this));
+    app->TraceConnectWithoutContext("FirstInterestDataDelay",
+                                    MakeCallback(&AppDelayTracer::FirstInterestDataDelay, this));
+  });
 }
 
 void
 AppDelayTracer::PrintHeader(std::ostream& os) const
 {
+  if (m_aggregate) {
+    os << "Time"
+       << "\t"
+       << "Node"
+       << "\t"
+       << (m_perPrefix ? "Prefix" : "AppId")
+       << "\t"
+       << "Interval"
+       << "\t"
+
+       << "Metric"
+       << "\t"
+       << "Count"
+       << "\t"
+       << "Min"
+       << "\t"
+       << "Mean"
+       << "\t"
+       << "P50"
+       << "\t"
+       << "P90"
+       << "\t"
+       << "P99"
+       << "\t"
+       << "Max"
+       << "";
+    return;
+  }
+
   os << "Time"
      << "\t"
      << "Node"
@@ -234,6 +353,13 @@ void
 AppDelayTracer::LastRetransmittedInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay,
                                                    int32_t hopCount)
 {
+  if (m_aggregate) {
+    AggregatedEntry& entry = GetEntry(app);
+    entry.m_period.m_lastDelay.Add(delay.GetMicroSeconds());
+    entry.m_total.m_lastDelay.Add(delay.GetMicroSeconds());
+    return;
+  }
+
   *m_os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << app->GetId() << "\t"
         << seqno << "\t"
         << "LastDelay"
@@ -245,6 +371,16 @@ void
 AppDelayTracer::FirstInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay, uint32_t retxCount,
                                        int32_t hopCount)
 {
+  if (m_aggregate) {
+    AggregatedEntry& entry = GetEntry(app);
+    for (Summary* summary : {&entry.m_period, &entry.m_total}) {
+      summary->m_fullDelay.Add(delay.GetMicroSeconds());
+      summary->m_retxCount.Add(retxCount);
+      summary->m_hopCount.Add(std::max<int32_t>(hopCount, 0));
+    }
+    return;
+  }
+
   *m_os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << app->GetId() << "\t"
         << seqno << "\t"
         << "FullDelay"
@@ -252,5 +388,73 @@ AppDelayTracer::FirstInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay,
         << "\t" << hopCount << "\n";
 }
 
+void
+AppDelayTracer::Summary::Reset()
+{
+  m_lastDelay.Reset();
+  m_fullDelay.Reset();
+  m_retxCount.Reset();
+  m_hopCount.Reset();
+}
+
+AppDelayTracer::AggregatedEntry&
+AppDelayTracer::GetEntry(Ptr<App> app)
+{
+  auto cached = m_appEntries.find(app->GetId());
+  if (cached != m_appEntries.end()) {
+    return *cached->second;
+  }
+
+  std::string key = boost::lexical_cast<std::string>(app->GetId());
+  if (m_perPrefix) {
+    StringValue prefix;
+    if (app->GetAttributeFailSafe("Prefix", prefix)
+        || app->GetAttributeFailSafe("FileToRequest", prefix)) {
+      key = prefix.Get();
+    }
+  }
+
+  AggregatedEntry& entry = m_entries[key];
+  m_appEntries[app->GetId()] = &entry;
+  return entry;
+}
+
+void
+AppDelayTracer::PeriodicPrinter(std::ostream& os)
+{
+  PrintSummaries(os, false);
+
+  for (auto& entry : m_entries) {
+    entry.second.m_period.Reset();
+  }
+}
+
+void
+AppDelayTracer::PrintSummaries(std::ostream& os, bool total) const
+{
+  double time = Simulator::Now().ToDouble(Time::S);
+
+  for (const auto& entry : m_entries) {
+    const Summary& summary = total ? entry.second.m_total : entry.second.m_period;
+
+    auto print = [&](const char* metric, const QuantileSketch& sketch) {
+      if (sketch.GetCount() == 0) {
+        return;
+      }
+
+      os << time << "\t" << m_node << "\t" << entry.first << "\t" << (total ? "Total" : "Period")
+         << "\t" << metric << "\t" << sketch.GetCount() << "\t" << sketch.GetMin() << "\t"
+         << sketch.GetMean() << "\t" << sketch.GetQuantile(0.5) << "\t"
+         << sketch.GetQuantile(0.9) << "\t" << sketch.GetQuantile(0.99) << "\t" << sketch.GetMax()
+         << "\n";
+    };
+
+    print("LastDelayUS", summary.m_lastDelay);
+    print("FullDelayUS", summary.m_fullDelay);
+    print("RetxCount", summary.m_retxCount);
+    print("HopCount", summary.m_hopCount);
+  }
+}
+
 } // namespace ndn
 } // namespace ns3
@@ -28,8 +28,11 @@
 #include <ns3/event-id.h>
 #include <ns3/node-container.h>
 
+#include "ndn-quantile-sketch.hpp"
+
 #include <tuple>
 #include <list>
+#include <map>
 
 namespace ns3 {
 
@@ -55,6 +58,24 @@ public:
   static void
   InstallAll(const std::string& file);
 
+  /**
+   * @brief Helper method to install aggregated tracers on all simulation nodes
+   *
+   * Instead of writing a row for every received Data packet, the tracers keep streaming
+   * quantile sketches of delays, retransmission counts, and hop counts per application (or per
+   * requested prefix) and write a compact summary every averaging period, as well as a summary
+   * for the whole run at Simulator::Destroy (or when tracers are destroyed, if that happens
+   * earlier).  Memory usage does not depend on the length of the simulation.
+   *
+   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param averagingPeriod How often summaries will be written into the trace file
+   * @param perPrefix If true, applications requesting the same prefix (value of Prefix or
+   *        FileToRequest attribute) on the node are summarized together
+   */
+  static void
+  InstallAllAggregated(const std::string& file, Time averagingPeriod = Seconds(1.0),
+                       bool perPrefix = false);
+
   /**
    * @brief Helper method to install tracers on the selected simulation nodes
    *
@@ -127,10 +148,55 @@ public:
   void
   PrintHeader(std::ostream& os) const;
 
+  /**
+   * @brief Switch tracer into the aggregated mode (see InstallAllAggregated)
+   *
+   * @param averagingPeriod How often summaries will be written into the trace file
+   * @param perPrefix If true, summarize applications by the requested prefix instead of AppId
+   */
+  void
+  EnableAggregation(const Time& averagingPeriod, bool perPrefix = false);
+
 private:
   void
   Connect();
 
+  struct Summary {
+    void
+    Reset();
+
+    QuantileSketch m_lastDelay; ///< @brief in microseconds
+    QuantileSketch m_fullDelay; ///< @brief in microseconds
+    QuantileSketch m_retxCount;
+    QuantileSketch m_hopCount;
+  };
+
+  struct AggregatedEntry {
+    Summary m_period;
+    Summary m_total;
+  };
+
+  AggregatedEntry&
+  GetEntry(Ptr<App> app);
+
+  void
+  PeriodicPrinter(std::ostream& os);
+
+  void
+  PrintSummaries(std::ostream& os, bool total) const;
+
+  /**
+   * @brief Write summaries for the whole run (once, aggregated mode only)
+   */
+  void
+  WriteTotals();
+
+  /**
+   * @brief Write summaries of all tracers installed by InstallAllAggregated (at Simulator::Destroy)
+   */
+  static void
+  WriteAllTotals();
+
   void
   LastRetransmittedInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay, int32_t hopCount);
 
@@ -143,6 +209,16 @@ private:
   Ptr<Node> m_nodePtr;
 
   shared_ptr<std::ostream> m_os;
+  uint64_t m_appHook; ///< @brief see App::AddAppHook
+
+  bool m_aggregate;
+  bool m_perPrefix;
+  Time m_period;
+  uint64_t m_samplingHandle; ///< @brief registration with SamplingClock (aggregated mode)
+  bool m_totalsWritten;
+
+  std::map<std::string, AggregatedEntry> m_entries;  ///< @brief AppId or prefix -> summaries
+  std::map<uint32_t, AggregatedEntry*> m_appEntries; ///< @brief AppId -> entry in m_entries
 };
 
 } // namespace ndn
@@ -18,6 +18,8 @@
  **/
 
 #include "ndn-cs-tracer.hpp"
+#include "ndn-distributed-trace-sink.hpp"
+#include "ndn-sampling-clock.hpp"
 #include "ns3/node.h"
 #include "ns3/packet.h"
 #include "ns3/config.h"
@@ -33,6 +35,7 @@
 #include <boost/lexical_cast.hpp>
 
 #include <fstream>
+#include <sstream>
 
 NS_LOG_COMPONENT_DEFINE("ndn.CsTracer");
 
@@ -41,6 +44,8 @@ namespace ndn {
 
 static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<CsTracer>>>> g_tracers;
 
+const double cs::AnalyticsStats::AgeBins[] = {0.001, 0.01, 0.1, 1, 10, 100};
+
 void
 CsTracer::Destroy()
 {
@@ -54,29 +59,49 @@ CsTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds
   using namespace std;
 
   std::list<Ptr<CsTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+  shared_ptr<std::ostream> outputStream = DistributedTraceSink::Open(file);
+  if (outputStream == nullptr) {
+    return;
+  }
 
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    if (!DistributedTraceSink::IsLocal(*node)) {
+      continue;
     }
 
-    outputStream = os;
+    Ptr<CsTracer> trace = Install(*node, outputStream, averagingPeriod);
+    tracers.push_back(trace);
   }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+
+  if (tracers.size() > 0) {
+    // *m_l3RateTrace << "# "; // not necessary for R's read.table
+    tracers.front()->PrintHeader(*outputStream);
+    *outputStream << "\n";
+  }
+
+  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+}
+
+void
+CsTracer::InstallAllAnalytics(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/)
+{
+  std::list<Ptr<CsTracer>> tracers;
+  shared_ptr<std::ostream> outputStream = DistributedTraceSink::Open(file);
+  if (outputStream == nullptr) {
+    return;
   }
 
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    if (!DistributedTraceSink::IsLocal(*node)) {
+      continue;
+    }
+
     Ptr<CsTracer> trace = Install(*node, outputStream, averagingPeriod);
+    trace->EnableAnalytics();
     tracers.push_back(trace);
   }
 
   if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
     tracers.front()->PrintHeader(*outputStream);
     *outputStream << "\n";
   }
@@ -177,6 +202,10 @@ CsTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
 CsTracer::CsTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
   : m_nodePtr(node)
   , m_os(os)
+  , m_samplingHandle(0)
+  , m_analytics(false)
+  , m_ageAvailable(false)
+  , m_occupancy(0)
 {
   m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
 
@@ -191,11 +220,18 @@ CsTracer::CsTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
 CsTracer::CsTracer(shared_ptr<std::ostream> os, const std::string& node)
   : m_node(node)
   , m_os(os)
+  , m_samplingHandle(0)
+  , m_analytics(false)
+  , m_ageAvailable(false)
+  , m_occupancy(0)
 {
   Connect();
 }
 
-CsTracer::~CsTracer(){};
+CsTracer::~CsTracer()
+{
+  SamplingClock::Unregister(m_samplingHandle);
+}
 
 void
 CsTracer::Connect()
@@ -207,21 +243,42 @@ CsTracer::Connect()
   Reset();
 }
 
+void
+CsTracer::EnableAnalytics()
+{
+  if (m_analytics) {
+    return;
+  }
+  m_analytics = true;
+
+  Ptr<ContentStore> cs = m_nodePtr->GetObject<ContentStore>();
+  cs->TraceConnectWithoutContext("DidAddEntry", MakeCallback(&CsTracer::DidAddEntry, this));
+  m_ageAvailable = cs->TraceConnectWithoutContext("WillRemoveEntry",
+                                                  MakeCallback(&CsTracer::WillRemoveEntry, this));
+  if (!m_ageAvailable) {
+    NS_LOG_WARN("Content store on node " << m_node << " does not provide WillRemoveEntry, "
+                                         << "evictions will be derived from occupancy");
+  }
+
+  m_occupancy = cs->GetSize();
+  m_analyticsStats.Reset();
+}
+
 void
 CsTracer::SetAveragingPeriod(const Time& period)
 {
   m_period = period;
-  m_printEvent.Cancel();
-  m_printEvent = Simulator::Schedule(m_period, &CsTracer::PeriodicPrinter, this);
+  SamplingClock::Unregister(m_samplingHandle);
+  m_samplingHandle = SamplingClock::Register(m_period, m_os,
+                                             std::bind(&CsTracer::PeriodicPrinter, this,
+                                                       std::placeholders::_1));
 }
 
 void
-CsTracer::PeriodicPrinter()
+CsTracer::PeriodicPrinter(std::ostream& os)
 {
-  Print(*m_os);
+  Print(os);
   Reset();
-
-  m_printEvent = Simulator::Schedule(m_period, &CsTracer::PeriodicPrinter, this);
 }
 
 void
@@ -235,7 +292,7 @@ CsTracer::PrintHeader(std::ostream& os) const
 
      << "Type"
      << "\t"
-     << "Packets"
+     << (m_analytics ? "Value" : "Packets")
      << "\t";
 }
 
@@ -243,6 +300,11 @@ void
 CsTracer::Reset()
 {
   m_stats.Reset();
+
+  if (m_analytics) {
+    m_occupancy = m_nodePtr->GetObject<ContentStore>()->GetSize();
+    m_analyticsStats.Reset();
+  }
 }
 
 #define PRINTER(printName, fieldName)                                                              \
@@ -256,12 +318,62 @@ CsTracer::Print(std::ostream& os) const
 
   PRINTER("CacheHits", m_cacheHits);
   PRINTER("CacheMisses", m_cacheMisses);
+
+  if (!m_analytics) {
+    return;
+  }
+
+  const cs::AnalyticsStats& stats = m_analyticsStats;
+  uint32_t occupancy = m_nodePtr->GetObject<ContentStore>()->GetSize();
+
+  double evictions = stats.m_evictions;
+  if (!m_ageAvailable) {
+    evictions = std::max(0.0, stats.m_inserts + m_occupancy - occupancy);
+  }
+
+  // misses are not sized at lookup, and not every fetched Data is inserted (nor every inserted
+  // one fetched for a miss), so this is not the byte hit ratio
+  double servedBytes = stats.m_hitBytes + stats.m_insertedBytes;
+  double hitByteShare = servedBytes > 0 ? stats.m_hitBytes / servedBytes : 0;
+
+#define ANALYTICS_PRINTER(printName, value)                                                        \
+  os << time.ToDouble(Time::S) << "\t" << m_node << "\t" << printName << "\t" << (value) << "\n";
+
+  ANALYTICS_PRINTER("Occupancy", occupancy);
+  ANALYTICS_PRINTER("Inserts", stats.m_inserts);
+  ANALYTICS_PRINTER("Evictions", evictions);
+  ANALYTICS_PRINTER("HitKilobytes", stats.m_hitBytes / 1024.0);
+  ANALYTICS_PRINTER("InsertedKilobytes", stats.m_insertedBytes / 1024.0);
+  ANALYTICS_PRINTER("HitByteShare", hitByteShare);
+
+  if (m_ageAvailable) {
+    ANALYTICS_PRINTER("EvictedAgeMean",
+                      stats.m_evictions > 0 ? stats.m_evictedAgeSum / stats.m_evictions : 0);
+
+    for (size_t bin = 0; bin < cs::AnalyticsStats::AgeBinCount; bin++) {
+      std::ostringstream name;
+      name << "EvictedAge_";
+      if (bin + 1 < cs::AnalyticsStats::AgeBinCount) {
+        name << cs::AnalyticsStats::AgeBins[bin] << "s";
+      }
+      else {
+        name << "Inf";
+      }
+      ANALYTICS_PRINTER(name.str(), stats.m_evictedAge[bin]);
+    }
+  }
+
+#undef ANALYTICS_PRINTER
 }
 
 void
-CsTracer::CacheHits(shared_ptr<const Interest>, shared_ptr<const Data>)
+CsTracer::CacheHits(shared_ptr<const Interest>, shared_ptr<const Data> data)
 {
   m_stats.m_cacheHits++;
+
+  if (m_analytics) {
+    m_analyticsStats.m_hitBytes += data->wireEncode().size();
+  }
 }
 
 void
@@ -270,5 +382,28 @@ CsTracer::CacheMisses(shared_ptr<const Interest>)
   m_stats.m_cacheMisses++;
 }
 
+void
+CsTracer::DidAddEntry(Ptr<const cs::Entry> entry)
+{
+  m_analyticsStats.m_inserts++;
+
+  m_analyticsStats.m_insertedBytes += entry->GetData()->wireEncode().size();
+}
+
+void
+CsTracer::WillRemoveEntry(Ptr<const cs::Entry>, Time age)
+{
+  double ageS = age.ToDouble(Time::S);
+
+  m_analyticsStats.m_evictions++;
+  m_analyticsStats.m_evictedAgeSum += ageS;
+
+  size_t bin = 0;
+  while (bin + 1 < cs::AnalyticsStats::AgeBinCount && ageS > cs::AnalyticsStats::AgeBins[bin]) {
+    bin++;
+  }
+  m_analyticsStats.m_evictedAge[bin]++;
+}
+
 } // namespace ndn
 } // namespace ns3
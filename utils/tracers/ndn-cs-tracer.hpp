@@ -25,12 +25,12 @@
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
 #include <ns3/nstime.h>
-#include <ns3/event-id.h>
 #include <ns3/node-container.h>
 
 #include <tuple>
 #include <map>
 #include <list>
+#include <algorithm>
 
 namespace ns3 {
 
@@ -41,6 +41,8 @@ namespace ndn {
 
 namespace cs {
 
+class Entry;
+
 /// @cond include_hidden
 struct Stats {
   inline void
@@ -52,6 +54,29 @@ struct Stats {
   double m_cacheHits;
   double m_cacheMisses;
 };
+
+struct AnalyticsStats {
+  /// @brief upper bounds (inclusive) of age-at-eviction histogram bins, the last bin is unbounded
+  static const double AgeBins[];
+  static const size_t AgeBinCount = 7;
+
+  inline void
+  Reset()
+  {
+    m_inserts = 0;
+    m_insertedBytes = 0;
+    m_evictions = 0;
+    m_hitBytes = 0;
+    m_evictedAgeSum = 0;
+    std::fill(m_evictedAge, m_evictedAge + AgeBinCount, 0);
+  }
+  double m_inserts;
+  double m_insertedBytes;
+  double m_evictions;
+  double m_hitBytes;
+  double m_evictedAgeSum; ///< @brief in seconds
+  double m_evictedAge[AgeBinCount];
+};
 /// @endcond
 }
 
@@ -76,6 +101,22 @@ public:
   static void
   InstallAll(const std::string& file, Time averagingPeriod = Seconds(0.5));
 
+  /**
+   * @brief Helper method to install tracers in analytics mode on all simulation nodes
+   *
+   * In addition to cache hits and misses, the tracers report per averaging period the number
+   * of inserted and evicted entries, occupancy of the content store, share of hit bytes, and
+   * histogram of the age of entries at eviction.  Age of evicted entries is available only for
+   * content stores with lifetime stats (ns3::ndn::cs::Stats::*), for other stores evictions
+   * are derived from the change in occupancy.
+   *
+   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param averagingPeriod How often data will be written into the trace file (default, every half
+   *        second)
+   */
+  static void
+  InstallAllAnalytics(const std::string& file, Time averagingPeriod = Seconds(0.5));
+
   /**
    * @brief Helper method to install tracers on the selected simulation nodes
    *
@@ -168,6 +209,12 @@ public:
   void
   Print(std::ostream& os) const;
 
+  /**
+   * @brief Switch tracer into analytics mode (see InstallAllAnalytics)
+   */
+  void
+  EnableAnalytics();
+
 private:
   void
   Connect();
@@ -178,6 +225,12 @@ private:
   void
   CacheMisses(shared_ptr<const Interest>);
 
+  void
+  DidAddEntry(Ptr<const cs::Entry> entry);
+
+  void
+  WillRemoveEntry(Ptr<const cs::Entry> entry, Time age);
+
 private:
   void
   SetAveragingPeriod(const Time& period);
@@ -186,7 +239,7 @@ private:
   Reset();
 
   void
-  PeriodicPrinter();
+  PeriodicPrinter(std::ostream& os);
 
 private:
   std::string m_node;
@@ -195,8 +248,13 @@ private:
   shared_ptr<std::ostream> m_os;
 
   Time m_period;
-  EventId m_printEvent;
+  uint64_t m_samplingHandle; ///< @brief registration with SamplingClock
   cs::Stats m_stats;
+
+  bool m_analytics;
+  bool m_ageAvailable;   ///< @brief content store provides WillRemoveEntry trace source
+  uint32_t m_occupancy;  ///< @brief content store size at the end of the last period
+  cs::AnalyticsStats m_analyticsStats;
 };
 
 /**
@@ -0,0 +1,248 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "ndn-distributed-trace-sink.hpp"
+
+#include "ns3/node.h"
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+
+#ifdef NS3_MPI
+#include "ns3/mpi-interface.h"
+#include <mpi.h>
+#endif
+
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <queue>
+#include <algorithm>
+#include <functional>
+#include <cstdlib>
+#include <limits>
+
+NS_LOG_COMPONENT_DEFINE("ndn.DistributedTraceSink");
+
+namespace ns3 {
+namespace ndn {
+
+#ifdef NS3_MPI
+
+namespace {
+
+struct Row {
+  double time;
+  uint32_t rank;
+  size_t index;
+
+  bool
+  operator>(const Row& other) const
+  {
+    if (time != other.time)
+      return time > other.time;
+    if (rank != other.rank)
+      return rank > other.rank;
+    return index > other.index;
+  }
+};
+
+/**
+ * @brief Extract the value of the first column, returns false for non-numeric (header) rows
+ */
+bool
+ParseTime(const std::string& line, double& time)
+{
+  const char* begin = line.c_str();
+  char* end = nullptr;
+  time = std::strtod(begin, &end);
+  return end != begin && (*end == '\t' || *end == ' ' || *end == '\0');
+}
+
+void
+SplitLines(const char* begin, const char* end, std::vector<std::string>& lines)
+{
+  while (begin < end) {
+    const char* eol = std::find(begin, end, '\n');
+    lines.push_back(std::string(begin, eol));
+    begin = eol + 1;
+  }
+}
+
+void
+WriteMerged(const std::vector<std::vector<std::string>>& ranks, std::ostream& os)
+{
+  std::priority_queue<Row, std::vector<Row>, std::greater<Row>> queue;
+  bool headerWritten = false;
+
+  // header rows are written once, rank-local streams are already time-ordered
+  std::vector<size_t> positions(ranks.size(), 0);
+  for (uint32_t rank = 0; rank < ranks.size(); rank++) {
+    double time;
+    size_t& i = positions[rank];
+    for (; i < ranks[rank].size() && !ParseTime(ranks[rank][i], time); i++) {
+      if (!headerWritten) {
+        os << ranks[rank][i] << "\n";
+      }
+    }
+    headerWritten = headerWritten || i > 0;
+
+    if (i < ranks[rank].size()) {
+      queue.push(Row{time, rank, i});
+    }
+  }
+
+  while (!queue.empty()) {
+    Row row = queue.top();
+    queue.pop();
+
+    const std::vector<std::string>& lines = ranks[row.rank];
+    os << lines[row.index] << "\n";
+
+    double time;
+    for (size_t next = row.index + 1; next < lines.size(); next++) {
+      if (ParseTime(lines[next], time)) {
+        queue.push(Row{time, row.rank, next});
+        break;
+      }
+    }
+  }
+}
+
+void
+GatherAndMerge(shared_ptr<std::stringstream> buffer, const std::string& file)
+{
+  std::string local = buffer->str();
+  uint64_t localSize = local.size();
+
+  uint32_t rank = MpiInterface::GetSystemId();
+  uint32_t size = MpiInterface::GetSize();
+
+  std::vector<uint64_t> sizes(size, 0);
+  MPI_Allgather(&localSize, 1, MPI_UINT64_T, &sizes[0], 1, MPI_UINT64_T, MPI_COMM_WORLD);
+
+  // MPI counts and displacements are int, so buffers larger than 2 GiB (in total) are
+  // gathered in rounds of at most INT_MAX bytes
+  uint64_t chunk = std::numeric_limits<int>::max() / size;
+  uint64_t maxSize = *std::max_element(sizes.begin(), sizes.end());
+
+  std::vector<std::string> buffers(rank == 0 ? size : 0);
+  std::vector<char> all(1);
+  for (uint64_t offset = 0; offset < maxSize; offset += chunk) {
+    std::vector<int> counts(size, 0);
+    std::vector<int> offsets(size, 0);
+    int total = 0;
+    for (uint32_t i = 0; i < size; i++) {
+      counts[i] = sizes[i] > offset ? static_cast<int>(std::min(chunk, sizes[i] - offset)) : 0;
+      offsets[i] = total;
+      total += counts[i];
+    }
+
+    if (rank == 0)
+      all.resize(total + 1);
+
+    const char* localChunk = local.data() + std::min(offset, localSize);
+    MPI_Gatherv(const_cast<char*>(localChunk), counts[rank], MPI_CHAR, &all[0], &counts[0],
+                &offsets[0], MPI_CHAR, 0, MPI_COMM_WORLD);
+
+    if (rank == 0) {
+      for (uint32_t i = 0; i < size; i++) {
+        buffers[i].append(&all[offsets[i]], counts[i]);
+      }
+    }
+  }
+
+  if (rank != 0)
+    return;
+
+  std::vector<std::vector<std::string>> ranks(size);
+  for (uint32_t i = 0; i < size; i++) {
+    SplitLines(buffers[i].data(), buffers[i].data() + buffers[i].size(), ranks[i]);
+  }
+
+  if (file == "-") {
+    WriteMerged(ranks, std::cout);
+    std::cout.flush();
+    return;
+  }
+
+  std::ofstream os(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+  if (!os.is_open()) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Merged trace is lost");
+    return;
+  }
+  WriteMerged(ranks, os);
+}
+
+} // namespace
+
+#endif // NS3_MPI
+
+bool
+DistributedTraceSink::IsDistributed()
+{
+#ifdef NS3_MPI
+  return MpiInterface::IsEnabled() && MpiInterface::GetSize() > 1;
+#else
+  return false;
+#endif
+}
+
+bool
+DistributedTraceSink::IsLocal(Ptr<Node> node)
+{
+#ifdef NS3_MPI
+  if (IsDistributed()) {
+    return node->GetSystemId() == MpiInterface::GetSystemId();
+  }
+#endif
+  return true;
+}
+
+shared_ptr<std::ostream>
+DistributedTraceSink::Open(const std::string& file)
+{
+#ifdef NS3_MPI
+  if (IsDistributed()) {
+    NS_LOG_DEBUG("Rank " << MpiInterface::GetSystemId() << " buffers trace " << file);
+
+    auto buffer = make_shared<std::stringstream>();
+    Simulator::ScheduleDestroy(&GatherAndMerge, buffer, file);
+    return buffer;
+  }
+#endif
+
+  if (file == "-") {
+    return shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  }
+
+  shared_ptr<std::ofstream> os(new std::ofstream());
+  os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+
+  if (!os->is_open()) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+    return nullptr;
+  }
+
+  return os;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,80 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_DISTRIBUTED_TRACE_SINK_H
+#define NDN_DISTRIBUTED_TRACE_SINK_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/ptr.h"
+
+#include <iostream>
+
+namespace ns3 {
+
+class Node;
+
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Output stream factory for tracers that is aware of distributed (MPI) simulations
+ *
+ * In a sequential run, Open() simply returns the requested file (or std::cout for "-").
+ *
+ * In a distributed run (ns-3 built with MPI support and more than one rank), every rank
+ * traces only nodes it owns (see IsLocal()) and writes rows into a rank-local in-memory
+ * buffer.  At Simulator::Destroy, buffers of all ranks are gathered on rank 0 and merged
+ * into a single output ordered by the value of the first (Time) column.  Rows with equal
+ * time keep the rank order, and the header line is written only once.
+ *
+ * Merging is a collective operation: all ranks must call Open() for the same files in the
+ * same order (which is the case when the same InstallAll calls are executed on every rank).
+ */
+class DistributedTraceSink {
+public:
+  /**
+   * @brief Check whether the simulation runs on more than one MPI rank
+   */
+  static bool
+  IsDistributed();
+
+  /**
+   * @brief Check whether the node is simulated by the current rank
+   *
+   * Always true in a sequential run
+   */
+  static bool
+  IsLocal(Ptr<Node> node);
+
+  /**
+   * @brief Open output stream for a tracer
+   *
+   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @returns output stream or nullptr, if the file cannot be opened for writing
+   */
+  static shared_ptr<std::ostream>
+  Open(const std::string& file);
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_DISTRIBUTED_TRACE_SINK_H
@@ -19,9 +19,9 @@
  **/
 
 #include "ndn-fileconsumer-log-tracer.hpp"
+#include "ndn-distributed-trace-sink.hpp"
 #include "ns3/node.h"
 #include "ns3/packet.h"
-#include "ns3/config.h"
 #include "ns3/names.h"
 #include "ns3/callback.h"
 
@@ -56,23 +56,16 @@ FileConsumerLogTracer::InstallAll(const std::string& file)
   using namespace std;
 
   std::list<Ptr<FileConsumerLogTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<std::ostream> outputStream = DistributedTraceSink::Open(file);
+  if (outputStream == nullptr) {
+    return;
   }
 
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    if (!DistributedTraceSink::IsLocal(*node)) {
+      continue;
+    }
+
     Ptr<FileConsumerLogTracer> trace = Install(*node, outputStream);
     tracers.push_back(trace);
   }
@@ -175,6 +168,7 @@ FileConsumerLogTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputSt
 FileConsumerLogTracer::FileConsumerLogTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
   : m_nodePtr(node)
   , m_os(os)
+  , m_appHook(0)
 {
   m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
 
@@ -189,27 +183,39 @@ FileConsumerLogTracer::FileConsumerLogTracer(shared_ptr<std::ostream> os, Ptr<No
 FileConsumerLogTracer::FileConsumerLogTracer(shared_ptr<std::ostream> os, const std::string& node)
   : m_node(node)
   , m_os(os)
+  , m_appHook(0)
 {
   Connect();
 }
 
-FileConsumerLogTracer::~FileConsumerLogTracer(){};
+FileConsumerLogTracer::~FileConsumerLogTracer()
+{
+  App::RemoveAppHook(m_appHook);
+}
 
 void
 FileConsumerLogTracer::Connect()
 {
-  Config::ConnectWithoutContext("/NodeList/" + m_node
-                                  + "/ApplicationList/*/FileDownloadFinished",
-                                MakeCallback(&FileConsumerLogTracer::FileDownloadedTrace,
-                                             this));
-  Config::ConnectWithoutContext("/NodeList/" + m_node
-                                  + "/ApplicationList/*/ManifestReceived",
-                                MakeCallback(&FileConsumerLogTracer::FileDownloadedManifestTrace,
-                                             this));
-  Config::ConnectWithoutContext("/NodeList/" + m_node
-                                  + "/ApplicationList/*/FileDownloadStarted",
-                                MakeCallback(&FileConsumerLogTracer::FileDownloadStartedTrace,
-                                             this));
+  if (m_nodePtr == 0) {
+    m_nodePtr = Names::Find<Node>(m_node);
+    if (m_nodePtr == 0) {
+      NS_LOG_WARN("Node " << m_node << " not found");
+      return;
+    }
+  }
+
+  // connect directly to the applications of the node (and to those installed later)
+  m_appHook = App::AddAppHook(m_nodePtr, [this](Ptr<App> app) {
+    app->TraceConnectWithoutContext("FileDownloadFinished",
+                                    MakeCallback(&FileConsumerLogTracer::FileDownloadedTrace,
+                                                 this));
+    app->TraceConnectWithoutContext("ManifestReceived",
+                                    MakeCallback(&FileConsumerLogTracer::FileDownloadedManifestTrace,
+                                                 this));
+    app->TraceConnectWithoutContext("FileDownloadStarted",
+                                    MakeCallback(&FileConsumerLogTracer::FileDownloadStartedTrace,
+                                                 this));
+  });
 }
 
 void
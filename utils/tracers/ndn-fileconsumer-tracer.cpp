@@ -19,9 +19,9 @@
  **/
 
 #include "ndn-fileconsumer-tracer.hpp"
+#include "ndn-distributed-trace-sink.hpp"
 #include "ns3/node.h"
 #include "ns3/packet.h"
-#include "ns3/config.h"
 #include "ns3/names.h"
 #include "ns3/callback.h"
 
@@ -56,23 +56,16 @@ FileConsumerTracer::InstallAll(const std::string& file)
   using namespace std;
 
   std::list<Ptr<FileConsumerTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<std::ostream> outputStream = DistributedTraceSink::Open(file);
+  if (outputStream == nullptr) {
+    return;
   }
 
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    if (!DistributedTraceSink::IsLocal(*node)) {
+      continue;
+    }
+
     Ptr<FileConsumerTracer> trace = Install(*node, outputStream);
     tracers.push_back(trace);
   }
@@ -175,6 +168,7 @@ FileConsumerTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStrea
 FileConsumerTracer::FileConsumerTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
   : m_nodePtr(node)
   , m_os(os)
+  , m_appHook(0)
 {
   m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
 
@@ -189,19 +183,32 @@ FileConsumerTracer::FileConsumerTracer(shared_ptr<std::ostream> os, Ptr<Node> no
 FileConsumerTracer::FileConsumerTracer(shared_ptr<std::ostream> os, const std::string& node)
   : m_node(node)
   , m_os(os)
+  , m_appHook(0)
 {
   Connect();
 }
 
-FileConsumerTracer::~FileConsumerTracer(){};
+FileConsumerTracer::~FileConsumerTracer()
+{
+  App::RemoveAppHook(m_appHook);
+}
 
 void
 FileConsumerTracer::Connect()
 {
-  Config::ConnectWithoutContext("/NodeList/" + m_node
-                                  + "/ApplicationList/*/CurrentPacketStats",
-                                MakeCallback(&FileConsumerTracer::CurrentPacketStats,
-                                             this));
+  if (m_nodePtr == 0) {
+    m_nodePtr = Names::Find<Node>(m_node);
+    if (m_nodePtr == 0) {
+      NS_LOG_WARN("Node " << m_node << " not found");
+      return;
+    }
+  }
+
+  // connect directly to the applications of the node (and to those installed later)
+  m_appHook = App::AddAppHook(m_nodePtr, [this](Ptr<App> app) {
+    app->TraceConnectWithoutContext("CurrentPacketStats",
+                                    MakeCallback(&FileConsumerTracer::CurrentPacketStats, this));
+  });
 }
 
 void
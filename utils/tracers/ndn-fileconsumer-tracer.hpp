@@ -156,6 +156,7 @@ private:
   Ptr<Node> m_nodePtr;
 
   shared_ptr<std::ostream> m_os;
+  uint64_t m_appHook; ///< @brief see App::AddAppHook
 };
 
 } // namespace ndn
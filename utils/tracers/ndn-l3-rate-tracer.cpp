@@ -18,6 +18,8 @@
  **/
 
 #include "ndn-l3-rate-tracer.hpp"
+#include "ndn-distributed-trace-sink.hpp"
+#include "ndn-sampling-clock.hpp"
 #include "ns3/node.h"
 #include "ns3/packet.h"
 #include "ns3/config.h"
@@ -49,23 +51,16 @@ void
 L3RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/)
 {
   std::list<Ptr<L3RateTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<std::ostream> outputStream = DistributedTraceSink::Open(file);
+  if (outputStream == nullptr) {
+    return;
   }
 
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    if (!DistributedTraceSink::IsLocal(*node)) {
+      continue;
+    }
+
     Ptr<L3RateTracer> trace = Install(*node, outputStream, averagingPeriod);
     tracers.push_back(trace);
   }
@@ -168,37 +163,45 @@ L3RateTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
 L3RateTracer::L3RateTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
   : L3Tracer(node)
   , m_os(os)
+  , m_samplingHandle(0)
+  , m_total()
+  , m_hasTotal(false)
 {
+  EnumerateFaces();
   SetAveragingPeriod(Seconds(1.0));
 }
 
 L3RateTracer::L3RateTracer(shared_ptr<std::ostream> os, const std::string& node)
   : L3Tracer(node)
   , m_os(os)
+  , m_samplingHandle(0)
+  , m_total()
+  , m_hasTotal(false)
 {
+  EnumerateFaces();
   SetAveragingPeriod(Seconds(1.0));
 }
 
 L3RateTracer::~L3RateTracer()
 {
-  m_printEvent.Cancel();
+  SamplingClock::Unregister(m_samplingHandle);
 }
 
 void
 L3RateTracer::SetAveragingPeriod(const Time& period)
 {
   m_period = period;
-  m_printEvent.Cancel();
-  m_printEvent = Simulator::Schedule(m_period, &L3RateTracer::PeriodicPrinter, this);
+  SamplingClock::Unregister(m_samplingHandle);
+  m_samplingHandle = SamplingClock::Register(m_period, m_os,
+                                             std::bind(&L3RateTracer::PeriodicPrinter, this,
+                                                       std::placeholders::_1));
 }
 
 void
-L3RateTracer::PeriodicPrinter()
+L3RateTracer::PeriodicPrinter(std::ostream& os)
 {
-  Print(*m_os);
+  Print(os);
   Reset();
-
-  m_printEvent = Simulator::Schedule(m_period, &L3RateTracer::PeriodicPrinter, this);
 }
 
 void
@@ -228,15 +231,49 @@ L3RateTracer::PrintHeader(std::ostream& os) const
 void
 L3RateTracer::Reset()
 {
-  for (auto& stats : m_stats) {
-    std::get<0>(stats.second).Reset();
-    std::get<1>(stats.second).Reset();
+  for (auto& slot : m_faces) {
+    std::get<0>(slot.m_stats).Reset();
+    std::get<1>(slot.m_stats).Reset();
+  }
+  for (auto& slot : m_reservedFaces) {
+    std::get<0>(slot.second.m_stats).Reset();
+    std::get<1>(slot.second.m_stats).Reset();
+  }
+  std::get<0>(m_total).Reset();
+  std::get<1>(m_total).Reset();
+}
+
+L3RateTracer::FaceSlot&
+L3RateTracer::GetSlot(nfd::FaceId faceId)
+{
+  if (faceId <= nfd::FACEID_RESERVED_MAX) {
+    return m_reservedFaces[faceId];
+  }
+
+  size_t index = faceId - nfd::FACEID_RESERVED_MAX - 1;
+  if (index >= m_faces.size()) {
+    m_faces.resize(index + 1, FaceSlot());
   }
+  return m_faces[index];
+}
+
+L3RateTracer::FaceStats&
+L3RateTracer::GetStats(nfd::FaceId faceId)
+{
+  FaceSlot& slot = GetSlot(faceId);
+  slot.m_active = true;
+  return slot.m_stats;
+}
+
+void
+L3RateTracer::FaceAdded(const Face& face)
+{
+  GetSlot(face.getId()).m_face = face.shared_from_this();
 }
 
 const double alpha = 0.8;
 
-#define STATS(INDEX) std::get<INDEX>(stats.second)
+#define STATS(INDEX) std::get<INDEX>(stats)
 #define RATE(INDEX, fieldName) STATS(INDEX).fieldName / m_period.ToDouble(Time::S)
 
 #define PRINTER(printName, fieldName)                                                              \
@@ -246,8 +283,8 @@ const double alpha = 0.8;
                        + /*old value*/ (1 - alpha) * STATS(3).fieldName;                           \
                                                                                                    \
   os << time.ToDouble(Time::S) << "\t" << m_node << "\t";                                          \
-  if (stats.first != nullptr) {                                                                    \
-    os << stats.first->getId() << "\t" << stats.first->getLocalUri() << "\t";                      \
+  if (face != nullptr) {                                                                           \
+    os << face->getId() << "\t" << face->getLocalUri() << "\t";                                    \
   }                                                                                                \
   else {                                                                                           \
     os << "-1\tall\t";                                                                             \
@@ -260,10 +297,21 @@ L3RateTracer::Print(std::ostream& os) const
 {
   Time time = Simulator::Now();
 
-  for (auto& stats : m_stats) {
-    if (stats.first == nullptr)
+  std::vector<FaceSlot*> slots;
+  for (auto& slot : m_reservedFaces) {
+    slots.push_back(&slot.second);
+  }
+  for (auto& slot : m_faces) {
+    slots.push_back(&slot);
+  }
+
+  for (FaceSlot* slot : slots) {
+    if (slot->m_face == nullptr || !slot->m_active)
       continue;
 
+    const shared_ptr<const Face>& face = slot->m_face;
+    FaceStats& stats = slot->m_stats;
+
     PRINTER("InInterests", m_inInterests);
     PRINTER("OutInterests", m_outInterests);
 
@@ -277,83 +325,76 @@ L3RateTracer::Print(std::ostream& os) const
     PRINTER("OutTimedOutInterests", m_outTimedOutInterests);
   }
 
-  {
-    auto i = m_stats.find(nullptr);
-    if (i != m_stats.end()) {
-      auto& stats = *i;
-      PRINTER("SatisfiedInterests", m_satisfiedInterests);
-      PRINTER("TimedOutInterests", m_timedOutInterests);
-    }
+  if (m_hasTotal) {
+    const shared_ptr<const Face> face;
+    FaceStats& stats = m_total;
+
+    PRINTER("SatisfiedInterests", m_satisfiedInterests);
+    PRINTER("TimedOutInterests", m_timedOutInterests);
   }
 }
 
 void
 L3RateTracer::OutInterests(const Interest& interest, const Face& face)
 {
-  std::get<0>(m_stats[face.shared_from_this()]).m_outInterests++;
-  if (interest.hasWire()) {
-    std::get<1>(m_stats[face.shared_from_this()]).m_outInterests +=
-      interest.wireEncode().size();
-  }
+  FaceStats& stats = GetStats(face.getId());
+  std::get<0>(stats).m_outInterests++;
+  std::get<1>(stats).m_outInterests += interest.wireEncode().size();
 }
 
 void
 L3RateTracer::InInterests(const Interest& interest, const Face& face)
 {
-  std::get<0>(m_stats[face.shared_from_this()]).m_inInterests++;
-  if (interest.hasWire()) {
-    std::get<1>(m_stats[face.shared_from_this()]).m_inInterests +=
-      interest.wireEncode().size();
-  }
+  FaceStats& stats = GetStats(face.getId());
+  std::get<0>(stats).m_inInterests++;
+  std::get<1>(stats).m_inInterests += interest.wireEncode().size();
 }
 
 void
 L3RateTracer::OutData(const Data& data, const Face& face)
 {
-  std::get<0>(m_stats[face.shared_from_this()]).m_outData++;
-  if (data.hasWire()) {
-    std::get<1>(m_stats[face.shared_from_this()]).m_outData +=
-      data.wireEncode().size();
-  }
+  FaceStats& stats = GetStats(face.getId());
+  std::get<0>(stats).m_outData++;
+  std::get<1>(stats).m_outData += data.wireEncode().size();
 }
 
 void
 L3RateTracer::InData(const Data& data, const Face& face)
 {
-  std::get<0>(m_stats[face.shared_from_this()]).m_inData++;
-  if (data.hasWire()) {
-    std::get<1>(m_stats[face.shared_from_this()]).m_inData +=
-      data.wireEncode().size();
-  }
+  FaceStats& stats = GetStats(face.getId());
+  std::get<0>(stats).m_inData++;
+  std::get<1>(stats).m_inData += data.wireEncode().size();
 }
 
 void
 L3RateTracer::SatisfiedInterests(const nfd::pit::Entry& entry, const Face&, const Data&)
 {
-  std::get<0>(m_stats[nullptr]).m_satisfiedInterests++;
+  m_hasTotal = true;
+  std::get<0>(m_total).m_satisfiedInterests++;
   // no "size" stats
 
   for (const auto& in : entry.getInRecords()) {
-    std::get<0>(m_stats[in.getFace()]).m_satisfiedInterests ++;
+    std::get<0>(GetStats(in.getFace()->getId())).m_satisfiedInterests++;
   }
 
   for (const auto& out : entry.getOutRecords()) {
-    std::get<0>(m_stats[out.getFace()]).m_outSatisfiedInterests ++;
+    std::get<0>(GetStats(out.getFace()->getId())).m_outSatisfiedInterests++;
   }
 }
 
 void
 L3RateTracer::TimedOutInterests(const nfd::pit::Entry& entry)
 {
-  std::get<0>(m_stats[nullptr]).m_timedOutInterests++;
+  m_hasTotal = true;
+  std::get<0>(m_total).m_timedOutInterests++;
   // no "size" stats
 
   for (const auto& in : entry.getInRecords()) {
-    std::get<0>(m_stats[in.getFace()]).m_timedOutInterests++;
+    std::get<0>(GetStats(in.getFace()->getId())).m_timedOutInterests++;
   }
 
   for (const auto& out : entry.getOutRecords()) {
-    std::get<0>(m_stats[out.getFace()]).m_outTimedOutInterests++;
+    std::get<0>(GetStats(out.getFace()->getId())).m_outTimedOutInterests++;
   }
 }
 
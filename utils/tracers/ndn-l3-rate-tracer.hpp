@@ -25,12 +25,12 @@
 #include "ndn-l3-tracer.hpp"
 
 #include "ns3/nstime.h"
-#include "ns3/event-id.h"
 #include "ns3/node-container.h"
 
 #include <tuple>
-#include <map>
+#include <vector>
 #include <list>
+#include <map>
 
 namespace ns3 {
 namespace ndn {
@@ -145,22 +145,51 @@ protected:
   virtual void
   TimedOutInterests(const nfd::pit::Entry&);
 
+  virtual void
+  FaceAdded(const Face& face);
+
 private:
   void
   SetAveragingPeriod(const Time& period);
 
   void
-  PeriodicPrinter();
+  PeriodicPrinter(std::ostream& os);
 
   void
   Reset();
 
+  typedef std::tuple<Stats, Stats, Stats, Stats> FaceStats;
+
+  struct FaceSlot;
+
+  /**
+   * @brief Get the slot of the face ID
+   *
+   * Face IDs of non-reserved faces are assigned by NFD sequentially, so their slots are kept in
+   * a dense vector indexed by the face ID relative to the first non-reserved ID.  The few
+   * reserved faces (e.g., the content store face) are kept in a separate map.
+   */
+  FaceSlot&
+  GetSlot(nfd::FaceId faceId);
+
+  FaceStats&
+  GetStats(nfd::FaceId faceId);
+
 private:
   shared_ptr<std::ostream> m_os;
   Time m_period;
-  EventId m_printEvent;
-
-  mutable std::map<shared_ptr<const Face>, std::tuple<Stats, Stats, Stats, Stats>> m_stats;
+  uint64_t m_samplingHandle; ///< @brief registration with SamplingClock
+
+  struct FaceSlot {
+    shared_ptr<const Face> m_face; ///< @brief nullptr, if face hasn't been seen yet
+    bool m_active;                 ///< @brief true after the first traced packet
+    FaceStats m_stats;
+  };
+
+  mutable std::vector<FaceSlot> m_faces;
+  mutable std::map<nfd::FaceId, FaceSlot> m_reservedFaces;
+  mutable FaceStats m_total; ///< @brief node-wide satisfied/timed out Interests
+  bool m_hasTotal;
 };
 
 } // namespace ndn
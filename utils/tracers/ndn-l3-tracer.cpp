@@ -27,6 +27,7 @@
 #include <boost/lexical_cast.hpp>
 
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
 
 namespace ns3 {
 namespace ndn {
@@ -68,6 +69,23 @@ L3Tracer::Connect()
 
   l3->TraceConnectWithoutContext("TimedOutInterests",
                                  MakeCallback(&L3Tracer::TimedOutInterests, this));
+
+  l3->TraceConnectWithoutContext("FaceAdded", MakeCallback(&L3Tracer::FaceAdded, this));
+}
+
+void
+L3Tracer::EnumerateFaces()
+{
+  Ptr<L3Protocol> l3 = m_nodePtr->GetObject<L3Protocol>();
+
+  for (const auto& face : l3->getForwarder()->getFaceTable()) {
+    FaceAdded(*face);
+  }
+}
+
+void
+L3Tracer::FaceAdded(const Face&)
+{
 }
 
 } // namespace ndn
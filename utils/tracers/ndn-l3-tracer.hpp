@@ -82,6 +82,15 @@ protected:
   void
   Connect();
 
+  /**
+   * @brief Call FaceAdded for all faces that already exist on the node
+   *
+   * Should be called from the constructor of the derived class, as FaceAdded cannot be
+   * dispatched to the derived class from the L3Tracer constructor
+   */
+  void
+  EnumerateFaces();
+
   virtual void
   OutInterests(const Interest&, const Face&) = 0;
 
@@ -100,6 +109,12 @@ protected:
   virtual void
   TimedOutInterests(const nfd::pit::Entry&) = 0;
 
+  /**
+   * @brief Called for every new face added to the NDN stack (see also EnumerateFaces)
+   */
+  virtual void
+  FaceAdded(const Face&);
+
 protected:
   std::string m_node;
   Ptr<Node> m_nodePtr;
@@ -0,0 +1,141 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "ndn-quantile-sketch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ns3 {
+namespace ndn {
+
+QuantileSketch::QuantileSketch(uint32_t precision /* = 5*/)
+  : m_precision(precision)
+{
+  Reset();
+}
+
+void
+QuantileSketch::Reset()
+{
+  m_counts.clear();
+  m_count = 0;
+  m_sum = 0;
+  m_min = std::numeric_limits<uint64_t>::max();
+  m_max = 0;
+}
+
+size_t
+QuantileSketch::GetIndex(uint64_t value) const
+{
+  uint64_t subBuckets = uint64_t(1) << m_precision;
+  if (value < 2 * subBuckets) {
+    return value;
+  }
+
+  uint32_t msb = 63;
+  while ((value >> msb) == 0) {
+    msb--;
+  }
+
+  // value = top << shift, where top is in [subBuckets, 2*subBuckets)
+  uint32_t shift = msb - m_precision;
+  uint64_t top = value >> shift;
+  return 2 * subBuckets + (shift - 1) * subBuckets + (top - subBuckets);
+}
+
+uint64_t
+QuantileSketch::GetRepresentative(size_t index) const
+{
+  uint64_t subBuckets = uint64_t(1) << m_precision;
+  if (index < 2 * subBuckets) {
+    return index;
+  }
+
+  uint32_t shift = (index - 2 * subBuckets) / subBuckets + 1;
+  uint64_t top = (index - 2 * subBuckets) % subBuckets + subBuckets;
+
+  // middle of the bucket
+  return (top << shift) + ((uint64_t(1) << shift) >> 1);
+}
+
+void
+QuantileSketch::Add(uint64_t value)
+{
+  size_t index = GetIndex(value);
+  if (index >= m_counts.size()) {
+    m_counts.resize(index + 1, 0);
+  }
+  m_counts[index]++;
+
+  m_count++;
+  m_sum += value;
+  m_min = std::min(m_min, value);
+  m_max = std::max(m_max, value);
+}
+
+void
+QuantileSketch::Merge(const QuantileSketch& other)
+{
+  if (other.m_counts.size() > m_counts.size()) {
+    m_counts.resize(other.m_counts.size(), 0);
+  }
+  for (size_t i = 0; i < other.m_counts.size(); i++) {
+    m_counts[i] += other.m_counts[i];
+  }
+
+  m_count += other.m_count;
+  m_sum += other.m_sum;
+  m_min = std::min(m_min, other.m_min);
+  m_max = std::max(m_max, other.m_max);
+}
+
+uint64_t
+QuantileSketch::GetQuantile(double q) const
+{
+  if (m_count == 0) {
+    return 0;
+  }
+
+  q = std::min(std::max(q, 0.0), 1.0);
+  uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * m_count)));
+
+  // exact extremes are known
+  if (rank == 1) {
+    return m_min;
+  }
+  if (rank >= m_count) {
+    return m_max;
+  }
+
+  uint64_t seen = 0;
+  for (size_t i = 0; i < m_counts.size(); i++) {
+    seen += m_counts[i];
+    if (seen >= rank) {
+      return std::min(std::max(GetRepresentative(i), m_min), m_max);
+    }
+  }
+  return m_max;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,107 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef NDN_QUANTILE_SKETCH_H
+#define NDN_QUANTILE_SKETCH_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Streaming quantile sketch over non-negative integer samples (HDR-style histogram)
+ *
+ * Values below 2^(precision+1) are counted exactly.  Larger values are counted in log-linear
+ * buckets, each octave split into 2^precision buckets, so any reported quantile is within a
+ * relative error of 2^-precision of the true sample.  Memory depends only on the magnitude of
+ * the largest sample (at most a few thousand counters), not on the number of samples.
+ */
+class QuantileSketch {
+public:
+  explicit QuantileSketch(uint32_t precision = 5);
+
+  void
+  Add(uint64_t value);
+
+  /**
+   * @brief Add all samples of another sketch with the same precision
+   */
+  void
+  Merge(const QuantileSketch& other);
+
+  void
+  Reset();
+
+  uint64_t
+  GetCount() const
+  {
+    return m_count;
+  }
+
+  uint64_t
+  GetMin() const
+  {
+    return m_count > 0 ? m_min : 0;
+  }
+
+  uint64_t
+  GetMax() const
+  {
+    return m_max;
+  }
+
+  double
+  GetMean() const
+  {
+    return m_count > 0 ? static_cast<double>(m_sum) / m_count : 0;
+  }
+
+  /**
+   * @brief Get value of the q-quantile (0 <= q <= 1), 0 if sketch is empty
+   */
+  uint64_t
+  GetQuantile(double q) const;
+
+private:
+  size_t
+  GetIndex(uint64_t value) const;
+
+  uint64_t
+  GetRepresentative(size_t index) const;
+
+private:
+  uint32_t m_precision;
+  std::vector<uint64_t> m_counts;
+
+  uint64_t m_count;
+  uint64_t m_sum;
+  uint64_t m_min;
+  uint64_t m_max;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_QUANTILE_SKETCH_H
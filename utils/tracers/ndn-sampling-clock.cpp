@@ -0,0 +1,125 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "ndn-sampling-clock.hpp"
+
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+
+#include <map>
+#include <sstream>
+#include <vector>
+
+NS_LOG_COMPONENT_DEFINE("ndn.SamplingClock");
+
+namespace ns3 {
+namespace ndn {
+
+namespace {
+
+struct Entry {
+  shared_ptr<std::ostream> os;
+  SamplingClock::Sampler sampler;
+};
+
+typedef std::pair<Time /* period */, Time /* phase */> ScheduleKey;
+
+struct Schedule {
+  EventId event;
+  std::map<uint64_t, Entry> entries; ///< @brief ordered by registration
+};
+
+std::map<ScheduleKey, Schedule> g_schedules;
+std::map<uint64_t, ScheduleKey> g_handles;
+uint64_t g_lastHandle = 0;
+
+} // namespace
+
+uint64_t
+SamplingClock::Register(const Time& period, shared_ptr<std::ostream> os, const Sampler& sampler)
+{
+  NS_ASSERT_MSG(period.IsStrictlyPositive(), "Averaging period has to be positive");
+
+  ScheduleKey key(period, TimeStep(Simulator::Now().GetTimeStep() % period.GetTimeStep()));
+  Schedule& schedule = g_schedules[key];
+
+  if (schedule.entries.empty()) {
+    schedule.event = Simulator::Schedule(period, &SamplingClock::Tick, key.first, key.second);
+  }
+
+  uint64_t handle = ++g_lastHandle;
+  schedule.entries[handle] = Entry{os, sampler};
+  g_handles[handle] = key;
+
+  return handle;
+}
+
+void
+SamplingClock::Unregister(uint64_t handle)
+{
+  auto key = g_handles.find(handle);
+  if (key == g_handles.end())
+    return;
+
+  auto schedule = g_schedules.find(key->second);
+  g_handles.erase(key);
+  if (schedule == g_schedules.end())
+    return;
+
+  schedule->second.entries.erase(handle);
+  if (schedule->second.entries.empty()) {
+    schedule->second.event.Cancel();
+    g_schedules.erase(schedule);
+  }
+}
+
+void
+SamplingClock::Tick(Time period, Time phase)
+{
+  auto schedule = g_schedules.find(ScheduleKey(period, phase));
+  if (schedule == g_schedules.end())
+    return;
+
+  NS_LOG_DEBUG("Sampling " << schedule->second.entries.size() << " tracers");
+
+  // one buffer per output stream, in order of first use
+  std::vector<std::pair<shared_ptr<std::ostream>, shared_ptr<std::ostringstream>>> buffers;
+  std::map<std::ostream*, size_t> bufferIndex;
+
+  for (auto& entry : schedule->second.entries) {
+    auto index = bufferIndex.find(entry.second.os.get());
+    if (index == bufferIndex.end()) {
+      index = bufferIndex.insert(std::make_pair(entry.second.os.get(), buffers.size())).first;
+      buffers.push_back(std::make_pair(entry.second.os, make_shared<std::ostringstream>()));
+    }
+
+    entry.second.sampler(*buffers[index->second].second);
+  }
+
+  for (auto& buffer : buffers) {
+    *buffer.first << buffer.second->str();
+  }
+
+  schedule->second.event = Simulator::Schedule(period, &SamplingClock::Tick, period, phase);
+}
+
+} // namespace ndn
+} // namespace ns3
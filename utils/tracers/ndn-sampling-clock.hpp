@@ -0,0 +1,74 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015 Christian Kreuzberger and Daniel Posch, Alpen-Adria-University
+ * Klagenfurt
+ *
+ * This file is part of amus-ndnSIM, based on ndnSIM. See AUTHORS for complete list of
+ * authors and contributors.
+ *
+ * amus-ndnSIM and ndnSIM are free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * amus-ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * amus-ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef NDN_SAMPLING_CLOCK_H
+#define NDN_SAMPLING_CLOCK_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/nstime.h"
+
+#include <functional>
+#include <iostream>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Central clock for periodic tracers (L3RateTracer, CsTracer, L2RateTracer)
+ *
+ * Instead of one printer event per tracer, the clock schedules one event per averaging period
+ * (and phase, i.e., tracers registered at a time that is not a multiple of the period keep
+ * their own sampling instants).  On every tick, all samplers registered for the period are
+ * called in registration order, rows are collected in an in-memory buffer per output stream,
+ * and each buffer is written to its stream at once.  The resulting output is identical to
+ * per-tracer printing.
+ */
+class SamplingClock {
+public:
+  /**
+   * @brief Sampler writes rows for the current sampling instant and resets its counters
+   */
+  typedef std::function<void(std::ostream&)> Sampler;
+
+  /**
+   * @brief Register sampler that should be called every @p period, starting now + @p period
+   * @returns handle to be used with Unregister
+   */
+  static uint64_t
+  Register(const Time& period, shared_ptr<std::ostream> os, const Sampler& sampler);
+
+  /**
+   * @brief Remove sampler (it is safe to call it with an unknown or 0 handle)
+   */
+  static void
+  Unregister(uint64_t handle);
+
+private:
+  static void
+  Tick(Time period, Time phase);
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_SAMPLING_CLOCK_H
@@ -57,7 +57,8 @@ struct FunctorHook {
   {
     return boost::intrusive::get_parent_from_member<value_type>(
       static_cast<BaseHook*>(
-        boost::intrusive::get_parent_from_member<wrap<hook_type>>(n, &wrap<hook_type>::value_)),
+        boost::intrusive::get_parent_from_member<wrap<hook_type, N>>(n,
+                                                                     &wrap<hook_type, N>::value_)),
       &value_type::policy_hook_);
   }
   static const_pointer
@@ -65,7 +66,8 @@ struct FunctorHook {
   {
     return boost::intrusive::get_parent_from_member<value_type>(
       static_cast<const BaseHook*>(
-        boost::intrusive::get_parent_from_member<wrap<hook_type>>(n, &wrap<hook_type>::value_)),
+        boost::intrusive::get_parent_from_member<wrap<hook_type, N>>(n,
+                                                                     &wrap<hook_type, N>::value_)),
       &value_type::policy_hook_);
   }
 };
@@ -22,8 +22,9 @@
 
 /// @cond include_hidden
 
-#include <boost/mpl/inherit_linearly.hpp>
-#include <boost/mpl/at.hpp>
+#include "multi-type-container.hpp"
+
+#include <cstddef>
 
 namespace ns3 {
 namespace ndn {
@@ -39,128 +40,147 @@ struct policy_wrap {
   Value value_;
 };
 
-template<class Base, class Super /*empy_wrap/previous level*/,
-         class Value /*policy_wrap< element in vector >*/>
-struct inherit_with_base : Super, Value {
-  inherit_with_base(Base& base)
-    : Super(base)
-    , Value(base)
+/**
+ * @brief Chain of policies, resolved at compile time
+ *
+ * Every operation except set_max_size is applied to the tail of the chain first and then to the
+ * head (i.e., policies are visited from the last to the first one).  All calls are non-virtual and inline, so the
+ * whole chain compiles down to a straight sequence of calls to the individual policies.
+ */
+template<class Base, class... Policies>
+struct policy_chain {
+  policy_chain(Base& base)
   {
   }
 
   void
   update(typename Base::iterator item)
   {
-    Value::value_.update(item);
-    Super::update(item);
   }
 
   bool
   insert(typename Base::iterator item)
   {
-    bool ok = Value::value_.insert(item);
-    if (!ok)
-      return false;
-
-    ok = Super::insert(item);
-    if (!ok) {
-      Value::value_.erase(item);
-      return false;
-    }
     return true;
   }
 
   void
   lookup(typename Base::iterator item)
   {
-    Value::value_.lookup(item);
-    Super::lookup(item);
   }
 
   void
   erase(typename Base::iterator item)
   {
-    Value::value_.erase(item);
-    Super::erase(item);
   }
 
   void
   clear()
   {
-    Value::value_.clear();
-    Super::clear();
+  }
+
+  void
+  set_max_size(size_t max_size)
+  {
   }
 };
 
-template<class Base>
-struct empty_policy_wrap {
-  empty_policy_wrap(Base& base)
+template<class Base, class Head, class... Tail>
+struct policy_chain<Base, Head, Tail...> : policy_chain<Base, Tail...>, policy_wrap<Base, Head> {
+  typedef policy_chain<Base, Tail...> tail;
+  typedef policy_wrap<Base, Head> head;
+
+  policy_chain(Base& base)
+    : tail(base)
+    , head(base)
   {
   }
 
   void
   update(typename Base::iterator item)
   {
+    tail::update(item);
+    head::value_.update(item);
   }
+
   bool
   insert(typename Base::iterator item)
   {
+    bool ok = tail::insert(item);
+    if (!ok)
+      return false;
+
+    ok = head::value_.insert(item);
+    if (!ok) {
+      tail::erase(item);
+      return false;
+    }
     return true;
   }
+
   void
   lookup(typename Base::iterator item)
   {
+    tail::lookup(item);
+    head::value_.lookup(item);
   }
+
   void
   erase(typename Base::iterator item)
   {
+    tail::erase(item);
+    head::value_.erase(item);
   }
+
   void
   clear()
   {
+    tail::clear();
+    head::value_.clear();
+  }
+
+  // unlike the other operations, from the first policy to the last one
+  void
+  set_max_size(size_t max_size)
+  {
+    head::value_.set_max_size(max_size);
+    tail::set_max_size(max_size);
   }
 };
 
-template<class Base, class Vector>
-struct multi_policy_container
-  : public boost::mpl::
-      fold<Vector, empty_policy_wrap<Base>,
-           inherit_with_base<Base, boost::mpl::_1 /*empty/previous*/,
-                             policy_wrap<Base, boost::mpl::_2> /*element in vector*/>>::type {
-  typedef typename boost::mpl::
-    fold<Vector, empty_policy_wrap<Base>,
-         inherit_with_base<Base, boost::mpl::_1 /*empty/previous*/,
-                           policy_wrap<Base, boost::mpl::_2> /*element in vector*/>>::type super;
+template<class Base, class... Policies>
+struct multi_policy_container : public policy_chain<Base, Policies...> {
+  typedef policy_chain<Base, Policies...> super;
 
-  typedef typename boost::mpl::at_c<Vector, 0>::type::iterator iterator;
-  typedef typename boost::mpl::at_c<Vector, 0>::type::const_iterator const_iterator;
+  typedef typename nth_type<0, Policies...>::type::iterator iterator;
+  typedef typename nth_type<0, Policies...>::type::const_iterator const_iterator;
 
   iterator
   begin()
   {
-    return this->get<0>().begin();
+    return this->template get<0>().begin();
   }
   const_iterator
   begin() const
   {
-    return this->get<0>().begin();
+    return this->template get<0>().begin();
   }
 
   iterator
   end()
   {
-    return this->get<0>().end();
+    return this->template get<0>().end();
   }
   const_iterator
   end() const
   {
-    return this->get<0>().end();
+    return this->template get<0>().end();
   }
 
   size_t
   size() const
   {
-    return this->get<0>().size();
+    return this->template get<0>().size();
   }
 
   multi_policy_container(Base& base)
@@ -170,7 +190,7 @@ struct multi_policy_container
 
   template<int N>
   struct index {
-    typedef typename boost::mpl::at_c<Vector, N>::type type;
+    typedef typename nth_type<N, Policies...>::type type;
   };
 
   template<class T>
@@ -188,19 +208,17 @@ struct multi_policy_container
   }
 
   template<int N>
-  typename boost::mpl::at_c<Vector, N>::type&
+  typename index<N>::type&
   get()
   {
-    typedef typename boost::mpl::at_c<Vector, N>::type T;
-    return static_cast<policy_wrap<Base, T>&>(*this).value_;
+    return get<typename index<N>::type>();
   }
 
   template<int N>
-  const typename boost::mpl::at_c<Vector, N>::type&
+  const typename index<N>::type&
   get() const
   {
-    typedef typename boost::mpl::at_c<Vector, N>::type T;
-    return static_cast<const policy_wrap<Base, T>&>(*this).value_;
+    return get<typename index<N>::type>();
   }
 };
 
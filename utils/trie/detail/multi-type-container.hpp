@@ -22,57 +22,63 @@
 
 /// @cond include_hidden
 
-#include <boost/mpl/inherit_linearly.hpp>
-#include <boost/mpl/inherit.hpp>
-#include <boost/mpl/at.hpp>
-
 namespace ns3 {
 namespace ndn {
 namespace ndnSIM {
 namespace detail {
 
-template<class T>
+/**
+ * @brief N-th type of the parameter pack
+ */
+template<int N, class... Types>
+struct nth_type;
+
+template<class Head, class... Tail>
+struct nth_type<0, Head, Tail...> {
+  typedef Head type;
+};
+
+template<int N, class Head, class... Tail>
+struct nth_type<N, Head, Tail...> {
+  typedef typename nth_type<N - 1, Tail...>::type type;
+};
+
+/**
+ * @brief Storage for one value of the container (index makes bases unique even if types repeat)
+ */
+template<class T, int N>
 struct wrap {
   T value_;
 };
 
-template<class Vector>
-struct multi_type_container
-  : public boost::mpl::inherit_linearly<Vector, boost::mpl::inherit<wrap<boost::mpl::_2>,
-                                                                    boost::mpl::_1>>::type {
+template<int N, class... Types>
+struct multi_type_container_base {
+};
+
+template<int N, class Head, class... Tail>
+struct multi_type_container_base<N, Head, Tail...> : wrap<Head, N>,
+                                                     multi_type_container_base<N + 1, Tail...> {
+};
+
+template<class... Types>
+struct multi_type_container : multi_type_container_base<0, Types...> {
   template<int N>
   struct index {
-    typedef typename boost::mpl::at_c<Vector, N>::type type;
+    typedef typename nth_type<N, Types...>::type type;
   };
 
-  template<class T>
-  T&
-  get()
-  {
-    return static_cast<wrap<T>&>(*this).value_;
-  }
-
-  template<class T>
-  const T&
-  get() const
-  {
-    return static_cast<const wrap<T>&>(*this).value_;
-  }
-
   template<int N>
-  typename boost::mpl::at_c<Vector, N>::type&
+  typename index<N>::type&
   get()
   {
-    typedef typename boost::mpl::at_c<Vector, N>::type T;
-    return static_cast<wrap<T>&>(*this).value_;
+    return static_cast<wrap<typename index<N>::type, N>&>(*this).value_;
   }
 
   template<int N>
-  const typename boost::mpl::at_c<Vector, N>::type&
+  const typename index<N>::type&
   get() const
   {
-    typedef typename boost::mpl::at_c<Vector, N>::type T;
-    return static_cast<const wrap<T>&>(*this).value_;
+    return static_cast<const wrap<typename index<N>::type, N>&>(*this).value_;
   }
 };
 
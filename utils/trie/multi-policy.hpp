@@ -26,32 +26,35 @@
 #include "detail/multi-policy-container.hpp"
 #include "detail/functor-hook.hpp"
 
-#include <boost/mpl/size.hpp>
-#include <boost/mpl/at.hpp>
-#include <boost/mpl/range_c.hpp>
-#include <boost/mpl/transform.hpp>
-#include <boost/mpl/back_inserter.hpp>
-#include <boost/mpl/vector.hpp>
-#include <boost/mpl/for_each.hpp>
-
 #include <boost/intrusive/options.hpp>
 
+#include <string>
+
 namespace ns3 {
 namespace ndn {
 namespace ndnSIM {
 
-template<typename Policies> // e.g., mpl::vector1< lru_policy_traits >
-struct multi_policy_traits {
-  typedef Policies policy_traits;
+namespace detail {
 
-  struct getHook {
-    template<class Item>
-    struct apply {
-      typedef typename Item::policy_hook_type type;
-    };
-  };
-  typedef detail::multi_type_container<
-    typename boost::mpl::transform1<policy_traits, getHook>::type> policy_hook_type;
+template<int... Indices>
+struct index_list {
+};
+
+template<int N, int... Indices>
+struct make_index_list : make_index_list<N - 1, N - 1, Indices...> {
+};
+
+template<int... Indices>
+struct make_index_list<0, Indices...> {
+  typedef index_list<Indices...> type;
+};
+
+} // detail
+
+// e.g., multi_policy_traits<lru_policy_traits, aggregate_stats_policy_traits>
+template<typename... Policies>
+struct multi_policy_traits {
+  typedef detail::multi_type_container<typename Policies::policy_hook_type...> policy_hook_type;
 
   template<class Container>
   struct container_hook {
@@ -60,25 +63,21 @@ struct multi_policy_traits {
 
   template<class Base, class Container, class Hook>
   struct policy {
-    typedef boost::mpl::range_c<int, 0, boost::mpl::size<policy_traits>::type::value>
-      policies_range;
-
-    struct getPolicy {
-      template<class Number>
-      struct apply {
-        typedef typename boost::mpl::at_c<policy_traits, Number::value>::type::
-          template policy<Base, Container,
-                          boost::intrusive::function_hook<detail::FunctorHook<Hook, Container,
-                                                                              Number::value>>>::type
-            type;
-      };
+    template<class IndexList>
+    struct make_container;
+
+    template<int... Indices>
+    struct make_container<detail::index_list<Indices...>> {
+      typedef detail::multi_policy_container<Base,
+                                             typename Policies::template policy<
+                                               Base, Container,
+                                               boost::intrusive::function_hook<
+                                                 detail::FunctorHook<Hook, Container, Indices>>>::
+                                               type...> type;
     };
 
-    typedef typename boost::mpl::transform1<policies_range, getPolicy,
-                                            boost::mpl::back_inserter<boost::mpl::vector0<>>>::type
-      policies;
-
-    typedef detail::multi_policy_container<Base, policies> policy_container;
+    typedef typename make_container<
+      typename detail::make_index_list<sizeof...(Policies)>::type>::type policy_container;
 
     class type : public policy_container {
     public:
@@ -120,31 +119,10 @@ struct multi_policy_traits {
         policy_container::clear();
       }
 
-      struct max_size_setter {
-        max_size_setter(policy_container& container, size_t size)
-          : m_container(container)
-          , m_size(size)
-        {
-        }
-
-        template<typename U>
-        void
-        operator()(U index)
-        {
-          m_container.template get<U::value>().set_max_size(m_size);
-        }
-
-      private:
-        policy_container& m_container;
-        size_t m_size;
-      };
-
       inline void
       set_max_size(size_t max_size)
       {
-        boost::mpl::for_each<boost::mpl::range_c<int, 0,
-                                                 boost::mpl::size<policy_traits>::type::value>>(
-          max_size_setter(*this, max_size));
+        policy_container::set_max_size(max_size);
       }
 
       inline size_t
@@ -156,32 +134,14 @@ struct multi_policy_traits {
     };
   };
 
-  struct name_getter {
-    name_getter(std::string& name)
-      : m_name(name)
-    {
-    }
-
-    template<typename U>
-    void
-    operator()(U index)
-    {
-      if (!m_name.empty())
-        m_name += "::";
-      m_name += boost::mpl::at_c<policy_traits, U::value>::type::GetName();
-    }
-
-    std::string& m_name;
-  };
-
   /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
   static std::string
   GetName()
   {
     // combine names of all internal policies
     std::string name;
-    boost::mpl::for_each<boost::mpl::range_c<int, 0, boost::mpl::size<policy_traits>::type::value>>(
-      name_getter(name));
+    int expand[] = {0, (name += (name.empty() ? "" : "::") + Policies::GetName(), 0)...};
+    (void)expand;
 
     return name;
   }